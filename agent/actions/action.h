@@ -20,6 +20,8 @@ namespace agent {
 
 namespace action {
 
+class ActionPool;
+
 // This defines the types of actions that an agent/human can take.
 enum ActionType {
   CROP_ADD = 0,
@@ -34,9 +36,14 @@ enum ActionType {
 // The simulator will then execute this action on the scheduled time.
 class Action {
  public:
+  virtual ~Action() {}
+
   // execute an action on a specified terrain
   virtual void Execute(environment::Terrain *terrain) const = 0;
 
+  // Returns a copy of this action constructed in `pool`.
+  virtual Action *Clone(ActionPool *pool) const = 0;
+
   // accessors
   const std::vector<environment::Coordinate> &applied_range() const {
     return applied_range_;
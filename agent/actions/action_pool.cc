@@ -0,0 +1,47 @@
+#include "action_pool.h"
+
+#include <functional>
+
+#include "environment/coordinate.h"
+
+namespace agent {
+
+namespace action {
+
+void ActionPool::Delete(const Action *action) {
+  action->~Action();
+  free_slots_.push_back(
+      const_cast<void *>(static_cast<const void *>(action)));
+}
+
+bool ActionPool::Owns(const Action *action) const {
+  const void *p = action;
+  const std::less<const void *> less;
+  for (const Block &block : blocks_) {
+    if (!less(p, block.slots.get()) &&
+        less(p, block.slots.get() + block.size)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void *ActionPool::AcquireSlot() {
+  if (free_slots_.empty()) {
+    const size_t size =
+        blocks_.empty() ? kFirstBlockSize : 2 * blocks_.back().size;
+    blocks_.push_back({std::make_unique<Slot[]>(size), size});
+    // hand out the slots of the new block from its start
+    for (size_t i = size; i > 0; --i) {
+      free_slots_.push_back(&blocks_.back().slots[i - 1]);
+    }
+    num_slots_ += size;
+  }
+  void *slot = free_slots_.back();
+  free_slots_.pop_back();
+  return slot;
+}
+
+}  // namespace action
+
+}  // namespace agent
@@ -0,0 +1,76 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_ACTIONS_ACTION_POOL_H_
+#define COMPUTATIONAL_AGROECOLOGY_AGENT_ACTIONS_ACTION_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "agent/actions/action.h"
+
+namespace agent {
+
+namespace action {
+
+// Storage for actions which are created and thrown away at a high rate, e.g.
+// by agents during rollouts. Every action is constructed in a fixed-size slot
+// of a few growing blocks, and the slot of a deleted action is reused by the
+// next one, so that a pool stops allocating once it has as many slots as
+// there are actions alive.
+class ActionPool {
+ public:
+  // size of a slot in bytes, large enough for every action
+  static constexpr size_t kSlotSize = 192;
+
+  ActionPool() : num_slots_(0) {}
+  // Frees the slots. The actions still alive have to be deleted first.
+  ~ActionPool() {}
+
+  ActionPool(const ActionPool &) = delete;
+  ActionPool &operator=(const ActionPool &) = delete;
+
+  // Constructs an action of type `T` from `args` in a free slot.
+  template <typename T, typename... Args>
+  T *New(Args &&... args) {
+    static_assert(std::is_base_of<Action, T>::value, "T is not an action");
+    static_assert(sizeof(T) <= kSlotSize, "T does not fit in a slot");
+    static_assert(alignof(T) <= alignof(Slot), "T is overaligned");
+    return new (AcquireSlot()) T(std::forward<Args>(args)...);
+  }
+
+  // Destroys `action`, which was created by this pool, and frees its slot.
+  void Delete(const Action *action);
+
+  // Returns whether `action` lives in a slot of this pool.
+  bool Owns(const Action *action) const;
+
+  // number of slots, free or not
+  size_t num_slots() const { return num_slots_; }
+  size_t num_free_slots() const { return free_slots_.size(); }
+
+ private:
+  struct Slot {
+    alignas(std::max_align_t) unsigned char bytes[kSlotSize];
+  };
+  struct Block {
+    std::unique_ptr<Slot[]> slots;
+    size_t size;
+  };
+
+  // number of slots of the first block, each block is twice the last one
+  static constexpr size_t kFirstBlockSize = 16;
+
+  void *AcquireSlot();
+
+  std::vector<Block> blocks_;
+  std::vector<void *> free_slots_;
+  size_t num_slots_;
+};
+
+}  // namespace action
+
+}  // namespace agent
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_ACTIONS_ACTION_POOL_H_
@@ -1,5 +1,6 @@
 #include "crop.h"
 
+#include "agent/actions/action_pool.h"
 #include "environment/terrain.h"
 #include "environment/meteorology.h"
 
@@ -10,27 +11,27 @@ namespace action {
 namespace crop {
 
 Add::Add(const environment::Coordinate &target, const int64_t &start_time_step,
-         const int64_t &duration, const std::string &crop_type_name)
+         const int64_t &duration, const environment::SpeciesId crop_type)
     : Action(CROP_ADD, target, start_time_step, duration),
-      crop_type_name_(crop_type_name) {}
+      crop_type_(crop_type) {}
 
 Add::Add(const std::vector<environment::Coordinate> &applied_range,
          const int64_t &start_time_step, const int64_t &duration,
-         const std::string &crop_type_name)
+         const environment::SpeciesId crop_type)
     : Action(CROP_ADD, applied_range, start_time_step, duration),
-      crop_type_name_(crop_type_name) {}
+      crop_type_(crop_type) {}
 
 Add::Add(const environment::Coordinate &target, const int64_t &start_time_step,
          const int64_t &duration, const agent::Resources &cost,
-         const std::string &crop_type_name)
+         const environment::SpeciesId crop_type)
     : Action(CROP_ADD, target, start_time_step, duration, cost),
-      crop_type_name_(crop_type_name) {}
+      crop_type_(crop_type) {}
 
 Add::Add(const std::vector<environment::Coordinate> &applied_range,
          const int64_t &start_time_step, const int64_t &duration,
-         const agent::Resources &cost, const std::string &crop_type_name)
+         const agent::Resources &cost, const environment::SpeciesId crop_type)
     : Action(CROP_ADD, applied_range, start_time_step, duration, cost),
-      crop_type_name_(crop_type_name) {}
+      crop_type_(crop_type) {}
 
 void Add::Execute(environment::Terrain *terrain) const {
   // Check if the input argument is valid
@@ -44,16 +45,23 @@ void Add::Execute(environment::Terrain *terrain) const {
   using environment::PlantBuilder;
   for (const auto &coordinate : applied_range_) {
     const auto &meteorology = terrain->meteorology();
-    terrain->plant_container_.AddPlant(crop_type_name_, coordinate, meteorology);
+    if (terrain->plant_container_.AddPlant(crop_type_, coordinate,
+                                           meteorology) != nullptr) {
+      terrain->MarkCellChanged(coordinate);
+    }
   }
 }
 
+Action *Add::Clone(ActionPool *pool) const {
+  return pool->New<Add>(*this);
+}
+
 bool Add::operator==(const Add &rhs) const {
   using agent::action::Action;
   const auto &action_lhs = reinterpret_cast<const Action &>(*this);
   const auto &action_rhs = reinterpret_cast<const Action &>(rhs);
 
-  return (action_lhs == action_rhs) && (crop_type_name_ == rhs.crop_type_name_);
+  return (action_lhs == action_rhs) && (crop_type_ == rhs.crop_type_);
 }
 
 Remove::Remove(const environment::Coordinate &target,
@@ -84,10 +92,16 @@ void Remove::Execute(environment::Terrain *terrain) const {
   std::cout << "Removing " << applied_range_.size() << " crop(s)." << std::endl;
 
   for (const auto &c : applied_range_) {
-    terrain->plant_container_.DelPlant(c);
+    if (terrain->plant_container_.DelPlant(c)) {
+      terrain->MarkCellChanged(c);
+    }
   }
 }
 
+Action *Remove::Clone(ActionPool *pool) const {
+  return pool->New<Remove>(*this);
+}
+
 Harvest::Harvest(const environment::Coordinate &target,
                  const int64_t &start_time_step, const int64_t &duration)
     : Action(CROP_HARVEST, target, start_time_step, duration) {}
@@ -123,11 +137,16 @@ void Harvest::Execute(environment::Terrain *terrain) const {
       int yield = plant->Harvest();
       terrain->yield_ += yield;
       terrain->plant_container_.DelPlant(c);
+      terrain->MarkCellChanged(c);
     }
   }
   std::cout << "Yield of terrain: " << terrain->yield() << "kg." << std::endl;
 }
 
+Action *Harvest::Clone(ActionPool *pool) const {
+  return pool->New<Harvest>(*this);
+}
+
 Water::Water(const environment::Coordinate &target,
              const int64_t &start_time_step, const int64_t &duration,
              const double &water_amount)
@@ -160,9 +179,14 @@ void Water::Execute(environment::Terrain *terrain) const {
 
   for (const auto &c : applied_range_) {
     terrain->soil_container_.GetSoil(c).AddWaterToSoil(water_amount_);
+    terrain->MarkCellChanged(c);
   }
 }
 
+Action *Water::Clone(ActionPool *pool) const {
+  return pool->New<Water>(*this);
+}
+
 bool Water::operator==(const Water &rhs) const {
   using agent::action::Action;
   const auto &action_lhs = reinterpret_cast<const Action &>(*this);
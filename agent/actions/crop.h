@@ -8,6 +8,7 @@
 
 #include "agent/actions/action.h"
 #include "environment/plant.h"
+#include "environment/species_id.h"
 
 namespace agent {
 
@@ -19,28 +20,30 @@ namespace crop {
 class Add : public Action {
  public:
   Add(const environment::Coordinate &target, const int64_t &start_time_step,
-      const int64_t &duration, const std::string &crop_type_name);
+      const int64_t &duration, const environment::SpeciesId crop_type);
 
   Add(const std::vector<environment::Coordinate> &applied_range,
       const int64_t &start_time_step, const int64_t &duration,
-      const std::string &crop_type_name);
+      const environment::SpeciesId crop_type);
 
   Add(const environment::Coordinate &target, const int64_t &start_time_step,
       const int64_t &duration, const agent::Resources &cost,
-      const std::string &crop_type_name);
+      const environment::SpeciesId crop_type);
 
   Add(const std::vector<environment::Coordinate> &applied_range,
       const int64_t &start_time_step, const int64_t &duration,
-      const agent::Resources &cost, const std::string &crop_type_name);
+      const agent::Resources &cost, const environment::SpeciesId crop_type);
 
   void Execute(environment::Terrain *terrain) const override;
+  Action *Clone(ActionPool *pool) const override;
 
-  const std::string &crop_type_name() const { return crop_type_name_; }
+  environment::SpeciesId crop_type() const { return crop_type_; }
+  const std::string &crop_type_name() const { return crop_type_.name(); }
 
   bool operator==(const Add &rhs) const;
 
  private:
-  const std::string crop_type_name_;
+  const environment::SpeciesId crop_type_;
 };
 
 // Remove a crop
@@ -60,6 +63,7 @@ class Remove : public Action {
          const agent::Resources &cost);
 
   void Execute(environment::Terrain *terrain) const override;
+  Action *Clone(ActionPool *pool) const override;
 };
 
 // Harvest a crop
@@ -79,6 +83,7 @@ class Harvest : public Action {
           const agent::Resources &cost);
 
   void Execute(environment::Terrain *terrain) const override;
+  Action *Clone(ActionPool *pool) const override;
 };
 
 // Water a crop
@@ -100,6 +105,7 @@ class Water : public Action {
         const agent::Resources &cost, const double &water_amount);
 
   void Execute(environment::Terrain *terrain) const override;
+  Action *Clone(ActionPool *pool) const override;
 
   bool operator==(const Water &rhs) const;
 
@@ -15,28 +15,23 @@ void Agent::AddResource(const agent::ResourceType &resource, size_t quantity) {
   owned_resources_[resource] += quantity;
 }
 
-int Agent::RandomInt(int min, int max) {
-  // obtain a random number from hardware
-  std::random_device ramdom_number;
-  // seed the generator
-  std::mt19937 seed(ramdom_number());
-  std::uniform_int_distribution<> integer_distributor(min, max);
-  return integer_distributor(seed);
-}
-
 void Agent::ApplyRandomAction(int action_tyoe, int timestep) {
   // TODO: timestep maybe change to  explicit time units / types
+  const environment::SpeciesId bean(kBeanTypeName);
   for (int i = 0; i < timestep; i++) {
-    // TODO : Set starttime = 1 duration  = 0 and  crop_type_name =
+    // TODO : Set starttime = 1 duration  = 0 and  crop_type =
     // kBeanTypeName and choose actionTypoe(0) for now
     agent::ActionID action = {RandomInt(0, env_->terrain().size() - 1),
-                              RandomInt(0, (0, env_->terrain().size() - 1)),
+                              RandomInt(0, env_->terrain().size() - 1),
                               ::agent::action::ActionType(0),
                               1,
                               0,
-                              kBeanTypeName};
+                              bean};
 
-    TakeAction(CreateAction(action));
+    agent::action::Action *new_action = CreateAction(action);
+    if (TakeAction(new_action) != SUCCESS) {
+      env_->DeleteAction(new_action);
+    }
   }
 }
 
@@ -46,20 +41,20 @@ agent::action::Action *Agent::CreateAction(const ActionID &action) {
 
   switch (action.action_taken) {
     case ActionType::CROP_ADD:
-      return new agent::action::crop::Add(
+      return env_->NewAction<agent::action::crop::Add>(
           environment::Coordinate(action.row, action.col),
-          action.start_time_step, action.duration, action.crop_type_name);
+          action.start_time_step, action.duration, action.crop_type);
     case ActionType::CROP_REMOVE:
-      return new agent::action::crop::Remove(
+      return env_->NewAction<agent::action::crop::Remove>(
           environment::Coordinate(action.row, action.col),
           action.start_time_step, action.duration);
     case ActionType::CROP_HARVEST:
-      return new agent::action::crop::Harvest(
+      return env_->NewAction<agent::action::crop::Harvest>(
           environment::Coordinate(action.row, action.col),
           action.start_time_step, action.duration);
     case ActionType::WATER_CROP:
       // TODO: Change the water amont in the future, set it to 1 for now
-      return new agent::action::crop::Water(
+      return env_->NewAction<agent::action::crop::Water>(
           environment::Coordinate(action.row, action.col),
           action.start_time_step, action.duration, 1);
   }
@@ -111,21 +106,19 @@ std::vector<std::string> Agent::GetQualifiedPlants() {
 }
 
 bool Agent::CheckEnoughResources(const Resources &resources) const {
-  bool ret = true;
-  for (const auto &resource : resources) {
-    const auto &find_result = owned_resources_.find(resource.first);
-    if (resource.second > 0 && find_result == owned_resources_.end()) {
+  for (size_t i = 0; i < resources.size(); ++i) {
+    const ResourceType type = Resources::key(i);
+    if (owned_resources_[type] < resources[type]) {
       return false;
     }
-    ret &= (find_result->second >= resource.second);
   }
-
-  return ret;
+  return true;
 }
 
 void Agent::DeductResources(const Resources &cost) {
-  for (const auto &resource : cost) {
-    owned_resources_[resource.first] -= resource.second;
+  for (size_t i = 0; i < cost.size(); ++i) {
+    const ResourceType type = Resources::key(i);
+    owned_resources_[type] -= cost[type];
   }
 }
 
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "agent/actions/crop.h"
+#include "agent/random.h"
 #include "agent/resource.h"
 #include "environment/environment.h"
 
@@ -23,7 +24,7 @@ struct ActionID {
   // TODO : Set starttime = 1 duration  = 0 for now
   int start_time_step = 1;
   int duration = 0;
-  const std::string crop_type_name;
+  environment::SpeciesId crop_type;
 };
 
 class Agent {
@@ -35,10 +36,14 @@ class Agent {
   ReturnCodes TakeAction(const agent::action::Action *action);
 
   // generate action
+  // The action is owned by the environment, see `Environment::NewAction()`.
   agent::action::Action *CreateAction(const ActionID &action_id);
 
-  // generate random integer
-  int RandomInt(int min, int max);
+  // generate random integer in [min, max]
+  int RandomInt(int min, int max) { return random_.UniformInt(min, max); }
+  // restart the random numbers of this agent from `seed`, to reproduce a run
+  void Seed(uint64_t seed) { random_.Seed(seed); }
+  inline Random *mutable_random() { return &random_; }
 
   // Applied random action to the encironment
   // TODO: creeate random plant
@@ -70,6 +75,10 @@ class Agent {
   // The resources this agent has
   Resources owned_resources_;
 
+  // The random numbers of this agent, seeded from std::random_device unless
+  // Seed() is called
+  Random random_;
+
   // Check whether this agent's resources is more than the specified resources
   bool CheckEnoughResources(const Resources &resources) const;
 
@@ -0,0 +1,113 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_EXPERIENCE_BUFFER_H_
+#define COMPUTATIONAL_AGROECOLOGY_AGENT_EXPERIENCE_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace agent {
+
+// A bounded queue which any number of threads can push to and pop from
+// without locks, used to pass the transitions of rollout workers to the
+// learner. Every cell carries a sequence number telling whether it is ready to
+// be written or read in the current lap of the ring, so producers and
+// consumers only contend on their own position counter.
+template <typename T>
+class ExperienceBuffer {
+ public:
+  // The capacity is rounded up to a power of two.
+  explicit ExperienceBuffer(const size_t capacity)
+      : capacity_(RoundUp(capacity)),
+        mask_(capacity_ - 1),
+        cells_(new Cell[capacity_]),
+        enqueue_pos_(0),
+        dequeue_pos_(0) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ExperienceBuffer(const ExperienceBuffer &) = delete;
+  ExperienceBuffer &operator=(const ExperienceBuffer &) = delete;
+
+  size_t capacity() const { return capacity_; }
+
+  // Returns false without waiting if the buffer is full.
+  bool Push(const T &item) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell.item = item;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false without waiting if the buffer is empty.
+  bool Pop(T *item) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t diff = intptr_t(sequence) - intptr_t(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          *item = cell.item;
+          cell.sequence.store(pos + capacity_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Pops up to `max_count` items into `items` and returns how many.
+  size_t PopBatch(T *items, const size_t max_count) {
+    size_t count = 0;
+    while (count < max_count && Pop(items + count)) {
+      ++count;
+    }
+    return count;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T item;
+  };
+
+  static size_t RoundUp(const size_t capacity) {
+    size_t n = 2;
+    while (n < capacity) {
+      n <<= 1;
+    }
+    return n;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  // the producers and the consumers each write their own cache line
+  alignas(64) std::atomic<size_t> enqueue_pos_;
+  alignas(64) std::atomic<size_t> dequeue_pos_;
+};
+
+}  // namespace agent
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_EXPERIENCE_BUFFER_H_
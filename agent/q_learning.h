@@ -2,25 +2,32 @@
 #define COMPUTATIONAL_AGROECOLOGY_AGENT_Q_LEARNING_H_
 
 #include "agent/agent.h"
-
-#include <algorithm>
+#include "agent/q_table.h"
 
 namespace agent {
 
 class Qlearning : public Agent {
  public:
+  using Transition = DenseQTable<float>::Transition;
+
+  // The initial Q-values are drawn from the random numbers of `seed`, so that
+  // agents built with the same seed start from the same table.
   Qlearning(const std::string &name, environment::Environment *env, int row_,
-            int column_);
+            int column_, uint64_t seed = Random::SeedFromDevice());
 
   ~Qlearning();
 
   // update q_table value
-  void UpdateQtable(int current_state, int reward, int next_state,
+  void UpdateQtable(int current_state, float reward, int next_state,
                     int action_taken);
+  // update q_table value with `count` transitions, in order
+  void UpdateQtable(const Transition *transitions, size_t count);
   // select max Q value in a state
-  int MaxQ(int state);
+  float MaxQ(int state) const;
   // return max q action index
-  int MaxQAction(int state);
+  int MaxQAction(int state) const;
+
+  inline const DenseQTable<float> &qtable() const { return qtable_; }
 
   //  TODO:  add function from action index to action object
   agent::action::Action *interpreter(int action_taken_);
@@ -30,11 +37,12 @@ class Qlearning : public Agent {
  private:
   int row_;
   int column_;
-  int *qtable_;
-  const static int kLearningRate = 0.1;
-  const static int kDiscount = 0.95;
+  // row_ states by column_ actions
+  DenseQTable<float> qtable_;
+  static constexpr float kLearningRate = 0.1f;
+  static constexpr float kDiscount = 0.95f;
 };
 
 }  // namespace agent
 
-#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_AGENT_H_
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_Q_LEARNING_H_
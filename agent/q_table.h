@@ -0,0 +1,228 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_Q_TABLE_H_
+#define COMPUTATIONAL_AGROECOLOGY_AGENT_Q_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace agent {
+
+// The Q-values of all actions in a state are kept contiguous, as a row, so
+// that the maximum over the actions of a state is a scan over one array.
+// A table is templated on its value type and on how the rows are stored:
+// DenseQStorage keeps all of them in one array, and SparseQStorage only keeps
+// the states which were written, for state spaces too large to allocate.
+
+// All rows in one aligned array. Rows are padded to a multiple of the
+// alignment, so that every row starts aligned.
+template <typename T>
+class DenseQStorage {
+ public:
+  // alignment of the rows in bytes, one cache line
+  static constexpr size_t kAlignment = 64;
+
+  DenseQStorage(const size_t num_states, const size_t num_actions,
+                const T initial)
+      : num_states_(num_states),
+        num_actions_(num_actions),
+        stride_(RoundUp(num_actions)),
+        values_(Allocate(num_states, stride_)) {
+    std::fill(values_.get(), values_.get() + num_states_ * stride_, initial);
+  }
+
+  size_t num_states() const { return num_states_; }
+  size_t num_actions() const { return num_actions_; }
+
+  const T *Row(const size_t state) const {
+    return values_.get() + state * stride_;
+  }
+  T *MutableRow(const size_t state) { return values_.get() + state * stride_; }
+
+ private:
+  struct Free {
+    void operator()(T *p) const { std::free(p); }
+  };
+
+  static size_t RoundUp(const size_t num_actions) {
+    const size_t per_line = std::max<size_t>(1, kAlignment / sizeof(T));
+    return (num_actions + per_line - 1) / per_line * per_line;
+  }
+  // Throws std::bad_alloc if the rows do not fit in memory.
+  static T *Allocate(const size_t num_states, const size_t stride) {
+    if (stride != 0 &&
+        num_states > (std::numeric_limits<size_t>::max() - kAlignment) /
+                         sizeof(T) / stride) {
+      throw std::bad_alloc();
+    }
+    // aligned_alloc needs a size which is a multiple of the alignment
+    const size_t size = num_states * stride * sizeof(T);
+    const size_t bytes = std::max(
+        kAlignment, (size + kAlignment - 1) / kAlignment * kAlignment);
+    T *values = static_cast<T *>(std::aligned_alloc(kAlignment, bytes));
+    if (values == nullptr) {
+      throw std::bad_alloc();
+    }
+    return values;
+  }
+
+  size_t num_states_;
+  size_t num_actions_;
+  size_t stride_;  // number of values from one row to the next
+  std::unique_ptr<T[], Free> values_;
+};
+
+// Only the rows which were written, in a hash map. Rows which were never
+// written read as the initial value.
+template <typename T>
+class SparseQStorage {
+ public:
+  SparseQStorage(const size_t num_states, const size_t num_actions,
+                 const T initial)
+      : num_states_(num_states),
+        num_actions_(num_actions),
+        initial_(num_actions, initial) {}
+
+  size_t num_states() const { return num_states_; }
+  size_t num_actions() const { return num_actions_; }
+  // number of rows which are stored
+  size_t num_stored() const { return rows_.size(); }
+
+  const T *Row(const size_t state) const {
+    auto it = rows_.find(state);
+    return it == rows_.end() ? initial_.data() : it->second.data();
+  }
+  T *MutableRow(const size_t state) {
+    auto it = rows_.find(state);
+    if (it == rows_.end()) {
+      it = rows_.emplace(state, initial_).first;
+    }
+    return it->second.data();
+  }
+
+ private:
+  size_t num_states_;
+  size_t num_actions_;
+  std::vector<T> initial_;  // the row of states which were never written
+  std::unordered_map<uint64_t, std::vector<T>> rows_;
+};
+
+template <typename T, typename Storage = DenseQStorage<T>>
+class QTable {
+ public:
+  // One step of experience, as used by the bulk update.
+  struct Transition {
+    size_t state;
+    size_t action;
+    T reward;
+    size_t next_state;
+  };
+
+  // Throws std::invalid_argument if `num_actions` is 0, as a state without
+  // actions has no best Q-value.
+  QTable(const size_t num_states, const size_t num_actions,
+         const T initial = T(0))
+      : storage_(num_states, RequireActions(num_actions), initial) {}
+
+  size_t num_states() const { return storage_.num_states(); }
+  size_t num_actions() const { return storage_.num_actions(); }
+  const Storage &storage() const { return storage_; }
+
+  T Get(const size_t state, const size_t action) const {
+    return storage_.Row(state)[action];
+  }
+  void Set(const size_t state, const size_t action, const T value) {
+    storage_.MutableRow(state)[action] = value;
+  }
+  // the Q-values of all actions in `state`
+  const T *Row(const size_t state) const { return storage_.Row(state); }
+  T *MutableRow(const size_t state) { return storage_.MutableRow(state); }
+
+  // Returns the largest Q-value in `state`.
+  T MaxQ(const size_t state) const {
+    return RowMax(storage_.Row(state), num_actions());
+  }
+
+  // Returns the action with the largest Q-value in `state`, the first one if
+  // there are several.
+  size_t MaxQAction(const size_t state) const {
+    const T *row = storage_.Row(state);
+    const T max = RowMax(row, num_actions());
+    return std::find(row, row + num_actions(), max) - row;
+  }
+
+  // Moves the Q-value of taking `action` in `state` towards the reward plus
+  // the discounted best Q-value of `next_state`.
+  void Update(const size_t state, const size_t action, const T reward,
+              const size_t next_state, const T learning_rate,
+              const T discount) {
+    const T max_q_future = MaxQ(next_state);
+    T &q = storage_.MutableRow(state)[action];
+    q = (1 - learning_rate) * q +
+        learning_rate * (reward + discount * max_q_future);
+  }
+
+  // Applies `count` transitions in order, as if each was passed to Update.
+  void UpdateBatch(const Transition *transitions, const size_t count,
+                   const T learning_rate, const T discount) {
+    for (size_t i = 0; i < count; ++i) {
+      const Transition &t = transitions[i];
+      Update(t.state, t.action, t.reward, t.next_state, learning_rate,
+             discount);
+    }
+  }
+  void UpdateBatch(const std::vector<Transition> &transitions,
+                   const T learning_rate, const T discount) {
+    UpdateBatch(transitions.data(), transitions.size(), learning_rate,
+                discount);
+  }
+
+ private:
+  // number of independent maxima, so that the loop below is vectorized
+  static constexpr size_t kLanes = 8;
+
+  static size_t RequireActions(const size_t num_actions) {
+    if (num_actions == 0) {
+      throw std::invalid_argument("a Q-table needs at least one action");
+    }
+    return num_actions;
+  }
+
+  static T RowMax(const T *row, const size_t n) {
+    if (n < kLanes) {
+      return *std::max_element(row, row + n);
+    }
+    T lanes[kLanes];
+    std::copy(row, row + kLanes, lanes);
+    size_t i = kLanes;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (size_t j = 0; j < kLanes; ++j) {
+        lanes[j] = std::max(lanes[j], row[i + j]);
+      }
+    }
+    T max = *std::max_element(lanes, lanes + kLanes);
+    for (; i < n; ++i) {
+      max = std::max(max, row[i]);
+    }
+    return max;
+  }
+
+  Storage storage_;
+};
+
+// a table of every state of small state spaces
+template <typename T>
+using DenseQTable = QTable<T, DenseQStorage<T>>;
+// a table of only the visited states of huge state spaces
+template <typename T>
+using SparseQTable = QTable<T, SparseQStorage<T>>;
+
+}  // namespace agent
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_Q_TABLE_H_
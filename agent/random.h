@@ -0,0 +1,88 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_RANDOM_H_
+#define COMPUTATIONAL_AGROECOLOGY_AGENT_RANDOM_H_
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace agent {
+
+// A small and fast pseudo random number generator (xoshiro256**), seeded
+// once and then reused for every number an agent draws. The same seed gives
+// the same sequence, so runs can be reproduced. It is a
+// UniformRandomBitGenerator, so it can be used with the <random>
+// distributions and algorithms as well.
+class Random {
+ public:
+  using result_type = uint64_t;
+
+  // Seeds the generator from std::random_device.
+  Random() { Seed(SeedFromDevice()); }
+  explicit Random(const uint64_t seed) { Seed(seed); }
+
+  // Restarts the sequence of `seed`.
+  void Seed(uint64_t seed) {
+    // expand the seed with splitmix64, which never gives an all-zero state
+    for (uint64_t &s : state_) {
+      seed += 0x9e3779b97f4a7c15;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    const uint64_t result = Rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = Rotl(state_[3], 45);
+    return result;
+  }
+
+  // Returns an integer uniformly distributed in [min, max].
+  int UniformInt(const int min, const int max) {
+    const uint64_t range = uint64_t(int64_t(max) - int64_t(min)) + 1;
+    // Lemire's multiply and reject, which avoids a division in most cases
+    uint64_t x = (*this)() >> 32;
+    uint64_t m = x * range;
+    uint64_t low = m & 0xffffffff;
+    if (low < range) {
+      const uint64_t threshold = (uint64_t(1) << 32) % range;
+      while (low < threshold) {
+        x = (*this)() >> 32;
+        m = x * range;
+        low = m & 0xffffffff;
+      }
+    }
+    return int(int64_t(min) + int64_t(m >> 32));
+  }
+
+  // Returns a number uniformly distributed in [0, 1).
+  double UniformReal() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+  static uint64_t SeedFromDevice() {
+    std::random_device device;
+    return (uint64_t(device()) << 32) ^ device();
+  }
+
+ private:
+  static uint64_t Rotl(const uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t state_[4];
+};
+
+}  // namespace agent
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_RANDOM_H_
@@ -1,14 +1,18 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_RESOURCE_H_
 #define COMPUTATIONAL_AGROECOLOGY_AGENT_RESOURCE_H_
 
-#include <unordered_map>
+#include <cstddef>
+
+#include "environment/utility.h"
 
 namespace agent {
 
 // This defines the types of resources that an agent/human has.
-enum class ResourceType { MONEY = 0, LABOR };
+enum class ResourceType { MONEY = 0, LABOR, NUM_RESOURCES };
 
-using Resources = std::unordered_map<ResourceType, size_t>;
+// The amount of each type of resources, 0 unless set.
+using Resources =
+    EnumArray<ResourceType, size_t, size_t(ResourceType::NUM_RESOURCES)>;
 
 }  // namespace agent
 
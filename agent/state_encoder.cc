@@ -0,0 +1,71 @@
+#include "state_encoder.h"
+
+#include <cmath>
+#include <ctime>
+#include <vector>
+
+namespace agent {
+
+StateEncoder::StateEncoder(const size_t terrain_size)
+    : terrain_size_(terrain_size),
+      num_cells_(terrain_size * terrain_size),
+      encoded_(false),
+      num_changes_(0) {}
+
+void StateEncoder::Encode(const environment::Environment &env,
+                          float *features) {
+  const environment::Terrain &terrain = env.terrain();
+  for (size_t cell = 0; cell < num_cells_; ++cell) {
+    EncodeCell(terrain, cell, features);
+  }
+  EncodeGlobals(env, features);
+  encoded_ = true;
+  num_changes_ = terrain.num_changes();
+}
+
+void StateEncoder::Update(const environment::Environment &env,
+                          float *features) {
+  const environment::Terrain &terrain = env.terrain();
+  changed_cells_.clear();
+  if (!encoded_ || !terrain.ChangedCellsSince(num_changes_, &changed_cells_)) {
+    Encode(env, features);
+    return;
+  }
+
+  for (const size_t cell : changed_cells_) {
+    EncodeCell(terrain, cell, features);
+  }
+  EncodeGlobals(env, features);
+  num_changes_ = terrain.num_changes();
+}
+
+void StateEncoder::EncodeCell(const environment::Terrain &terrain,
+                              const size_t cell, float *features) const {
+  const environment::Coordinate coordinate(cell / terrain_size_,
+                                           cell % terrain_size_);
+
+  features[moisture_offset() + cell] =
+      terrain.soil_container()[coordinate].root_zone_water_content();
+
+  const environment::Plant *plant =
+      terrain.plant_container().GetPlant(coordinate);
+  features[maturity_offset() + cell] =
+      plant == nullptr ? 0.0f
+                       : float(plant->maturity() + 1) /
+                             (environment::Plant::OLD + 1);
+}
+
+void StateEncoder::EncodeGlobals(const environment::Environment &env,
+                                 float *features) const {
+  features[yield_offset()] = env.terrain().yield();
+
+  // localtime() is not safe to call from rollouts in parallel
+  const time_t tt = std::chrono::system_clock::to_time_t(env.timestamp());
+  struct tm tm;
+  localtime_r(&tt, &tm);
+  const double angle = 2.0 * M_PI * tm.tm_yday / 365.0;
+  features[time_of_year_offset()] = std::sin(angle);
+  features[time_of_year_offset() + 1] = std::cos(angle);
+}
+
+}  // namespace agent
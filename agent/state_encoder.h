@@ -0,0 +1,64 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_STATE_ENCODER_H_
+#define COMPUTATIONAL_AGROECOLOGY_AGENT_STATE_ENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "environment/environment.h"
+
+namespace agent {
+
+// Encodes the observable state of an environment as a fixed number of floats,
+// written into a buffer owned by the caller:
+//
+//   [ moisture grid | maturity grid | yield | sin(day) | cos(day) ]
+//
+// Both grids have one value per terrain cell, numbered as in
+// `Terrain::CellIndex`. The moisture is the water content of the root zone of
+// the soil. The maturity is 0 for a cell without a plant and grows from 1/5 for
+// a seed to 1 for an old plant. The time of year is an angle, so that the end
+// and the start of a year are close to each other.
+//
+// After a first `Encode`, `Update` only rewrites the cells which changed
+// since, so that an agent step costs as much as the cells it changed.
+class StateEncoder {
+ public:
+  // Encodes environments whose terrain is `terrain_size` cells wide.
+  explicit StateEncoder(const size_t terrain_size);
+
+  // the number of floats written
+  size_t size() const { return 2 * num_cells_ + kNumGlobals; }
+  size_t num_cells() const { return num_cells_; }
+  // where each of the features starts in the buffer
+  size_t moisture_offset() const { return 0; }
+  size_t maturity_offset() const { return num_cells_; }
+  size_t yield_offset() const { return 2 * num_cells_; }
+  size_t time_of_year_offset() const { return 2 * num_cells_ + 1; }
+
+  // Writes all `size()` features of `env` into `features`.
+  void Encode(const environment::Environment &env, float *features);
+  // Brings `features`, the buffer last written by this encoder for `env`, up
+  // to date with `env`. Falls back to `Encode` if it has to.
+  void Update(const environment::Environment &env, float *features);
+
+ private:
+  // yield and time of year
+  static constexpr size_t kNumGlobals = 3;
+
+  void EncodeCell(const environment::Terrain &terrain, const size_t cell,
+                  float *features) const;
+  void EncodeGlobals(const environment::Environment &env,
+                     float *features) const;
+
+  size_t terrain_size_;
+  size_t num_cells_;
+  bool encoded_;
+  // `Terrain::num_changes` when the buffer was last written
+  uint64_t num_changes_;
+  std::vector<size_t> changed_cells_;
+};
+
+}  // namespace agent
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_STATE_ENCODER_H_
@@ -0,0 +1,115 @@
+#include "trainer.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "agent/random.h"
+
+namespace agent {
+
+Trainer::Trainer(Qlearning *agent, const StateFunction &state,
+                 const ActionFunction &action, const ScoreFunction &score)
+    : agent_(agent),
+      state_(state),
+      action_(action),
+      score_(score),
+      buffer_(nullptr),
+      next_episode_(0) {}
+
+size_t Trainer::Train(const TrainerOptions &options) {
+  ExperienceBuffer<Qlearning::Transition> buffer(options.buffer_capacity);
+  buffer_ = &buffer;
+  next_episode_ = 0;
+
+  int num_workers = options.num_workers;
+  if (num_workers <= 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_workers = std::min(num_workers, options.num_episodes);
+
+  std::atomic<int> running(num_workers);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < num_workers; ++i) {
+    workers.emplace_back([this, &options, &running]() {
+      RunWorker(options);
+      running.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // learn from the transitions until the workers are done and the buffer is
+  // drained
+  std::vector<Qlearning::Transition> batch(std::max<size_t>(1, options.batch_size));
+  size_t learned = 0;
+  for (;;) {
+    const bool done = running.load(std::memory_order_acquire) == 0;
+    const size_t count = buffer.PopBatch(batch.data(), batch.size());
+    if (count > 0) {
+      std::unique_lock<std::shared_mutex> lock(qtable_mutex_);
+      agent_->UpdateQtable(batch.data(), count);
+      learned += count;
+    } else if (done) {
+      break;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  buffer_ = nullptr;
+  return learned;
+}
+
+void Trainer::RunWorker(const TrainerOptions &options) {
+  for (int episode = next_episode_++; episode < options.num_episodes;
+       episode = next_episode_++) {
+    RunEpisode(options, episode);
+  }
+}
+
+void Trainer::RunEpisode(const TrainerOptions &options, const int episode) {
+  Random random(options.seed + episode);
+  std::unique_ptr<environment::Environment> env =
+      agent_->environment()->Fork();
+  // the actions taken in this rollout, which the fork refers to
+  std::vector<std::unique_ptr<const action::Action>> actions;
+  const int num_actions = agent_->qtable().num_actions();
+
+  size_t state = state_(*env);
+  float score = score_(*env);
+  for (int64_t t = 0; t < options.episode_length;
+       t += options.action_interval) {
+    size_t action_taken;
+    if (random.UniformReal() < options.epsilon) {
+      action_taken = random.UniformInt(0, num_actions - 1);
+    } else {
+      std::shared_lock<std::shared_mutex> lock(qtable_mutex_);
+      action_taken = agent_->MaxQAction(state);
+    }
+
+    const action::Action *action = action_(action_taken, *env);
+    if (action != nullptr) {
+      actions.emplace_back(action);
+      env->ReceiveAction(action);
+    }
+    env->JumpForwardTimeStep(options.action_interval);
+
+    const size_t next_state = state_(*env);
+    const float next_score = score_(*env);
+    const Qlearning::Transition transition = {state, action_taken,
+                                              next_score - score, next_state};
+    while (!buffer_->Push(transition)) {
+      // wait for the learner to catch up
+      std::this_thread::yield();
+    }
+    state = next_state;
+    score = next_score;
+  }
+  // the fork goes before the actions it refers to
+  env.reset();
+}
+
+}  // namespace agent
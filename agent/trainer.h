@@ -0,0 +1,80 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_AGENT_TRAINER_H_
+#define COMPUTATIONAL_AGROECOLOGY_AGENT_TRAINER_H_
+
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+
+#include "agent/actions/action.h"
+#include "agent/experience_buffer.h"
+#include "agent/q_learning.h"
+#include "environment/environment.h"
+
+namespace agent {
+
+struct TrainerOptions {
+  // number of rollout threads, one per core if 0
+  int num_workers = 0;
+  // number of rollouts, each in its own fork of the agent's environment
+  int num_episodes = 1;
+  // number of time steps simulated in a rollout
+  int64_t episode_length = 1;
+  // number of time steps between two actions, i.e. of one transition
+  int64_t action_interval = 1;
+  // probability of taking a random action instead of the best one
+  float epsilon = 0.1f;
+  // the learner applies transitions to the Q-table in batches of this size
+  size_t batch_size = 256;
+  // number of transitions which may wait for the learner
+  size_t buffer_capacity = 1 << 16;
+  // the rollout of episode `i` draws its random numbers from `seed + i`
+  uint64_t seed = 0;
+};
+
+// Trains a Qlearning agent on rollouts run in parallel. Each worker thread
+// forks the agent's environment, lets the agent act in it with an
+// epsilon-greedy policy and pushes the transitions into a lock-free
+// experience buffer. The calling thread is the learner: it drains the buffer
+// and applies the transitions to the Q-table in batches, so that the workers
+// only wait for it once per batch.
+class Trainer {
+ public:
+  // Returns the Q-table row of the state of an environment.
+  using StateFunction =
+      std::function<size_t(const environment::Environment &env)>;
+  // Returns a new action for the Q-table column `action` in `env`, or nullptr
+  // to do nothing. The trainer owns the returned action.
+  using ActionFunction = std::function<const action::Action *(
+      size_t action, const environment::Environment &env)>;
+  // Returns the score of an environment. The reward of a transition is the
+  // change of the score.
+  using ScoreFunction =
+      std::function<float(const environment::Environment &env)>;
+
+  Trainer(Qlearning *agent, const StateFunction &state,
+          const ActionFunction &action, const ScoreFunction &score);
+
+  // Runs `options.num_episodes` rollouts and returns the number of
+  // transitions learned. The environment of the agent is not modified.
+  size_t Train(const TrainerOptions &options);
+
+ private:
+  // Runs rollouts until none are left.
+  void RunWorker(const TrainerOptions &options);
+  // Runs one rollout of `episode`.
+  void RunEpisode(const TrainerOptions &options, const int episode);
+
+  Qlearning *agent_;
+  StateFunction state_;
+  ActionFunction action_;
+  ScoreFunction score_;
+
+  // the workers read the Q-table while the learner updates it
+  std::shared_mutex qtable_mutex_;
+  ExperienceBuffer<Qlearning::Transition> *buffer_;
+  std::atomic<int> next_episode_;
+};
+
+}  // namespace agent
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_AGENT_TRAINER_H_
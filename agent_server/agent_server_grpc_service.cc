@@ -3,6 +3,7 @@
 #include <chrono>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpcpp/impl/codegen/status.h>
@@ -12,6 +13,8 @@
 #include <grpcpp/server_context.h>
 
 #include "config/config.h"
+#include "environment/plant_builder.h"
+#include "environment/species_id.h"
 #include "environment/terrain.h"
 #include "message_convertor.h"
 
@@ -209,6 +212,24 @@ namespace service {
   return ::grpc::Status::OK;
 }
 
+::grpc::Status AgentServerGrpcService::ListCropTypes(
+    ::grpc::ServerContext *context, const ListCropTypesRequest *request,
+    ListCropTypesResponse *response) {
+  if (context == nullptr || request == nullptr || response == nullptr) {
+    return ::grpc::Status(::grpc::FAILED_PRECONDITION,
+                          "`ServerContext`, `ListCropTypesRequest`, or "
+                          "`ListCropTypesResponse` is nullptr.");
+  }
+
+  std::vector<environment::SpeciesId> crop_types;
+  for (const auto &name : environment::PlantBuilder::GetPlantList()) {
+    crop_types.emplace_back(name);
+  }
+  *response = ToProtobuf(crop_types);
+
+  return ::grpc::Status::OK;
+}
+
 }  // namespace service
 
 }  // namespace agent_server
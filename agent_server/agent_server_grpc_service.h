@@ -37,6 +37,9 @@ class AgentServerGrpcService final : public AgentServer::Service {
   ::grpc::Status AgentRemoveCrop(::grpc::ServerContext *context,
                                  const AgentRemoveCropRequest *request,
                                  AgentRemoveCropResponse *response) override;
+  ::grpc::Status ListCropTypes(::grpc::ServerContext *context,
+                               const ListCropTypesRequest *request,
+                               ListCropTypesResponse *response) override;
 
  private:
   agent_server::AgentServer agent_server_;
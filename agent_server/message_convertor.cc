@@ -53,6 +53,7 @@ data_format::Plant ToProtobuf(const environment::Plant &plant) {
   data_format::Plant plant_protobuf;
 
   plant_protobuf.set_name(plant.name());
+  plant_protobuf.set_species_id(plant.species_id().value());
   plant_protobuf.set_trunk_size(plant.trunk_size());
   plant_protobuf.set_root_size(plant.root_size());
   plant_protobuf.set_health(plant.health());
@@ -81,32 +82,29 @@ data_format::Plant ToProtobuf(const environment::Plant &plant) {
   plant_protobuf.set_produce(plant.produce());
 
   plant_protobuf.mutable_params()->set_gdd_base_temperature(
-      plant.params().at(environment::PlantProperty::GDD_BASE_TEMPERATURE));
+      plant.param(environment::PlantProperty::GDD_BASE_TEMPERATURE));
   plant_protobuf.mutable_params()->set_min_absolute_temperature(
-      plant.params().at(environment::PlantProperty::MIN_ABSOLUTE_TEMPERATURE));
+      plant.param(environment::PlantProperty::MIN_ABSOLUTE_TEMPERATURE));
   plant_protobuf.mutable_params()->set_max_absolute_temperature(
-      plant.params().at(environment::PlantProperty::MAX_ABSOLUTE_TEMPERATURE));
+      plant.param(environment::PlantProperty::MAX_ABSOLUTE_TEMPERATURE));
   plant_protobuf.mutable_params()->set_min_new_growth_temperature(
-      plant.params().at(
-          environment::PlantProperty::MIN_NEW_GROWTH_TEMPERATURE));
+      plant.param(environment::PlantProperty::MIN_NEW_GROWTH_TEMPERATURE));
   plant_protobuf.mutable_params()->set_max_new_growth_temperature(
-      plant.params().at(
-          environment::PlantProperty::MAX_NEW_GROWTH_TEMPERATURE));
+      plant.param(environment::PlantProperty::MAX_NEW_GROWTH_TEMPERATURE));
   plant_protobuf.mutable_params()->set_min_photo_period(
-      plant.params().at(environment::PlantProperty::MIN_PHOTO_PERIOD));
+      plant.param(environment::PlantProperty::MIN_PHOTO_PERIOD));
   plant_protobuf.mutable_params()->set_max_photo_period(
-      plant.params().at(environment::PlantProperty::MAX_PHOTO_PERIOD));
+      plant.param(environment::PlantProperty::MAX_PHOTO_PERIOD));
   plant_protobuf.mutable_params()->set_max_harvest_yield(
-      plant.params().at(environment::PlantProperty::MAX_HARVEST_YIELD));
+      plant.param(environment::PlantProperty::MAX_HARVEST_YIELD));
   plant_protobuf.mutable_params()->set_gdd_units_after_full_bloom(
-      plant.params().at(
-          environment::PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM));
+      plant.param(environment::PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM));
 
   return plant_protobuf;
 }
 
 environment::Soil FromProtobuf(const data_format::Soil &protobuf_soil) {
-  environment::Soil::Texture soil_texture;
+  environment::Soil::Texture soil_texture = environment::Soil::CLAY;
   switch (protobuf_soil.texture()) {
     case data_format::Soil_Texture::Soil_Texture_CLAY:
       soil_texture = environment::Soil::CLAY;
@@ -119,11 +117,18 @@ environment::Soil FromProtobuf(const data_format::Soil &protobuf_soil) {
       break;
   }
 
+  // The layers must match the profile of the texture: the extra ones are
+  // dropped and the missing ones take the water of the deepest one given, or
+  // none at all.
+  const auto &layers = protobuf_soil.water_content().layers();
+  const size_t num_layers =
+      environment::Soil::Profile(soil_texture).num_layers();
+  std::vector<double> water_content(layers.begin(), layers.end());
+  water_content.resize(num_layers,
+                       water_content.empty() ? 0.0 : water_content.back());
   return environment::Soil(soil_texture, protobuf_soil.ph(),
                            protobuf_soil.salinity(),
-                           protobuf_soil.organic_matter(),
-                           protobuf_soil.water_content().water_amount_1(),
-                           protobuf_soil.water_content().water_amount_2());
+                           protobuf_soil.organic_matter(), water_content);
 }
 
 data_format::Soil ToProtobuf(const environment::Soil &soil) {
@@ -145,10 +150,9 @@ data_format::Soil ToProtobuf(const environment::Soil &soil) {
   soil_protobuf.set_ph(soil.pH());
   soil_protobuf.set_salinity(soil.salinity());
   soil_protobuf.set_organic_matter(soil.organic_matter());
-  soil_protobuf.mutable_water_content()->set_water_amount_1(
-      soil.water_content().water_amount_1);
-  soil_protobuf.mutable_water_content()->set_water_amount_2(
-      soil.water_content().water_amount_2);
+  for (const double water_content : soil.water_content()) {
+    soil_protobuf.mutable_water_content()->add_layers(water_content);
+  }
 
   return soil_protobuf;
 }
@@ -394,10 +398,13 @@ agent_server::service::AgentActionConfig ToProtobuf(
   agent_action_config.set_start_time_step(start_time_step);
   agent_action_config.set_end_time_step(start_time_step + duration);
 
-  for (const auto &c : cost) {
-    auto cost_ptr = agent_action_config.add_cost();
+  for (size_t i = 0; i < cost.size(); ++i) {
+    const agent::ResourceType resource_type = agent::Resources::key(i);
+    if (cost[resource_type] == 0) {
+      continue;
+    }
     ::agent_server::service::AgentActionConfig_Cost_ResourceType type;
-    switch (c.first) {
+    switch (resource_type) {
       case agent::ResourceType::MONEY:
         type =
             ::agent_server::service::AgentActionConfig_Cost_ResourceType_MONEY;
@@ -406,10 +413,13 @@ agent_server::service::AgentActionConfig ToProtobuf(
         type =
             ::agent_server::service::AgentActionConfig_Cost_ResourceType_LABOR;
         break;
+      default:
+        continue;
     }
 
+    auto cost_ptr = agent_action_config.add_cost();
     cost_ptr->set_resource_type(type);
-    cost_ptr->set_count(c.second);
+    cost_ptr->set_count(cost[resource_type]);
   }
 
   return agent_action_config;
@@ -425,8 +435,12 @@ agent::action::crop::Add FromProtobuf(
   FromProtobuf(add_crop_protobuf.action_config(), &applied_range,
                &start_time_step, &duration, &cost);
 
+  const environment::SpeciesId crop_type =
+      add_crop_protobuf.crop_type_id() != 0
+          ? environment::SpeciesId(add_crop_protobuf.crop_type_id())
+          : environment::SpeciesId(add_crop_protobuf.crop_type_name());
   return agent::action::crop::Add(applied_range, start_time_step, duration,
-                                  cost, add_crop_protobuf.crop_type_name());
+                                  cost, crop_type);
 }
 
 agent_server::service::AgentAddCropRequest ToProtobuf(
@@ -438,10 +452,24 @@ agent_server::service::AgentAddCropRequest ToProtobuf(
                  action.duration(), action.cost());
 
   agent_add_crop_request.set_crop_type_name(action.crop_type_name());
+  agent_add_crop_request.set_crop_type_id(action.crop_type().value());
 
   return agent_add_crop_request;
 }
 
+agent_server::service::ListCropTypesResponse ToProtobuf(
+    const std::vector<environment::SpeciesId> &crop_types) {
+  agent_server::service::ListCropTypesResponse list_crop_types_response;
+
+  for (const environment::SpeciesId crop_type : crop_types) {
+    auto crop_type_ptr = list_crop_types_response.add_crop_types();
+    crop_type_ptr->set_id(crop_type.value());
+    crop_type_ptr->set_name(crop_type.name());
+  }
+
+  return list_crop_types_response;
+}
+
 agent::action::crop::Remove FromProtobuf(
     const agent_server::service::AgentRemoveCropRequest &remove_crop_protobuf) {
   std::vector<environment::Coordinate> applied_range;
@@ -2,6 +2,7 @@
 #define COMPUTATIONAL_AGROECOLOGY_AGENT_SERVER_MESSAGE_CONVERTOR_H_
 
 #include <chrono>
+#include <vector>
 
 #include "agent/q_learning.h"
 #include "agent/resource.h"
@@ -12,6 +13,7 @@
 #include "environment/environment.h"
 #include "environment/plant.h"
 #include "environment/soil.h"
+#include "environment/species_id.h"
 #include "environment/terrain.h"
 #include "environment/weather.h"
 #include "proto/agent_server.pb.h"
@@ -78,4 +80,8 @@ agent::action::crop::Remove FromProtobuf(
 agent_server::service::AgentRemoveCropRequest ToProtobuf(
     const agent::action::crop::Remove &action);
 
+// crop type convertor
+agent_server::service::ListCropTypesResponse ToProtobuf(
+    const std::vector<environment::SpeciesId> &crop_types);
+
 #endif
\ No newline at end of file
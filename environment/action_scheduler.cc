@@ -0,0 +1,63 @@
+#include "action_scheduler.h"
+
+#include "environment/coordinate.h"
+
+namespace environment {
+
+namespace {
+
+// Pushes the actions of `from` into `to`, cloning those of `from_pool` into
+// `to_pool`.
+template <typename Queue>
+void CopyQueue(Queue from, const agent::action::ActionPool &from_pool,
+               agent::action::ActionPool *to_pool, Queue *to) {
+  while (!from.empty()) {
+    const agent::action::Action *action = from.top();
+    from.pop();
+    if (from_pool.Owns(action)) {
+      action = action->Clone(to_pool);
+    }
+    to->push(action);
+  }
+}
+
+}  // namespace
+
+ActionScheduler::ActionScheduler(const ActionScheduler &other) {
+  CopyQueue(other.action_pq_, other.pool_, &pool_, &action_pq_);
+  CopyQueue(other.starting_action_pq_, other.pool_, &pool_,
+            &starting_action_pq_);
+}
+
+ActionScheduler &ActionScheduler::operator=(const ActionScheduler &other) {
+  if (this != &other) {
+    Clear();
+    CopyQueue(other.action_pq_, other.pool_, &pool_, &action_pq_);
+    CopyQueue(other.starting_action_pq_, other.pool_, &pool_,
+              &starting_action_pq_);
+  }
+  return *this;
+}
+
+ActionScheduler::~ActionScheduler() { Clear(); }
+
+void ActionScheduler::DeleteAction(const agent::action::Action *action) {
+  if (action != nullptr && pool_.Owns(action)) {
+    pool_.Delete(action);
+  }
+}
+
+void ActionScheduler::Finish(const agent::action::Action *action) {
+  DeleteAction(action);
+}
+
+void ActionScheduler::Clear() {
+  for (; !action_pq_.empty(); action_pq_.pop()) {
+    DeleteAction(action_pq_.top());
+  }
+  for (; !starting_action_pq_.empty(); starting_action_pq_.pop()) {
+    DeleteAction(starting_action_pq_.top());
+  }
+}
+
+}  // namespace environment
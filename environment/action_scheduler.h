@@ -0,0 +1,72 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_ACTION_SCHEDULER_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_ACTION_SCHEDULER_H_
+
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "agent/actions/action.h"
+#include "agent/actions/action_pool.h"
+
+namespace environment {
+
+// The actions an environment has received, waiting to start or to take
+// effect. Actions either belong to whoever scheduled them, or are created by
+// `NewAction` in the pool of the scheduler, which deletes them once they took
+// effect and reuses their memory.
+class ActionScheduler {
+ public:
+  // the actions which have not started, earliest start first
+  using StartQueue =
+      std::priority_queue<const agent::action::Action *,
+                          std::vector<const agent::action::Action *>,
+                          agent::action::ActionStartTimeComparator>;
+  // the actions which have started, earliest end first
+  using EndQueue =
+      std::priority_queue<const agent::action::Action *,
+                          std::vector<const agent::action::Action *>,
+                          agent::action::ActionEndTimeComparator>;
+
+  ActionScheduler() {}
+  // Copies the scheduled actions. Those of the pool are cloned into the pool of
+  // the copy, the others are shared.
+  ActionScheduler(const ActionScheduler &other);
+  ActionScheduler &operator=(const ActionScheduler &other);
+  // Deletes the scheduled actions of the pool.
+  ~ActionScheduler();
+
+  // Creates an action of type `T` from `args` in the pool. It is deleted when
+  // it has taken effect, or by `DeleteAction` if it is never scheduled.
+  template <typename T, typename... Args>
+  T *NewAction(Args &&... args) {
+    return pool_.New<T>(std::forward<Args>(args)...);
+  }
+  // Deletes an action of the pool which was not scheduled.
+  void DeleteAction(const agent::action::Action *action);
+
+  void Schedule(const agent::action::Action *action) {
+    action_pq_.push(action);
+  }
+  // Called once `action` has been popped from `starting_action_pq()` and has
+  // taken effect.
+  void Finish(const agent::action::Action *action);
+
+  StartQueue &action_pq() { return action_pq_; }
+  const StartQueue &action_pq() const { return action_pq_; }
+  EndQueue &starting_action_pq() { return starting_action_pq_; }
+  const EndQueue &starting_action_pq() const { return starting_action_pq_; }
+  const agent::action::ActionPool &pool() const { return pool_; }
+
+ private:
+  // Deletes the actions of the pool in both queues and empties them.
+  void Clear();
+
+  // declared first, so that it outlives the queues
+  agent::action::ActionPool pool_;
+  StartQueue action_pq_;
+  EndQueue starting_action_pq_;
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_ACTION_SCHEDULER_H_
@@ -0,0 +1,46 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_BINARY_WEATHER_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_BINARY_WEATHER_H_
+
+#include <cstdint>
+
+namespace environment {
+
+// The layout of preprocessed binary weather series (`.weather`), which are
+// written by `tools/weather_converter` from the CSV records of a weather
+// station. A file is a `Header` followed by one column of floats per field of
+// `Weather`, each holding a value for every day of the series; missing values
+// are NaN. The columns are used in place after the file is mapped into
+// memory, in the in-memory layout of the machine which wrote them.
+namespace binaryweather {
+
+const char kMagic[8] = "AGROWTH";
+const uint32_t kVersion = 1;
+// every column starts at a multiple of this
+const uint64_t kAlignment = 16;
+const char kExtension[] = ".weather";
+
+enum Column : uint32_t {
+  TOTAL_SUNSHINE_HOUR = 0,  // hours
+  AIR_TEMP_MIN,             // degree Celsius
+  AIR_TEMP_MAX,             // degree Celsius
+  RELATIVE_HUMIDITY,        // percent
+  WIND_SPEED,               // m s^-1
+  RAINFALL,                 // mm
+  NUM_COLUMNS
+};
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_columns;  // NUM_COLUMNS
+  int64_t first_day;     // days since 1970-01-01 of the first value
+  uint64_t num_days;
+  // in bytes from the beginning of the file, by `Column`
+  uint64_t column_offsets[NUM_COLUMNS];
+};
+
+}  // namespace binaryweather
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_BINARY_WEATHER_H_
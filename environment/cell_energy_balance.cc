@@ -0,0 +1,77 @@
+#include "cell_energy_balance.h"
+
+#include <algorithm>
+
+#include "environment/plant_radiation.h"
+
+namespace environment {
+
+CellEnergyBalance::CellEnergyBalance(const double reference_height,
+                                     const EnergyBalanceParameters &params)
+    : reference_height_(reference_height), params_(params) {}
+
+void CellEnergyBalance::Clear() {
+  plant_height_.clear();
+  leaf_area_index_.clear();
+  soil_water_content_.clear();
+  latent_heat_flux_soil_.clear();
+  latent_heat_flux_crop_.clear();
+}
+
+size_t CellEnergyBalance::AddCell(const double plant_height,
+                                  const double leaf_area_index,
+                                  const double soil_water_content) {
+  // the canopy stays below the reference height
+  plant_height_.push_back(std::clamp(plant_height, kMinPlantHeight,
+                                     reference_height_ / 2.0));
+  leaf_area_index_.push_back(std::max(leaf_area_index, kMinLeafAreaIndex));
+  soil_water_content_.push_back(soil_water_content);
+  return plant_height_.size() - 1;
+}
+
+void CellEnergyBalance::Update(const Meteorology &meteorology) {
+  const size_t num_cells = size();
+  latent_heat_flux_soil_.resize(num_cells);
+  latent_heat_flux_crop_.resize(num_cells);
+
+  // the terms shared by all cells
+  const double wind_speed =
+      std::max(meteorology.wind_speed(), params_.min_wind_speed);
+  const double slope_of_saturated_vapor_pressure =
+      EnergyBalance::CalculateSlopeOfSaturatedVaporPressure(
+          meteorology.air_temperature());
+  const double vapor_pressure_deficit = meteorology.saturated_vapor_pressure() -
+                                        meteorology.actual_vapor_pressure();
+  const double extinction_coefficient_direct =
+      PlantRadiation::CalculateExtinctionCoefficientForDirect(
+          meteorology.solar_elevation());
+  const double net_radiation = meteorology.hourly_net_radiation();
+  const double total_irradiance = meteorology.hourly_total_irradiance();
+  const double solar_inclination = meteorology.solar_inclination();
+
+  for (size_t i = 0; i < num_cells; ++i) {
+    const EnergyBalance::InternalConstants internal_constants =
+        EnergyBalance::CalculateInternalConstants(wind_speed,
+                                                  plant_height_[i]);
+    const EnergyBalance::DailyResistances resistances = {
+        EnergyBalance::CalculateAeroResistances(
+            internal_constants, plant_height_[i], reference_height_, params_),
+        EnergyBalance::CalculateBoundaryLayerResistance(
+            internal_constants, plant_height_[i], leaf_area_index_[i],
+            kLeafWidth, params_),
+        EnergyBalance::CalculateSoilResistance(soil_water_content_[i],
+                                               params_)};
+    const EnergyBalance::HeatFluxes fluxes = EnergyBalance::CalculateHeatFluxes(
+        slope_of_saturated_vapor_pressure, vapor_pressure_deficit, resistances,
+        EnergyBalance::CalculateCanopyResistance(
+            total_irradiance, leaf_area_index_[i], params_),
+        EnergyBalance::CalculateEnergySupply(net_radiation,
+                                             extinction_coefficient_direct,
+                                             solar_inclination,
+                                             leaf_area_index_[i]));
+    latent_heat_flux_soil_[i] = fluxes.latent_soil;
+    latent_heat_flux_crop_[i] = fluxes.latent_crop;
+  }
+}
+
+}  // namespace environment
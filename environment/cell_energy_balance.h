@@ -0,0 +1,74 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_CELL_ENERGY_BALANCE_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_CELL_ENERGY_BALANCE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "environment/energy_balance.h"
+#include "environment/meteorology.h"
+
+namespace environment {
+
+// The energy balance of every occupied cell of a field at once, computing the
+// latent heat fluxes of the soil and of the crop of each cell. Unlike
+// `EnergyBalance`, which holds its own meteorology and soil for a single
+// plant, the cells share one meteorology: the terms which only depend on it
+// are computed once per update, and the canopy and soil of each cell are kept
+// as contiguous arrays, as are the fluxes, which the water balance of the soil
+// consumes in the same order.
+class CellEnergyBalance {
+ public:
+  // `reference_height` is the height (meters) at which the weather is
+  // measured.
+  explicit CellEnergyBalance(
+      const double reference_height = 2.0,
+      const EnergyBalanceParameters &params = EnergyBalanceParameters());
+
+  // Removes all cells, keeping the memory of the arrays.
+  void Clear();
+
+  // Adds a cell with a canopy of `plant_height` (meters) and
+  // `leaf_area_index`, on soil whose top layer holds `soil_water_content`
+  // (m^3 m^-3). Returns the index of the cell in the arrays.
+  size_t AddCell(const double plant_height, const double leaf_area_index,
+                 const double soil_water_content);
+
+  // Computes the fluxes of all cells at the hour of `meteorology`.
+  void Update(const Meteorology &meteorology);
+
+  size_t size() const { return plant_height_.size(); }
+
+  // The latent heat fluxes (W m^-2) of the soil and the crop, by cell.
+  const std::vector<double> &latent_heat_flux_soil() const {
+    return latent_heat_flux_soil_;
+  }
+  const std::vector<double> &latent_heat_flux_crop() const {
+    return latent_heat_flux_crop_;
+  }
+
+ private:
+  // Canopies lower than this (meters) are taken to be this high, as the
+  // aerodynamic resistances of bare soil are not defined.
+  static constexpr double kMinPlantHeight = 0.01;
+  // Leaf area indices smaller than this are taken to be this, as the canopy
+  // resistance of no leaves is infinite.
+  static constexpr double kMinLeafAreaIndex = 0.01;
+  // TODO: Take it from the species of the plants.
+  static constexpr double kLeafWidth = 0.05;
+
+  double reference_height_;
+  EnergyBalanceParameters params_;
+
+  // The inputs, by cell.
+  std::vector<double> plant_height_;
+  std::vector<double> leaf_area_index_;
+  std::vector<double> soil_water_content_;
+
+  // The results, by cell.
+  std::vector<double> latent_heat_flux_soil_;
+  std::vector<double> latent_heat_flux_crop_;
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_CELL_ENERGY_BALANCE_H_
@@ -1,5 +1,7 @@
 #include "energy_balance.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace environment {
@@ -10,70 +12,120 @@ EnergyBalance::EnergyBalance(const Meteorology &meteorology,
                              const double reference_height,
                              const double plant_height,
                              const double leaf_area_index,
-                             const double leaf_width, const Soil &soil)
+                             const double leaf_width, const Soil &soil,
+                             const EnergyBalanceParameters &params)
     : meteorology_(meteorology),
       plant_radiation_(plant_radiation),
       kReferenceHeight(reference_height),
       plant_height_(plant_height),
       leaf_area_index_(leaf_area_index),
       leaf_width_(leaf_width),
-      soil_(soil) {
+      soil_(soil),
+      params_(params) {
   Update(meteorology, plant_radiation, weather);
 }
 
 void EnergyBalance::Update(const Meteorology &meteorology,
                            const PlantRadiation &plant_radiation,
                            const Weather &weather) {
-  internal_constants_ = CalculateInternalConstants(meteorology.wind_speed());
-  UpdateDailyHeatFluxes(weather);
-  UpdateHourlyHeatFluxes(meteorology, plant_radiation);
+  const double wind_speed =
+      std::max(meteorology.wind_speed(), params_.min_wind_speed);
+  internal_constants_ = CalculateInternalConstants(wind_speed, plant_height_);
+  const DailyResistances resistances = CalculateDailyResistances();
+  UpdateDailyHeatFluxes(meteorology, weather, resistances);
+  UpdateHourlyHeatFluxes(meteorology, plant_radiation, resistances);
 }
 
 void EnergyBalance::UpdateSolarHour(const double solar_hour,
                                     const Weather &weather) {
   meteorology_.UpdateLocalSolarHour(solar_hour);
+  meteorology_.UpdateWeather(weather);
   meteorology_.UpdateHourlyNetRadiation(weather);
   plant_radiation_.UpdateSolarHour(meteorology_);
-  UpdateHourlyHeatFluxes(meteorology_, plant_radiation_);
 }
 
-void EnergyBalance::UpdateDailyHeatFluxes(const Weather &weather) {
-  // TODO: fill in this function
+void EnergyBalance::UpdateDailyHeatFluxes(
+    const Meteorology &meteorology, const Weather &weather,
+    const DailyResistances &resistances) {
+  // Cautious: we are using the private update function.
+  meteorology_.UpdateDayOfYear(int(meteorology.day_of_year_));
 
-  // Calling `UpdateSolarHour()` just to indicate the dependency on the
-  // `UpdateSolarHour()` function.
-  UpdateSolarHour(0, weather);
+  daily_heat_fluxes_ = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  if (meteorology_.day_length_ <= 0.0) {
+    return;
+  }
+
+  auto fluxes_at = [this, &weather, &resistances](const double solar_hour) {
+    UpdateSolarHour(solar_hour, weather);
+    const HeatFluxes fluxes =
+        CalculateHourlyHeatFluxes(meteorology_, plant_radiation_, resistances);
+    return std::array<double, 6>{
+        fluxes.total_latent,   fluxes.latent_soil,   fluxes.latent_crop,
+        fluxes.total_sensible, fluxes.sensible_soil, fluxes.sensible_crop};
+  };
+  // The integral over solar hours is in W m^-2 h.
+  const std::array<double, 6> daily = IntegrateGaussLegendre<6>(
+      fluxes_at, meteorology_.solar_hour_sunrise_,
+      meteorology_.solar_hour_sunset_, daily_quadrature_options_);
+  daily_heat_fluxes_ = {
+      daily[0] * kSecsPerHour, daily[1] * kSecsPerHour,
+      daily[2] * kSecsPerHour, daily[3] * kSecsPerHour,
+      daily[4] * kSecsPerHour, daily[5] * kSecsPerHour};
 }
 
 void EnergyBalance::UpdateHourlyHeatFluxes(
-    const Meteorology &meteorology, const PlantRadiation &plant_radiation) {
-  // This is denoted as Δ in the book.
-  double slope_of_saturated_vapor_pressure =
-      CalculateSlopeOfSaturatedVaporPressure(meteorology.air_temperature());
-
-  // This is mentioned in the book p.77.
-  constexpr double gamma = 0.658;
-
-  // They are denoted as r_a_s and r_a_a in the book.
-  AeroResistances aero_resistances =
-      CalculateAeroResistances(meteorology.wind_speed(), soil_);
+    const Meteorology &meteorology, const PlantRadiation &plant_radiation,
+    const DailyResistances &resistances) {
+  const HeatFluxes fluxes =
+      CalculateHourlyHeatFluxes(meteorology, plant_radiation, resistances);
+  total_latent_heat_flux_ = fluxes.total_latent;
+  latent_heat_flux_soil_ = fluxes.latent_soil;
+  latent_heat_flux_crop_ = fluxes.latent_crop;
+  total_sensible_heat_flux_ = fluxes.total_sensible;
+  sensible_heat_flux_soil_ = fluxes.sensible_soil;
+  sensible_heat_flux_crop_ = fluxes.sensible_crop;
+}
 
-  // This is denoted as r_a_c in the book.
-  double boundary_layer_resistance = CalculateBoundaryLayerResistance();
+EnergyBalance::DailyResistances EnergyBalance::CalculateDailyResistances()
+    const {
+  return {CalculateAeroResistances(internal_constants_, plant_height_,
+                                   kReferenceHeight, params_),
+          CalculateBoundaryLayerResistance(internal_constants_, plant_height_,
+                                           leaf_area_index_, leaf_width_,
+                                           params_),
+          CalculateSoilResistance(soil_.surface_water_content(), params_)};
+}
 
-  // This is denoted as r_s_c in the book.
-  double canopy_resistance =
-      CalculateCanopyResistance(meteorology.hourly_total_irradiance());
+EnergyBalance::HeatFluxes EnergyBalance::CalculateHourlyHeatFluxes(
+    const Meteorology &meteorology, const PlantRadiation &plant_radiation,
+    const DailyResistances &resistances) const {
+  // Formula [4.15] in book p.79
+  // D = e_s(T_r) - e_r
+  const double vapor_pressure_deficit = meteorology.saturated_vapor_pressure() -
+                                        meteorology.actual_vapor_pressure();
+
+  return CalculateHeatFluxes(
+      CalculateSlopeOfSaturatedVaporPressure(meteorology.air_temperature()),
+      vapor_pressure_deficit, resistances,
+      CalculateCanopyResistance(meteorology.hourly_total_irradiance(),
+                                leaf_area_index_, params_),
+      CalculateEnergySupply(
+          meteorology.hourly_net_radiation_,
+          plant_radiation.CalculateExtinctionCoefficientForDirect(
+              meteorology.solar_elevation()),
+          meteorology.solar_inclination(), leaf_area_index_));
+}
 
-  // This is denoted as r_s_s in the book.
-  double soil_resistance = CalculateSoilResistance(soil_);
+EnergyBalance::HeatFluxes EnergyBalance::CalculateHeatFluxes(
+    const double slope_of_saturated_vapor_pressure,
+    const double vapor_pressure_deficit, const DailyResistances &resistances,
+    const double canopy_resistance, const EnergySupply &energy_supply) {
+  // This is mentioned in the book p.77.
+  constexpr double gamma = 0.658;
 
-  // They are denoted as A_c and A_s in the book.
-  EnergySupply energy_supply = CalculateEnergySupply(
-      meteorology.hourly_net_radiation_,
-      plant_radiation.CalculateExtinctionCoefficientForDirect(
-          meteorology.local_solar_hour_),
-      meteorology.solar_inclination());
+  const AeroResistances &aero_resistances = resistances.aero;
+  const double boundary_layer_resistance = resistances.boundary_layer;
+  const double soil_resistance = resistances.soil;
 
   // This is denoted as A in the book.
   double total_available_energy = energy_supply.canopy + energy_supply.soil;
@@ -81,13 +133,9 @@ void EnergyBalance::UpdateHourlyHeatFluxes(
   // This is denoted as ρ * c_p in the book. It is mentioned in book p.77.
   constexpr double heat_to_raise_one_Kelvin_unit_volume = 1221.09;
 
-  // Formula [4.15] in book p.79
-  // D = e_s(T_r) - e_r
-  double vapor_pressure_deficit = meteorology.saturated_vapor_pressure() -
-                                  meteorology.actual_vapor_pressure();
-
+  HeatFluxes fluxes;
   // This is denoted as λET in the book.
-  total_latent_heat_flux_ = CalculateTotalLatentHeatFlux(
+  fluxes.total_latent = CalculateTotalLatentHeatFlux(
       slope_of_saturated_vapor_pressure, aero_resistances,
       boundary_layer_resistance, canopy_resistance, soil_resistance,
       energy_supply, total_available_energy, vapor_pressure_deficit);
@@ -99,8 +147,7 @@ void EnergyBalance::UpdateHourlyHeatFluxes(
       (aero_resistances.between_canopy_reference_height /
        heat_to_raise_one_Kelvin_unit_volume) *
           (slope_of_saturated_vapor_pressure * total_available_energy -
-           (slope_of_saturated_vapor_pressure + gamma) *
-               total_latent_heat_flux_);
+           (slope_of_saturated_vapor_pressure + gamma) * fluxes.total_latent);
 
   double numerator, denominator;
   // Formula [4.43] in book p.84
@@ -114,7 +161,7 @@ void EnergyBalance::UpdateHourlyHeatFluxes(
       slope_of_saturated_vapor_pressure +
       (gamma * (soil_resistance + aero_resistances.between_soil_canopy) /
        aero_resistances.between_soil_canopy);
-  latent_heat_flux_soil_ = numerator / denominator;
+  fluxes.latent_soil = numerator / denominator;
 
   // Formula [4.43] in book p.84
   // λET_c = ((Δ * A_c) + (ρ * c_p * D_0 / r_a_c)) / (Δ + γ * (r_s_c + r_a_c) /
@@ -126,7 +173,7 @@ void EnergyBalance::UpdateHourlyHeatFluxes(
   denominator = slope_of_saturated_vapor_pressure +
                 (gamma * (canopy_resistance + boundary_layer_resistance) /
                  boundary_layer_resistance);
-  latent_heat_flux_crop_ = numerator / denominator;
+  fluxes.latent_crop = numerator / denominator;
 
   // Formula [4.44] in book p.84
   // H_s = (γ * A_s * (r_s_s + r_a_s) - ρ * c_p * D_0) / (Δ * r_a_s + γ * (r_s_s
@@ -139,7 +186,7 @@ void EnergyBalance::UpdateHourlyHeatFluxes(
       (slope_of_saturated_vapor_pressure *
        aero_resistances.between_soil_canopy) +
       (gamma * (soil_resistance + aero_resistances.between_soil_canopy));
-  sensible_heat_flux_soil_ = numerator / denominator;
+  fluxes.sensible_soil = numerator / denominator;
 
   // Formula [4.44] in book p.84
   // H_c = (γ * A_c * (r_s_c + r_a_c) - ρ * c_p * D_0) / (Δ * r_a_c + γ * (r_s_c
@@ -151,26 +198,26 @@ void EnergyBalance::UpdateHourlyHeatFluxes(
   denominator =
       (slope_of_saturated_vapor_pressure * boundary_layer_resistance) +
       (gamma * (canopy_resistance + boundary_layer_resistance));
-  sensible_heat_flux_crop_ = numerator / denominator;
-  total_sensible_heat_flux_ =
-      sensible_heat_flux_crop_ + sensible_heat_flux_soil_;
+  fluxes.sensible_crop = numerator / denominator;
+  fluxes.total_sensible = fluxes.sensible_crop + fluxes.sensible_soil;
+  return fluxes;
 }
 
 EnergyBalance::InternalConstants EnergyBalance::CalculateInternalConstants(
-    const double wind_speed) const {
+    const double wind_speed, const double plant_height) {
   // Formula [4.62] in book p.92
   // d = 0.64 * h
-  double zero_plane_displacement = 0.64f * plant_height_;
+  double zero_plane_displacement = 0.64f * plant_height;
 
   // Formula [4.62] in book p.92
   // z_0 = 0.13 * h
-  double roughness_length = 0.13f * plant_height_;
+  double roughness_length = 0.13f * plant_height;
 
   // Formula [4.67] in book p.94
   // u_star = k * u(z) / ln((z - d) / z_0)
   double friction_velocity =
       kVKConstant * wind_speed /
-      std::log((plant_height_ - zero_plane_displacement) / roughness_length);
+      std::log((plant_height - zero_plane_displacement) / roughness_length);
 
   return {zero_plane_displacement, roughness_length, friction_velocity};
 }
@@ -187,72 +234,78 @@ double EnergyBalance::CalculateSlopeOfSaturatedVaporPressure(
 }
 
 EnergyBalance::AeroResistances EnergyBalance::CalculateAeroResistances(
-    const double wind_speed, const Soil &soil) const {
-  // TODO: these variables should be set
-  double n;  // attenuation coefficient for eddy diffusivity
+    const InternalConstants &internal_constants, const double plant_height,
+    const double reference_height, const EnergyBalanceParameters &params) {
+  // attenuation coefficient for eddy diffusivity
+  const double n = params.eddy_diffusivity_attenuation;
 
   // The roughness length of the soil
   // TODO: Should be depend on the texture of soil. Table is in p.92.
-  double roughness_lengths_soil;
+  const double roughness_lengths_soil = params.soil_roughness_length;
 
   // Formula [4.65] in book p.94
   // K(h) = k * u_* * h
   double eddy_diffusivity_canopy_top =
-      kVKConstant * internal_constants_.friction_velocity * plant_height_;
+      kVKConstant * internal_constants.friction_velocity * plant_height;
 
   // Formula [4.68] in book p.94
   // r_a_s = h * exp(n) / (n * K(h)) * (exp(-n * z_s0 / h) -
   // exp(-n * (z_0 + d) / h))
   double aero_resistance_soil_canopy =
-      plant_height_ * std::exp(n) / (n * eddy_diffusivity_canopy_top) *
-      (exp(-n * roughness_lengths_soil / plant_height_) -
+      plant_height * std::exp(n) / (n * eddy_diffusivity_canopy_top) *
+      (exp(-n * roughness_lengths_soil / plant_height) -
        exp(-n *
-           (internal_constants_.roughness_length +
-            internal_constants_.zero_plane_displacement) /
-           plant_height_));
+           (internal_constants.roughness_length +
+            internal_constants.zero_plane_displacement) /
+           plant_height));
 
   // Formula [4.69] in book p.94
   // r_a_a = (1 / (k * u_star)) * ln((z_r - d) / (h - d)) + (h / (n * K(h))) *
   // (exp(n * (1 - ((z_0 + d) / h))) - 1)
   double aero_resistance_canopy_reference_height =
-      (1.0f / (kVKConstant * internal_constants_.friction_velocity)) *
+      (1.0f / (kVKConstant * internal_constants.friction_velocity)) *
           std::log(
-              (kReferenceHeight - internal_constants_.zero_plane_displacement) /
-              (plant_height_ - internal_constants_.zero_plane_displacement)) +
-      ((plant_height_ / (n * eddy_diffusivity_canopy_top)) *
-       (std::exp(n * (1.0f - (internal_constants_.roughness_length +
-                              internal_constants_.zero_plane_displacement) /
-                                 plant_height_)) -
+              (reference_height - internal_constants.zero_plane_displacement) /
+              (plant_height - internal_constants.zero_plane_displacement)) +
+      ((plant_height / (n * eddy_diffusivity_canopy_top)) *
+       (std::exp(n * (1.0f - (internal_constants.roughness_length +
+                              internal_constants.zero_plane_displacement) /
+                                 plant_height)) -
         1.0f));
 
   return {aero_resistance_soil_canopy, aero_resistance_canopy_reference_height};
 }
 
-double EnergyBalance::CalculateBoundaryLayerResistance() const {
-  // TODO: fill in this variable
+double EnergyBalance::CalculateBoundaryLayerResistance(
+    const InternalConstants &internal_constants, const double plant_height,
+    const double leaf_area_index, const double leaf_width,
+    const EnergyBalanceParameters &params) {
   // This variable depends on the type of plant. Check out the table in p.93.
-  double wind_attenuation_coefficient;
+  const double wind_attenuation_coefficient =
+      params.wind_attenuation_coefficient;
 
   // Formula [4.63] in book p.93
   // u(h) = u_star / k * ln((h - d) / z_0)
   double wind_speed_canopy_top =
-      internal_constants_.friction_velocity / kVKConstant *
-      std::log((plant_height_ - internal_constants_.zero_plane_displacement) /
-               internal_constants_.zero_plane_displacement);
+      internal_constants.friction_velocity / kVKConstant *
+      std::log((plant_height - internal_constants.zero_plane_displacement) /
+               internal_constants.roughness_length);
 
   // Formula [4.78] in book p.97
   // r_a_c = α / (0.012 * L * (1 - exp(-α / 2)) * sqrt(u(h) / w))
   return (wind_attenuation_coefficient /
-          (0.012f * leaf_area_index_ *
+          (0.012f * leaf_area_index *
            (1 - std::exp(-wind_attenuation_coefficient / 2.0f)) *
-           std::sqrt(wind_speed_canopy_top / leaf_width_)));
+           std::sqrt(wind_speed_canopy_top / leaf_width)));
 }
 
-double EnergyBalance::CalculateCanopyResistance(double total_radiance) const {
-  // TODO: fill in this variable
+double EnergyBalance::CalculateCanopyResistance(
+    double total_radiance, const double leaf_area_index,
+    const EnergyBalanceParameters &params) {
   // These two variables depend on the type of plant. They are mentioned in book
   // p.97.
-  double a_1, a_2;
+  const double a_1 = params.stomatal_a_1;
+  const double a_2 = params.stomatal_a_2;
 
   // Avoid dividing zero
   if (total_radiance <= 0.0) {
@@ -265,27 +318,29 @@ double EnergyBalance::CalculateCanopyResistance(double total_radiance) const {
   // r_st = (a_1 + I_PAR) / (a_2 * I_PAR)
   double stomatal_resistance = (a_1 + irradiance_PAR) / (a_2 * irradiance_PAR);
 
-  if (leaf_area_index_ > 0.5f * kTypicalMaxLeafIndexArea) {
+  if (leaf_area_index > 0.5f * kTypicalMaxLeafIndexArea) {
     // Formula [4.80] in book p.98
     // r_s_c = r_st / (0.5 * L_cr) for L > 0.5L_cr
     return stomatal_resistance / (0.5f * kTypicalMaxLeafIndexArea);
   } else {
     // Formula [4.80] in book p.98
     // r_s_c = r_st / L for L <= 0.5L_cr
-    return stomatal_resistance / leaf_area_index_;
+    return stomatal_resistance / leaf_area_index;
   }
 }
 
-double EnergyBalance::CalculateSoilResistance(const Soil &soil) {
-  // TODO: fill in these variables. These variables seem to have to be acquired
-  // from some data source. There is no easy way for this moment to retrieve
-  // these variables in our model.
+double EnergyBalance::CalculateSoilResistance(
+    const double soil_water_volumetric_content,
+    const EnergyBalanceParameters &params) {
+  // TODO: These variables seem to have to be acquired from some data source.
+  // There is no easy way for this moment to retrieve these variables in our
+  // model.
   // This is denoted as λ in the book.
-  double pore_size_distribution_index;
-  // This is denoted as Θ_v in the book.
-  double soil_water_volumetric_content;
+  const double pore_size_distribution_index =
+      params.pore_size_distribution_index;
   // This is denoted as Θ_v,sat in the book.
-  double volumetric_water_content_at_soil_saturation;
+  const double volumetric_water_content_at_soil_saturation =
+      params.water_content_at_saturation;
 
   // Thickness of the dry soil which is denoted as l in book
   // TODO: The book just takes this as 0.02. Maybe we could make some changes on
@@ -293,8 +348,7 @@ double EnergyBalance::CalculateSoilResistance(const Soil &soil) {
   double thickness_dry_soil = 0.02;
 
   // Soil's total porosity which is denoted as Φ_p in book
-  // TODO: fill this
-  double soil_total_porosity;
+  const double soil_total_porosity = params.soil_total_porosity;
 
   // Formula [4.85] in book p.100
   // r_s,dry_s = (τl) / (Φ_p * D_m,v)
@@ -318,7 +372,7 @@ double EnergyBalance::CalculateSoilResistance(const Soil &soil) {
 
 EnergyBalance::EnergySupply EnergyBalance::CalculateEnergySupply(
     const double hour_net_radiance, const double extinction_coefficient_direct,
-    const double solar_inclination) const {
+    const double solar_inclination, const double leaf_area_index) {
   double radiance_soil = 0.0f, radiance_canopy = 0.0f;
   if (hour_net_radiance > 0.0) {
     // This is mentioned in book p.57.
@@ -327,7 +381,7 @@ EnergyBalance::EnergySupply EnergyBalance::CalculateEnergySupply(
     // Formula [3.6] in book p.57
     // τ_dr_α = exp(-sqrt(α) * k_dr * L)
     double penetration_function_direct = std::exp(
-        -std::sqrt(alpha) * extinction_coefficient_direct * leaf_area_index_);
+        -std::sqrt(alpha) * extinction_coefficient_direct * leaf_area_index);
 
     // Formula [4.30] in book p.82
     // A_c = (1 - τ_dr_α) * R_n
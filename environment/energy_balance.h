@@ -5,11 +5,42 @@
 
 #include "environment/meteorology.h"
 #include "environment/plant_radiation.h"
+#include "environment/quadrature.h"
 #include "environment/soil.h"
 #include "environment/weather.h"
 
 namespace environment {
 
+// The properties of a crop and its soil which the energy balance depends on,
+// but which we have no data source for yet. The defaults are typical values.
+// TODO: Take them from the species of the plant and the texture of the soil.
+struct EnergyBalanceParameters {
+  // Attenuation coefficient for eddy diffusivity in the canopy, denoted as n
+  // in the book (p.94).
+  double eddy_diffusivity_attenuation = 2.5;
+  // Roughness length of the soil surface (meters), denoted as z_s0 in the book
+  // (p.92).
+  double soil_roughness_length = 0.01;
+  // Wind attenuation coefficient of the canopy, denoted as α in the book
+  // (p.93).
+  double wind_attenuation_coefficient = 3.0;
+  // Coefficients of the stomatal resistance, denoted as a_1 (W m^-2) and a_2
+  // (m s^-1) in the book (p.97).
+  double stomatal_a_1 = 50.0;
+  double stomatal_a_2 = 0.01;
+  // Pore size distribution index of the soil, denoted as λ in the book
+  // (p.101).
+  double pore_size_distribution_index = 0.3;
+  // Total porosity of the soil, denoted as Φ_p in the book (p.100).
+  double soil_total_porosity = 0.45;
+  // Volumetric water content at saturation (m^3 m^-3), denoted as Θ_v,sat in
+  // the book, as in `WaterBalance`.
+  double water_content_at_saturation = 0.39;
+  // The wind speed is taken to be at least this (m s^-1), since the
+  // resistances are infinite in still air.
+  double min_wind_speed = 0.5;
+};
+
 // Represents the amounts of energy on a single plant. Here we make the plant
 // and the soil it is on fixed. Only time would change. This is not fully
 // complete since they are some data that I have no idea how to get. Currently,
@@ -25,7 +56,9 @@ class EnergyBalance {
                 const PlantRadiation &plant_radiation, const Weather &weather,
                 const double reference_height, const double plant_height,
                 const double leaf_area_index, const double leaf_width,
-                const Soil &soil);
+                const Soil &soil,
+                const EnergyBalanceParameters &params =
+                    EnergyBalanceParameters());
 
   // Updates the data in this class according to the given information.
   void Update(const Meteorology &meteorology,
@@ -47,7 +80,35 @@ class EnergyBalance {
     return sensible_heat_flux_crop_;
   }
 
+  // The heat fluxes integrated from sunrise to sunset (J m^-2 day^-1).
+  inline double daily_total_latent_heat_flux() const {
+    return daily_heat_fluxes_.total_latent;
+  }
+  inline double daily_latent_heat_flux_soil() const {
+    return daily_heat_fluxes_.latent_soil;
+  }
+  inline double daily_latent_heat_flux_crop() const {
+    return daily_heat_fluxes_.latent_crop;
+  }
+  inline double daily_total_sensible_heat_flux() const {
+    return daily_heat_fluxes_.total_sensible;
+  }
+  inline double daily_sensible_heat_flux_soil() const {
+    return daily_heat_fluxes_.sensible_soil;
+  }
+  inline double daily_sensible_heat_flux_crop() const {
+    return daily_heat_fluxes_.sensible_crop;
+  }
+
+  // The options of the integration of the daily heat fluxes, which applies
+  // from the next `Update()`.
+  void set_daily_quadrature_options(const QuadratureOptions &options) {
+    daily_quadrature_options_ = options;
+  }
+
  private:
+  friend class CellEnergyBalance;
+
   struct InternalConstants {
     // Zero plant displacement (meters)
     double zero_plane_displacement;
@@ -74,6 +135,26 @@ class EnergyBalance {
     double canopy;
   };
 
+  // The resistances which do not change over a day, computed once for all the
+  // solar hours of the daily integration.
+  struct DailyResistances {
+    // They are denoted as r_a_s and r_a_a in the book.
+    AeroResistances aero;
+    // This is denoted as r_a_c in the book.
+    double boundary_layer;
+    // This is denoted as r_s_s in the book.
+    double soil;
+  };
+
+  struct HeatFluxes {
+    double total_latent;
+    double latent_soil;
+    double latent_crop;
+    double total_sensible;
+    double sensible_soil;
+    double sensible_crop;
+  };
+
   // Has a private `meteorology_` and a private `plant_radiation_` so that this
   // class may work independently. When calculating the daily heat fluxes, we
   // need to switch between different solar hours. Doing that requires the help
@@ -99,6 +180,8 @@ class EnergyBalance {
   // This is the soil that the plant is on.
   const Soil &soil_;
 
+  const EnergyBalanceParameters params_;
+
   // Internal constants
   //
   // Formula [4.53] in book p.88
@@ -136,24 +219,52 @@ class EnergyBalance {
   double sensible_heat_flux_soil_;
   double sensible_heat_flux_crop_;
 
-  // Updates the information according to the specified solar hour. This
-  // utilizes the private `meteorology_` and `plant_radiation_`. This should
-  // only be used by `UpdateDailyHeatFluxes()`.
+  // The unit is J m^-2 day^-1.
+  HeatFluxes daily_heat_fluxes_;
+  QuadratureOptions daily_quadrature_options_;
+
+  // Updates the hour-dependent information of the private `meteorology_` and
+  // `plant_radiation_` to the specified solar hour. This should only be used
+  // by `UpdateDailyHeatFluxes()`.
   void UpdateSolarHour(const double solar_hour, const Weather &weather);
 
-  // Does the integration over the whole solar day. It needs to get the energy
-  // values under different solar hours. This relies on the help of
+  // Integrates the heat fluxes from sunrise to sunset of the day of
+  // `meteorology`. The fluxes are only computed at the solar hours of the
+  // quadrature nodes, usually far fewer than 24, with the resistances which
+  // do not depend on the hour computed once. This relies on the help of
   // `UpdateSolarHour()`.
-  void UpdateDailyHeatFluxes(const Weather &weather);
+  void UpdateDailyHeatFluxes(const Meteorology &meteorology,
+                             const Weather &weather,
+                             const DailyResistances &resistances);
 
   // Updates the hourly energy values according to the given `meteorology` and
   // `plant_radiation`.
   void UpdateHourlyHeatFluxes(const Meteorology &meteorology,
-                              const PlantRadiation &plant_radiation);
+                              const PlantRadiation &plant_radiation,
+                              const DailyResistances &resistances);
+
+  // Returns the resistances which do not depend on the solar hour.
+  DailyResistances CalculateDailyResistances() const;
+
+  // Returns the heat fluxes (W m^-2) at the hour of `meteorology` and
+  // `plant_radiation` given the resistances of the day.
+  HeatFluxes CalculateHourlyHeatFluxes(
+      const Meteorology &meteorology, const PlantRadiation &plant_radiation,
+      const DailyResistances &resistances) const;
+
+  // Returns the heat fluxes (W m^-2) of soil and crop given the slope of the
+  // saturated vapor pressure (mbar K^-1), the vapor pressure deficit (mbar),
+  // the resistances of the day and the canopy resistance (s m^-1), and the
+  // energy available to soil and canopy (W m^-2).
+  static HeatFluxes CalculateHeatFluxes(
+      const double slope_of_saturated_vapor_pressure,
+      const double vapor_pressure_deficit, const DailyResistances &resistances,
+      const double canopy_resistance, const EnergySupply &energy_supply);
 
   // Returns all internal constants for other functions to use given the wind
-  // speed (m s^-1) from the weather data.
-  InternalConstants CalculateInternalConstants(const double wind_speed) const;
+  // speed (m s^-1) from the weather data and the plant height (meters).
+  static InternalConstants CalculateInternalConstants(
+      const double wind_speed, const double plant_height);
 
   // Returns the slope of the saturated vapor pressure (mbar) given a
   // temperature (°C).
@@ -165,27 +276,36 @@ class EnergyBalance {
 
   // Returns a pair of aero resistances (s m^-1), one of which is between the
   // reference height and the mean canopy flow and the other of which is between
-  // the mean canopy flow and the below soil surface, given the wind speed (m
-  // s^-1) from the weather data and soil information.
-  AeroResistances CalculateAeroResistances(const double wind_speed,
-                                           const Soil &soil) const;
+  // the mean canopy flow and the below soil surface, given the internal
+  // constants, the plant height and the reference height (meters).
+  static AeroResistances CalculateAeroResistances(
+      const InternalConstants &internal_constants, const double plant_height,
+      const double reference_height, const EnergyBalanceParameters &params);
 
   // Returns the boundary layer resistance (s m^-1) given the plant information.
-  double CalculateBoundaryLayerResistance() const;
+  static double CalculateBoundaryLayerResistance(
+      const InternalConstants &internal_constants, const double plant_height,
+      const double leaf_area_index, const double leaf_width,
+      const EnergyBalanceParameters &params);
 
   // Returns the canopy resistance (s m^-1) given the total radiance (W m^-2)
-  // and some plant information.
-  double CalculateCanopyResistance(double total_radiance) const;
+  // and the leaf area index.
+  static double CalculateCanopyResistance(
+      double total_radiance, const double leaf_area_index,
+      const EnergyBalanceParameters &params);
 
-  // Returns the soil resistance (s m^-1) given the information about soil.
-  static double CalculateSoilResistance(const Soil &soil);
+  // Returns the soil resistance (s m^-1) given the volumetric water content of
+  // the top soil layer (m^3 m^-3).
+  static double CalculateSoilResistance(
+      const double soil_water_volumetric_content,
+      const EnergyBalanceParameters &params);
 
   // Returns the energy available to soil and canopy (W m^-2) given the hourly
-  // net radiance (W m^-2), extinction_coefficient_direct (unit-less), and solar
-  // inclination (radians).
-  EnergySupply CalculateEnergySupply(const double hour_net_radiance,
-                                     const double extinction_coefficient_direct,
-                                     const double solar_inclination) const;
+  // net radiance (W m^-2), extinction_coefficient_direct (unit-less), solar
+  // inclination (radians), and leaf area index.
+  static EnergySupply CalculateEnergySupply(
+      const double hour_net_radiance, const double extinction_coefficient_direct,
+      const double solar_inclination, const double leaf_area_index);
 
   // Returns the total latent heat flux (W m^-2) given the slope of the
   // saturated vapor pressure (mbar K^-1), aero resistances (s m^-1), boundary
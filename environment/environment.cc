@@ -3,6 +3,8 @@
 #include "environment/resource.h"
 #include "environment/water_balance.h"
 
+#include <algorithm>
+#include <cmath>
 #include <ctime>
 
 namespace environment {
@@ -13,18 +15,35 @@ Environment::Environment(const config::Config &config,
                          const std::chrono::duration<int> &time_step_length)
     : config_(config),
       climate_(config),
+      // no weather until a series is set, see `SetWeatherSeries()`
+      weather_(0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+      weather_series_(nullptr),
+      fallback_weather_(weather_),
+      weather_day_(kNoDay),
+      meteorology_(time, config.location, climate_.climate_zone, weather_),
       timestamp_(time),
       time_step_length_(time_step_length),
+      weather_generator_(time_step_length),
       time_step_(0),
-      weather_(0.0, 0.0, 0.0, 0.0, 0.0,
-               0.0),  // TODO: Get weather data and put them into this struct.
-      meteorology_(time, config.location, climate_.climate_zone, weather_),
-      terrain_(terrain_raw_data, meteorology_) {
+      terrain_(terrain_raw_data, meteorology_),
+      photon_simulator_(nullptr),
+      photon_simulation_interval_(1),
+      last_photon_simulation_time_step_(-1),
+      last_canopy_version_(0),
+      growth_mode_(GrowthMode::PER_STEP),
+      pending_growth_days_(0.0) {
   // TODO: Create some data structure here
   auto to_round = timestamp_.time_since_epoch() % time_step_length_;
   timestamp_ -= to_round;
 }
 
+std::unique_ptr<Environment> Environment::Fork() const {
+  auto fork = std::make_unique<Environment>(*this);
+  fork->photon_simulator_ = nullptr;
+  fork->last_photon_simulation_time_step_ = -1;
+  return fork;
+}
+
 void Environment::JumpToTimeStep(const int64_t time_step) {
   SyncActionPqToTimeStep(time_step);
   SimulateToTimeStep(time_step);
@@ -34,29 +53,40 @@ void Environment::JumpForwardTimeStep(const int64_t time_step_num) {
   JumpToTimeStep(time_step_ + time_step_num);
 }
 
+void Environment::SetPhotonSimulator(
+    const std::shared_ptr<simulator::Simulator> &simulator,
+    const int64_t interval) {
+  photon_simulator_ = simulator;
+  photon_simulation_interval_ = interval;
+  last_photon_simulation_time_step_ = -1;
+}
+
 void Environment::ReceiveAction(const agent::action::Action *action) {
   ReceiveActions(agent::action::ActionList(1, action));
 }
 
 void Environment::ReceiveActions(const agent::action::ActionList &actions) {
   for (const auto &action : actions) {
-    action_pq_.push(action);
+    scheduler_.Schedule(action);
   }
 }
 
 void Environment::SyncActionPqToTimeStep(const int64_t time_step) {
+  auto &action_pq = scheduler_.action_pq();
+  auto &starting_action_pq = scheduler_.starting_action_pq();
+
   // Handle one action per loop.
-  while (!action_pq_.empty() || !starting_action_pq_.empty()) {
-    // `action_pq_` is empty or the start time of the very first action is after
+  while (!action_pq.empty() || !starting_action_pq.empty()) {
+    // `action_pq` is empty or the start time of the very first action is after
     // the specified time step
     bool no_actions_to_start =
-        action_pq_.empty() || action_pq_.top()->start_time_step() > time_step;
+        action_pq.empty() || action_pq.top()->start_time_step() > time_step;
 
     // `startint_pq_` is empty or the end time of the very first action is after
     // the specified time step
     bool no_actions_to_take_effect =
-        starting_action_pq_.empty() ||
-        starting_action_pq_.top()->end_time_step() > time_step;
+        starting_action_pq.empty() ||
+        starting_action_pq.top()->end_time_step() > time_step;
 
     if (no_actions_to_start && no_actions_to_take_effect) {
       // no actions should be pushed or poped at this time step
@@ -64,12 +94,12 @@ void Environment::SyncActionPqToTimeStep(const int64_t time_step) {
     }
 
     // check whose top action of the two PQ goes first
-    if (!starting_action_pq_.empty() &&
-        (action_pq_.empty() || starting_action_pq_.top()->end_time_step() <=
-                                   action_pq_.top()->start_time_step())) {
-      // pop the action in `starting_action_pq_`
-      const auto action = starting_action_pq_.top();
-      starting_action_pq_.pop();
+    if (!starting_action_pq.empty() &&
+        (action_pq.empty() || starting_action_pq.top()->end_time_step() <=
+                                  action_pq.top()->start_time_step())) {
+      // pop the action in `starting_action_pq`
+      const auto action = starting_action_pq.top();
+      starting_action_pq.pop();
 
       // Simulate this environment before an action starts to be executed
       SimulateToTimeStep(action->end_time_step());
@@ -78,15 +108,16 @@ void Environment::SyncActionPqToTimeStep(const int64_t time_step) {
       std::cout << "Executed an action at " << action->end_time_step()
                 << "th time step\n";
       terrain_.ExecuteAction(*action);
-    } else if (!action_pq_.empty()) {
-      // pop the action in `action_pq_`
-      const auto action = action_pq_.top();
-      action_pq_.pop();
+      scheduler_.Finish(action);
+    } else if (!action_pq.empty()) {
+      // pop the action in `action_pq`
+      const auto action = action_pq.top();
+      action_pq.pop();
 
       // TODO: GLOG
       std::cout << "Starting an action at " << action->start_time_step()
                 << "th time step\n";
-      starting_action_pq_.push(action);
+      starting_action_pq.push(action);
     }
   }
 }
@@ -101,40 +132,151 @@ void Environment::SimulateToTimeStep(const int64_t time_step) {
   auto new_timestamp = timestamp_ + (time_step_diff * time_step_length_);
   // TODO: GLOG
 
+  // TODO: Pass the resources available to each plant.
+  const Resources resources;
+  const double time_step_seconds =
+      std::chrono::duration<double>(time_step_length_).count();
+  const double time_step_days = time_step_seconds / kSecsPerDay;
+  auto timestamp = timestamp_;
   while (time_step_ < time_step) {
+    UpdateWeather(timestamp);
+    weather_generator_.Update(timestamp, weather_, &meteorology_);
+    UpdatePhotonSimulation(timestamp);
+
     // Iterate through all plants, need to be able to modify plants, so not
-    // const
+    // const. Each cell with plants is added to the energy balance once, the
+    // first of its plants standing for its canopy.
+    energy_balance_.Clear();
+    energy_balance_cells_.clear();
+    cell_slots_.assign(terrain_.size() * terrain_.size(), kNoSlot);
     for (auto &plant : terrain_.plant_container()) {
-      const PlantRadiation &plant_radiation = plant->plant_radiation();
       plant->UpdatePlantRadiation(meteorology_);
 
-      // TODO: Do you need to actually get the soil flux instead? Where is it?
-      // Because we need that for water content in SOIL.
-      // TODO: The book uses these scalars? Why?
-      double total_flux_density_shaded_potential =
-          plant_radiation.total_flux_density_shaded() * flux_density_factor;
-      double total_flux_density_sunlit_potential =
-          plant_radiation.total_flux_density_sunlit() * flux_density_factor;
-
-      // TODO: Add rainfall amount to UpdateWaterContent
       const Coordinate &plant_coordinate = plant->position();
-      Soil &soil = terrain_.soil_container()[plant_coordinate];
-      soil.UpdateWaterContent(0 /* rainfall */,
-                              total_flux_density_sunlit_potential,
-                              total_flux_density_shaded_potential);
-
-      // TODO: Add in other factors like sunlight and water
-      // TODO: Figure out how to use this resource parameter
-      std::unordered_map<ResourceType, int64_t> resources = {};
-      plant->GrowStep(1, resources);
+      size_t &slot = cell_slots_.at(terrain_.CellIndex(plant_coordinate));
+      if (slot == kNoSlot) {
+        const Soil &soil = terrain_.soil_container()[plant_coordinate];
+        slot = energy_balance_.AddCell(
+            plant->height(), plant->plant_radiation().leaf_area_index(),
+            soil.surface_water_content());
+        energy_balance_cells_.push_back(plant_coordinate);
+      }
+    }
+
+    // The latent heat of all cells over this time step evaporates the water of
+    // their soil.
+    energy_balance_.Update(meteorology_);
+    const double rainfall = weather_.rainfall * time_step_days;
+    terrain_.soil_container().UpdateWaterContent(
+        energy_balance_cells_, rainfall,
+        energy_balance_.latent_heat_flux_soil(),
+        energy_balance_.latent_heat_flux_crop(), time_step_seconds);
+    for (const Coordinate &coordinate : energy_balance_cells_) {
+      terrain_.MarkCellChanged(coordinate);
+    }
+    // It rains on the cells without plants too, which are outside of the
+    // energy balance, so their water only percolates.
+    bare_cells_.clear();
+    for (size_t x = 0; x < terrain_.size(); ++x) {
+      for (size_t y = 0; y < terrain_.size(); ++y) {
+        const Coordinate coordinate(x, y);
+        if (cell_slots_[terrain_.CellIndex(coordinate)] == kNoSlot) {
+          bare_cells_.push_back(coordinate);
+        }
+      }
+    }
+    changed_bare_cells_.clear();
+    terrain_.soil_container().UpdateWaterContent(
+        bare_cells_, rainfall, time_step_seconds, &changed_bare_cells_);
+    for (const Coordinate &coordinate : changed_bare_cells_) {
+      terrain_.MarkCellChanged(coordinate);
+    }
+
+    // then water flows from the wetter to the drier cells
+    lateral_flow_cells_.clear();
+    lateral_flow_.Redistribute(time_step_days, &terrain_.soil_container(),
+                               &lateral_flow_cells_);
+    for (const Coordinate &coordinate : lateral_flow_cells_) {
+      terrain_.MarkCellChanged(coordinate);
+    }
+
+    for (auto &plant : terrain_.plant_container()) {
+      // the growth allowed by the water of the root zone, relative to a unit
+      // potential transpiration
+      const Soil &soil = terrain_.soil_container()[plant->position()];
+      const double water_factor =
+          WaterBalance::GrowthReduction(1.0, soil.root_zone_water_content());
+      plant->UpdateWaterFactor(
+          std::isnan(water_factor) ? 1.0 : std::clamp(water_factor, 0.0, 1.0));
+    }
+
+    // TODO: Add in other factors like sunlight
+    // TODO: Figure out how to use this resource parameter
+    const GrowthConditions conditions = {
+        meteorology_.air_temperature(), weather_.air_temperature,
+        meteorology_.day_length(), time_step_days};
+    if (growth_mode_ == GrowthMode::PER_STEP) {
+      terrain_.plant_container().GrowPlants(1, conditions, resources);
+    } else {
+      pending_growth_days_ += time_step_days;
+      const double num_days = std::floor(pending_growth_days_);
+      if (num_days >= 1.0) {
+        pending_growth_days_ -= num_days;
+        terrain_.plant_container().GrowPlantsDays(int64_t(num_days),
+                                                  conditions, resources);
+      }
     }
     time_step_++;
+    timestamp += time_step_length_;
   }
 
   time_step_ = time_step;
   timestamp_ = new_timestamp;
 }
 
+void Environment::SetWeatherSeries(
+    const std::shared_ptr<const WeatherSeries> &series) {
+  weather_series_ = series;
+  weather_day_ = kNoDay;
+  weather_ = fallback_weather_;
+  UpdateWeather(timestamp_);
+}
+
+void Environment::UpdateWeather(
+    const std::chrono::system_clock::time_point &timestamp) {
+  if (weather_series_ == nullptr) {
+    return;
+  }
+  const int64_t day = weather_series_->DayIndex(timestamp);
+  if (day == weather_day_) {
+    return;
+  }
+  weather_day_ = day;
+  weather_ = day >= 0 && size_t(day) < weather_series_->num_days()
+                 ? weather_series_->GetWeather(day, fallback_weather_)
+                 : fallback_weather_;
+}
+
+void Environment::UpdatePhotonSimulation(
+    const std::chrono::system_clock::time_point &timestamp) {
+  if (photon_simulator_ == nullptr) {
+    return;
+  }
+
+  const uint64_t canopy_version = terrain_.plant_container().canopy_version();
+  const bool is_due =
+      last_photon_simulation_time_step_ < 0 ||
+      time_step_ - last_photon_simulation_time_step_ >=
+          photon_simulation_interval_;
+  if (!is_due && canopy_version == last_canopy_version_) {
+    return;
+  }
+
+  photon_simulator_->SimulateToTime(this, timestamp);
+  last_photon_simulation_time_step_ = time_step_;
+  last_canopy_version_ = canopy_version;
+}
+
 std::ostream &operator<<(std::ostream &os, const Environment &env) {
   auto c_timestamp = std::chrono::system_clock::to_time_t(env.timestamp_);
   os << std::ctime(&c_timestamp);
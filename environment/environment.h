@@ -2,17 +2,28 @@
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_ENVIRONMENT_H_
 
 #include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "config/config.h"
 #include "config/terrain_raw_data.h"
+#include "environment/action_scheduler.h"
+#include "environment/cell_energy_balance.h"
 #include "environment/climate.h"
+#include "environment/lateral_flow.h"
 #include "environment/meteorology.h"
+#include "environment/simulators/simulator.h"
 #include "environment/terrain.h"
+#include "environment/utility.h"
 #include "environment/water_balance.h"
 #include "environment/weather.h"
+#include "environment/weather_generator.h"
+#include "environment/weather_series.h"
 
 namespace environment {
 
@@ -20,6 +31,15 @@ namespace environment {
 // TODO: Copy-on-Write
 class Environment {
  public:
+  // How plants are grown as time steps are simulated.
+  enum class GrowthMode {
+    // every time step, at the air temperature of the step
+    PER_STEP,
+    // once per whole day, from the minimum and maximum temperature of the day,
+    // which is much faster for long runs of short time steps
+    DAILY
+  };
+
   Environment(const config::Config &config,
               const config::TerrainRawData &terrain_raw_data,
               const std::chrono::system_clock::time_point &time,
@@ -39,11 +59,52 @@ class Environment {
   // actions are received here
   void ReceiveActions(const agent::action::ActionList &actions);
 
+  // Creates an action of type `T` from `args`, owned by this environment. Once
+  // received, it is deleted after taking effect; one which is never received
+  // has to be passed to `DeleteAction`. The memory of deleted actions is
+  // reused, so agents taking many actions do not allocate for each of them.
+  template <typename T, typename... Args>
+  T *NewAction(Args &&... args) {
+    return scheduler_.NewAction<T>(std::forward<Args>(args)...);
+  }
+  void DeleteAction(const agent::action::Action *action) {
+    scheduler_.DeleteAction(action);
+  }
+
+  // Runs `simulator` as a stage of the simulation to compute the light absorbed
+  // by each plant. It is re-run every `interval` time steps, or earlier if the
+  // canopy geometry has changed since its last run.
+  void SetPhotonSimulator(const std::shared_ptr<simulator::Simulator> &simulator,
+                          const int64_t interval);
+
+  // Takes the weather of each day from `series` from now on. The days it does
+  // not cover, and the values missing from it, keep the weather this
+  // environment had without it.
+  void SetWeatherSeries(const std::shared_ptr<const WeatherSeries> &series);
+
+  // Sets how plants are grown, by time steps unless set.
+  void SetGrowthMode(const GrowthMode mode) { growth_mode_ = mode; }
+
+  // Sets how water flows between the soil cells at every time step.
+  void SetLateralFlowParameters(const LateralFlowParameters &params) {
+    lateral_flow_ = LateralFlow(params);
+  }
+
+  // Returns a copy of this environment which can be simulated independently
+  // of it, e.g. on another thread. The plants and the pending actions created
+  // by `NewAction` are cloned, the other pending actions are shared, as
+  // actions are not modified when executed. The photon simulator stage is not
+  // copied, since a simulator is not safe to run on several environments at
+  // once; set another one on the fork if needed.
+  std::unique_ptr<Environment> Fork() const;
+
   // TODO: define it
   const int score() const;
 
   // Accessors
   inline const config::Config &config() const { return config_; }
+  // Unique to this environment, forks included; never 0.
+  inline uint64_t id() const { return id_.value(); }
   inline const Climate &climate() const { return climate_; }
   inline const std::chrono::system_clock::time_point &timestamp() const {
     return timestamp_;
@@ -52,28 +113,33 @@ class Environment {
     return time_step_length_;
   }
   inline const int64_t &time_step() const { return time_step_; }
+  inline GrowthMode growth_mode() const { return growth_mode_; }
   inline const Meteorology &meteorology() const { return meteorology_; }
   inline const Terrain &terrain() const { return terrain_; }
+  inline Terrain &mutable_terrain() { return terrain_; }
   inline const Weather &weather() const { return weather_; }
-  inline const std::priority_queue<const agent::action::Action *,
-                                   std::vector<const agent::action::Action *>,
-                                   agent::action::ActionStartTimeComparator>
-  action_pq() const {
-    return action_pq_;
+  inline const ActionScheduler::StartQueue action_pq() const {
+    return scheduler_.action_pq();
   }
-  inline const std::priority_queue<const agent::action::Action *,
-                                   std::vector<const agent::action::Action *>,
-                                   agent::action::ActionEndTimeComparator>
-  starting_action_pq() const {
-    return starting_action_pq_;
+  inline const ActionScheduler::EndQueue starting_action_pq() const {
+    return scheduler_.starting_action_pq();
   }
 
  private:
   friend std::ostream &operator<<(std::ostream &os, const Environment &env);
 
+  InstanceId id_;
   config::Config config_;
   const Climate climate_;
 
+  // declared before `meteorology_`, which is initialized from it
+  Weather weather_;
+  // The series `weather_` is read from, if any, the weather without it, and
+  // the index in the series of the day of `weather_`.
+  static constexpr int64_t kNoDay = std::numeric_limits<int64_t>::min();
+  std::shared_ptr<const WeatherSeries> weather_series_;
+  Weather fallback_weather_;
+  int64_t weather_day_;
   // the information of meteorology from the simulator
   Meteorology meteorology_;
 
@@ -81,15 +147,28 @@ class Environment {
   std::chrono::system_clock::time_point timestamp_;
   // The length of a time step
   const std::chrono::duration<int> time_step_length_;
+  // The sub-daily weather of `meteorology_` at each time step
+  WeatherGenerator weather_generator_;
   // Indicates the time step in which this environment is in
   int64_t time_step_;
 
   Terrain terrain_;
-  Weather weather_;
   // TODO: define a class for light information
 
   // Simulators:
 
+  // The photon simulator stage, see `SetPhotonSimulator()`.
+  std::shared_ptr<simulator::Simulator> photon_simulator_;
+  int64_t photon_simulation_interval_;
+  // The time step and the canopy version of the last photon simulation.
+  int64_t last_photon_simulation_time_step_;
+  uint64_t last_canopy_version_;
+
+  // Runs the photon simulator at `timestamp` if it is due at the current time
+  // step or the canopy has changed.
+  void UpdatePhotonSimulation(
+      const std::chrono::system_clock::time_point &timestamp);
+
   // Given a future time step, push actions which is starting before the time
   // step into the `starting_action_pq_` from `action_pq_` and make actions in
   // `starting_action_pq_` which has completed before the time step take effect.
@@ -103,25 +182,33 @@ class Environment {
   // Simulate this environment to a time point
   void SimulateToTimeStep(const int64_t time_step);
 
-  // This PQ collects all actions sent from an agent
-  std::priority_queue<const agent::action::Action *,
-                      std::vector<const agent::action::Action *>,
-                      agent::action::ActionStartTimeComparator>
-      action_pq_;
-
-  // This PQ collects all actions that are starting but have not taken effect.
-  std::priority_queue<const agent::action::Action *,
-                      std::vector<const agent::action::Action *>,
-                      agent::action::ActionEndTimeComparator>
-      starting_action_pq_;
-
-  // Explained on page 71, it's the amount of energy required to convert 1 kg of
-  // liquid water to vapor, without any change in temperature
-  static constexpr double latent_heat_of_vaporization_of_water = 2454000.0;
-  static constexpr double liquid_density_for_water_20c = 998.0;
-  static constexpr double flux_density_factor =
-      1000.0 /
-      (latent_heat_of_vaporization_of_water * liquid_density_for_water_20c);
+  // Reads the weather of the day of `timestamp` from the weather series when
+  // the day changes.
+  void UpdateWeather(const std::chrono::system_clock::time_point &timestamp);
+
+  // The actions sent from an agent, waiting to start or to take effect
+  ActionScheduler scheduler_;
+
+  GrowthMode growth_mode_;
+  // The time simulated since plants last grew in DAILY mode (days).
+  double pending_growth_days_;
+
+  // The energy balance of the cells with plants, their coordinates in the
+  // order of its arrays, and for each cell of the terrain, its index in them
+  // or kNoSlot. Reused at every time step.
+  static constexpr size_t kNoSlot = ~size_t(0);
+  CellEnergyBalance energy_balance_;
+  std::vector<Coordinate> energy_balance_cells_;
+  std::vector<size_t> cell_slots_;
+  // The cells without plants, and the ones whose water changed at the last
+  // time step. Reused at every time step.
+  std::vector<Coordinate> bare_cells_;
+  std::vector<Coordinate> changed_bare_cells_;
+
+  // The flow of water between soil cells, and the cells it changed at the
+  // last time step.
+  LateralFlow lateral_flow_;
+  std::vector<Coordinate> lateral_flow_cells_;
 };
 
 std::ostream &operator<<(std::ostream &os, const Environment &env);
@@ -0,0 +1,213 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_GDD_GROWTH_MODEL_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_GDD_GROWTH_MODEL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "environment/meteorology.h"
+#include "environment/plant.h"
+#include "environment/resource.h"
+
+namespace environment {
+
+// Returns the growing degree days (°C x days) of one day whose air temperature
+// follows a sine curve between `temp_min` and `temp_max` (°C), above
+// `base_temperature` (°C). This is the closed form of the integral of the
+// hourly temperature over the day (single sine method, Baskerville & Emin,
+// 1969), so a day costs a few operations instead of 24 steps.
+inline double DailyGrowingDegreeDays(const double temp_min,
+                                     const double temp_max,
+                                     const double base_temperature) {
+  if (temp_max <= base_temperature) {
+    return 0.0;
+  }
+  const double mean = (temp_min + temp_max) / 2.0;
+  if (temp_min >= base_temperature) {
+    return mean - base_temperature;
+  }
+  // the base is crossed at the phase `theta` of the sine
+  const double amplitude = (temp_max - temp_min) / 2.0;
+  const double theta = std::asin((base_temperature - mean) / amplitude);
+  return ((mean - base_temperature) * (kPI / 2.0 - theta) +
+          amplitude * std::cos(theta)) /
+         kPI;
+}
+
+// A growing degree day model of phenology and biomass, specialized by the
+// PlantProperty parameters of a species and by `Traits`, a struct of the form
+//
+//   struct Traits {
+//     // GDD (°C x days) from sowing to full bloom
+//     static constexpr double kGddToFullBloom = ...;
+//     // height (m) reached at full bloom
+//     static constexpr double kMaxHeight = ...;
+//     // dry matter (g) grown per GDD without stress
+//     static constexpr double kBiomassPerGdd = ...;
+//   };
+//
+// A plant develops by the GDD it accumulates while the day length is within
+// its photo period: it is a SEEDLING after 10% of the GDD to full bloom, a
+// JUVENILE after 40%, MATURE and flowering at full bloom, and OLD, ready to be
+// harvested, GDD_UNITS_AFTER_FULL_BLOOM later. Its height, biomass and
+// produce grow with the same GDD, scaled by its water factor and its health.
+// Every whole day spent beyond its killing temperatures, those of new growth
+// before it is mature, costs one point of health, and a dead plant does not
+// grow. The model consumes no resources yet.
+//
+// The model is used as the kernel of a species, see ModelSpecies, with a
+// per-step variant `Grow` and a daily variant `GrowDays`.
+template <typename Traits>
+struct GddGrowthModel {
+  // The parameters in the units the model computes in.
+  struct Params {
+    double base_temperature;            // °C
+    double min_new_growth_temperature;  // °C
+    double max_new_growth_temperature;  // °C
+    double min_absolute_temperature;    // °C
+    double max_absolute_temperature;    // °C
+    double min_photo_period;            // hours
+    double max_photo_period;            // hours
+    double max_yield;                   // g
+    double gdd_to_full_bloom;           // °C x days
+    double gdd_to_harvest;              // °C x days
+  };
+
+  // Converts the integer parameters, in milli units and seconds.
+  static Params MakeParams(const PlantParams &params) {
+    const double gdd_after_full_bloom =
+        FromMilli(params[PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM]);
+    return {FromMilli(params[PlantProperty::GDD_BASE_TEMPERATURE]),
+            FromMilli(params[PlantProperty::MIN_NEW_GROWTH_TEMPERATURE]),
+            FromMilli(params[PlantProperty::MAX_NEW_GROWTH_TEMPERATURE]),
+            FromMilli(params[PlantProperty::MIN_ABSOLUTE_TEMPERATURE]),
+            FromMilli(params[PlantProperty::MAX_ABSOLUTE_TEMPERATURE]),
+            double(params[PlantProperty::MIN_PHOTO_PERIOD]) / kSecsPerHour,
+            double(params[PlantProperty::MAX_PHOTO_PERIOD]) / kSecsPerHour,
+            double(params[PlantProperty::MAX_HARVEST_YIELD]),
+            Traits::kGddToFullBloom,
+            Traits::kGddToFullBloom + gdd_after_full_bloom};
+  }
+
+  // Grows `num_time_step` steps at the air temperature of `conditions`.
+  static void Grow(const Params &params, Plant::GrowthState *state,
+                   const int64_t num_time_step,
+                   const GrowthConditions &conditions,
+                   const Resources &available, Resources *consumed) {
+    if (state->health <= Plant::kMinHealth) {
+      return;
+    }
+    const double days = num_time_step * conditions.time_step_days;
+    const double temperature = conditions.air_temperature;
+    Stress(params, temperature, temperature, days, state);
+    if (!InPhotoPeriod(params, conditions.day_length)) {
+      return;
+    }
+    Develop(params, std::max(0.0, temperature - params.base_temperature) * days,
+            state);
+  }
+
+  // Grows `num_days` days alike, each between the minimum and maximum daily
+  // air temperature of `conditions`. A day is stressful if either of them is
+  // beyond the killing temperatures.
+  static void GrowDays(const Params &params, Plant::GrowthState *state,
+                       const int64_t num_days,
+                       const GrowthConditions &conditions,
+                       const Resources &available, Resources *consumed) {
+    if (state->health <= Plant::kMinHealth) {
+      return;
+    }
+    const MinMaxTemperature &temperature = conditions.daily_air_temperature;
+    Stress(params, temperature.min, temperature.max, num_days, state);
+    if (!InPhotoPeriod(params, conditions.day_length)) {
+      return;
+    }
+    Develop(params,
+            DailyGrowingDegreeDays(temperature.min, temperature.max,
+                                   params.base_temperature) *
+                num_days,
+            state);
+  }
+
+ private:
+  static constexpr double kMilli = 1000.0;
+
+  static double FromMilli(const int64_t value) { return value / kMilli; }
+
+  static bool InPhotoPeriod(const Params &params, const double day_length) {
+    return day_length >= params.min_photo_period &&
+           day_length <= params.max_photo_period;
+  }
+
+  // Accumulates `days` spent between `temp_min` and `temp_max` and takes the
+  // health of the whole days among them which were beyond the limits.
+  static void Stress(const Params &params, const double temp_min,
+                     const double temp_max, const double days,
+                     Plant::GrowthState *state) {
+    const bool mature = state->maturity >= Plant::MATURE;
+    const double lower = mature ? params.min_absolute_temperature
+                                : params.min_new_growth_temperature;
+    const double upper = mature ? params.max_absolute_temperature
+                                : params.max_new_growth_temperature;
+    if (temp_min >= lower && temp_max <= upper) {
+      return;
+    }
+    state->stress_days += days;
+    const double lost = std::floor(state->stress_days);
+    state->stress_days -= lost;
+    state->health = int(std::max<double>(Plant::kMinHealth,
+                                         state->health - lost));
+  }
+
+  // Grows by `gdd` degree days.
+  static void Develop(const Params &params, const double gdd,
+                      Plant::GrowthState *state) {
+    if (gdd <= 0.0) {
+      return;
+    }
+    const double before = FromMilli(state->accumulated_gdd);
+    state->accumulated_gdd += int(std::lround(gdd * kMilli));
+    const double after = FromMilli(state->accumulated_gdd);
+
+    const double factor = std::clamp(state->water_factor, 0.0, 1.0) *
+                          state->health / double(Plant::kMaxHealth);
+    // only the GDD of each phase count towards its growth
+    const double vegetative =
+        std::max(0.0, std::min(after, params.gdd_to_full_bloom) - before);
+    const double reproductive =
+        std::max(0.0, std::min(after, params.gdd_to_harvest) -
+                          std::max(before, params.gdd_to_full_bloom));
+
+    state->height =
+        std::min(Traits::kMaxHeight,
+                 state->height + factor * vegetative /
+                                     params.gdd_to_full_bloom *
+                                     Traits::kMaxHeight);
+    state->biomass +=
+        factor * (vegetative + reproductive) * Traits::kBiomassPerGdd;
+    const double gdd_after_full_bloom =
+        params.gdd_to_harvest - params.gdd_to_full_bloom;
+    if (gdd_after_full_bloom > 0.0) {
+      state->produce =
+          std::min(params.max_yield,
+                   state->produce + factor * reproductive /
+                                        gdd_after_full_bloom *
+                                        params.max_yield);
+    }
+
+    if (after >= params.gdd_to_harvest) {
+      state->maturity = Plant::OLD;
+    } else if (after >= params.gdd_to_full_bloom) {
+      state->maturity = Plant::MATURE;
+    } else if (after >= 0.4 * params.gdd_to_full_bloom) {
+      state->maturity = Plant::JUVENILE;
+    } else if (after >= 0.1 * params.gdd_to_full_bloom) {
+      state->maturity = Plant::SEEDLING;
+    }
+    state->flowering = state->maturity == Plant::MATURE;
+  }
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_GDD_GROWTH_MODEL_H_
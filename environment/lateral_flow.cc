@@ -0,0 +1,210 @@
+#include "lateral_flow.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "environment/water_balance.h"
+
+namespace environment {
+
+// Holds the threads sweeping the rows until all of them are done with a half
+// sweep.
+class LateralFlow::Barrier {
+ public:
+  explicit Barrier(const unsigned int num_threads)
+      : num_threads_(num_threads), num_waiting_(0), generation_(0) {}
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const unsigned int generation = generation_;
+    if (++num_waiting_ == num_threads_) {
+      num_waiting_ = 0;
+      ++generation_;
+      condition_.notify_all();
+      return;
+    }
+    condition_.wait(lock, [this, generation]() {
+      return generation != generation_;
+    });
+  }
+
+ private:
+  const unsigned int num_threads_;
+  unsigned int num_waiting_;
+  unsigned int generation_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+LateralFlow::LateralFlow(const LateralFlowParameters &params)
+    : params_(params) {}
+
+void LateralFlow::Redistribute(const double days, SoilContainer *soils,
+                               std::vector<Coordinate> *changed_cells) {
+  const size_t size = soils->size();
+  const size_t num_cells = size * size;
+  // water flows within the layers which all cells have
+  size_t num_layers = size == 0 ? 0 : SIZE_MAX;
+  for (size_t x = 0; x < size; ++x) {
+    for (size_t y = 0; y < size; ++y) {
+      num_layers = std::min(
+          num_layers, (*soils)[Coordinate(x, y)].water_content().size());
+    }
+  }
+  // the rows of the grid are the x coordinates
+  for (size_t layer = 0; layer < num_layers; ++layer) {
+    layer_.resize(num_cells);
+    for (size_t x = 0; x < size; ++x) {
+      for (size_t y = 0; y < size; ++y) {
+        layer_[x * size + y] =
+            (*soils)[Coordinate(x, y)].water_content()[layer];
+      }
+    }
+    // which leaves the water content before it in `previous_`
+    Redistribute(days, size, size, &layer_);
+
+    for (size_t x = 0; x < size; ++x) {
+      for (size_t y = 0; y < size; ++y) {
+        const size_t i = x * size + y;
+        (*soils)[Coordinate(x, y)].set_water_content(layer, layer_[i]);
+        if (changed_cells != nullptr &&
+            std::abs(layer_[i] - previous_[i]) > params_.tolerance) {
+          changed_cells->emplace_back(x, y);
+        }
+      }
+    }
+  }
+}
+
+int LateralFlow::Redistribute(const double days, const size_t rows,
+                              const size_t cols,
+                              std::vector<double> *water_content) {
+  const size_t num_cells = rows * cols;
+  if (num_cells == 0 || days <= 0.0) {
+    return 0;
+  }
+  double *x = water_content->data();
+
+  // The diffusivity of a face is the mean of its cells at the beginning of
+  // the time step, which keeps the system symmetric, so that what leaves a
+  // cell enters its neighbour.
+  const double factor = days / (params_.cell_width * params_.cell_width);
+  previous_.assign(x, x + num_cells);
+  east_.assign(num_cells, 0.0);
+  south_.assign(num_cells, 0.0);
+  diagonal_.assign(num_cells, 1.0);
+  diffusivity_.resize(num_cells);
+  for (size_t i = 0; i < num_cells; ++i) {
+    diffusivity_[i] = factor * Diffusivity(x[i]);
+  }
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < cols; ++c) {
+      const size_t i = r * cols + c;
+      if (c + 1 < cols) {
+        east_[i] = (diffusivity_[i] + diffusivity_[i + 1]) / 2.0;
+        diagonal_[i] += east_[i];
+        diagonal_[i + 1] += east_[i];
+      }
+      if (r + 1 < rows) {
+        south_[i] = (diffusivity_[i] + diffusivity_[i + cols]) / 2.0;
+        diagonal_[i] += south_[i];
+        diagonal_[i + cols] += south_[i];
+      }
+    }
+  }
+
+  unsigned int num_threads = params_.num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const size_t max_threads =
+      std::max<size_t>(1, num_cells / kMinCellsPerThread);
+  num_threads = std::min<size_t>({num_threads, rows, max_threads});
+  if (num_threads <= 1) {
+    return SweepBand(0, 1, rows, cols, x, nullptr);
+  }
+
+  // The threads are spawned once, and sweep the same rows until they converge
+  max_changes_.assign(num_threads, 0.0);
+  Barrier barrier(num_threads);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 1; t < num_threads; ++t) {
+    threads.emplace_back([this, t, num_threads, rows, cols, x, &barrier]() {
+      SweepBand(t, num_threads, rows, cols, x, &barrier);
+    });
+  }
+  const int sweeps = SweepBand(0, num_threads, rows, cols, x, &barrier);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return sweeps;
+}
+
+double LateralFlow::Diffusivity(const double water_content) const {
+  constexpr double saturation = WaterBalance::saturation_point;
+  const double clamped = std::clamp(water_content, 0.0, saturation);
+  return params_.saturated_diffusivity *
+         std::exp(-(WaterBalance::hydraulic_slope / saturation) *
+                  (saturation - clamped));
+}
+
+double LateralFlow::SweepRows(const int color, const size_t row_begin,
+                              const size_t row_end, const size_t rows,
+                              const size_t cols, double *x) const {
+  double max_change = 0.0;
+  for (size_t r = row_begin; r < row_end; ++r) {
+    for (size_t c = (r + color) % 2; c < cols; c += 2) {
+      const size_t i = r * cols + c;
+      double sum = previous_[i];
+      if (c > 0) {
+        sum += east_[i - 1] * x[i - 1];
+      }
+      if (c + 1 < cols) {
+        sum += east_[i] * x[i + 1];
+      }
+      if (r > 0) {
+        sum += south_[i - cols] * x[i - cols];
+      }
+      if (r + 1 < rows) {
+        sum += south_[i] * x[i + cols];
+      }
+      const double change = params_.relaxation * (sum / diagonal_[i] - x[i]);
+      x[i] += change;
+      max_change = std::max(max_change, std::abs(change));
+    }
+  }
+  return max_change;
+}
+
+int LateralFlow::SweepBand(const unsigned int band,
+                           const unsigned int num_bands, const size_t rows,
+                           const size_t cols, double *x, Barrier *barrier) {
+  const size_t row_begin = rows * band / num_bands;
+  const size_t row_end = rows * (band + 1) / num_bands;
+  int sweeps = 0;
+  while (sweeps < params_.max_sweeps) {
+    ++sweeps;
+    double change = SweepRows(0, row_begin, row_end, rows, cols, x);
+    if (barrier != nullptr) {
+      barrier->Wait();
+    }
+    change = std::max(change, SweepRows(1, row_begin, row_end, rows, cols, x));
+    if (barrier != nullptr) {
+      // every band reads the changes before any of them writes the next ones,
+      // so that all stop after the same sweep
+      max_changes_[band] = change;
+      barrier->Wait();
+      change = *std::max_element(max_changes_.begin(), max_changes_.end());
+    }
+    if (change <= params_.tolerance) {
+      break;
+    }
+  }
+  return sweeps;
+}
+
+}  // namespace environment
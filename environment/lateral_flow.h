@@ -0,0 +1,99 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_LATERAL_FLOW_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_LATERAL_FLOW_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "environment/coordinate.h"
+#include "environment/soil_container.h"
+
+namespace environment {
+
+struct LateralFlowParameters {
+  // The lateral diffusivity of the water of saturated soil (m^2 day^-1). It
+  // decays exponentially as the soil dries, as the hydraulic conductivity of
+  // the vertical redistribution in `WaterBalance` does.
+  double saturated_diffusivity = 1.0;
+  // The width of a cell (meters).
+  double cell_width = 1.0;
+  // The sweeps stop once none of them changes a water content by more than
+  // this (m^3 m^-3), or after `max_sweeps` of them.
+  double tolerance = 1e-7;
+  int max_sweeps = 200;
+  // The over-relaxation factor of the sweeps, in [1, 2). Plain Gauss-Seidel
+  // converges in a few sweeps over short time steps; larger factors pay off
+  // when a time step spreads water over many cells.
+  double relaxation = 1.0;
+  // The number of threads sweeping the rows, one per core if 0.
+  unsigned int num_threads = 0;
+};
+
+// The subsurface flow of water between neighbouring soil cells, in each layer
+// separately. Water diffuses from wetter to drier cells; the water content
+// after a time step is the solution of the implicit (backward Euler) 5-point
+// stencil, so any time step is stable. It is solved by red-black successive
+// over-relaxation: the cells of one color only depend on the cells of the
+// other, so the rows of a half sweep are updated in parallel. No water flows
+// across the edges of the field, and the total water is kept.
+class LateralFlow {
+ public:
+  explicit LateralFlow(
+      const LateralFlowParameters &params = LateralFlowParameters());
+
+  // Redistributes the water of the layers of `soils` over `days`, appending
+  // the cells which changed by more than the tolerance to `changed_cells`,
+  // once per layer, unless it is null. Only the top layers which all cells
+  // have are redistributed.
+  void Redistribute(const double days, SoilContainer *soils,
+                    std::vector<Coordinate> *changed_cells = nullptr);
+
+  // Redistributes `water_content` (m^3 m^-3) of a grid of `rows` by `cols`
+  // cells, stored row by row, over `days`. Returns the number of sweeps.
+  int Redistribute(const double days, const size_t rows, const size_t cols,
+                   std::vector<double> *water_content);
+
+  const LateralFlowParameters &params() const { return params_; }
+
+ private:
+  class Barrier;
+
+  // Grids smaller than this many cells per thread are swept by fewer threads.
+  static constexpr size_t kMinCellsPerThread = 1 << 14;
+
+  // The diffusivity (m^2 day^-1) at `water_content` (m^3 m^-3).
+  double Diffusivity(const double water_content) const;
+
+  // Updates the cells of `color` in rows [`row_begin`, `row_end`), returning
+  // the largest change.
+  double SweepRows(const int color, const size_t row_begin,
+                   const size_t row_end, const size_t rows, const size_t cols,
+                   double *water_content) const;
+
+  // Sweeps band `band` of `num_bands` bands of rows until the largest change
+  // of a sweep over all bands is within the tolerance, waiting at `barrier`
+  // for the other bands after each half sweep unless it is null. Returns the
+  // number of sweeps.
+  int SweepBand(const unsigned int band, const unsigned int num_bands,
+                const size_t rows, const size_t cols, double *water_content,
+                Barrier *barrier);
+
+  LateralFlowParameters params_;
+
+  // The water content at the beginning of the time step, the coefficients of
+  // the faces to the next cell of the row and of the column, and the diagonal
+  // of the system, by cell. The faces on the edges are 0.
+  std::vector<double> previous_;
+  std::vector<double> east_;
+  std::vector<double> south_;
+  std::vector<double> diagonal_;
+  // The diffusivity of each cell times the time step over its area.
+  std::vector<double> diffusivity_;
+  // The largest change of the last sweep by band.
+  std::vector<double> max_changes_;
+  // One layer of a soil container.
+  std::vector<double> layer_;
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_LATERAL_FLOW_H_
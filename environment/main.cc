@@ -35,6 +35,7 @@ int main() {
       0,
       kBeanTypeName};
   auto action_obj = agent_test.CreateAction(action);
+  env.DeleteAction(action_obj);
 
   // ApplyRandomAction function on envionment
   agent_test.ApplyRandomAction(0, 3);
@@ -0,0 +1,83 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace environment {
+
+#ifndef _WIN32
+
+MappedFile::MappedFile(const std::string &filename)
+    : data_(nullptr), size_(0) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      data_ = static_cast<const char *>(addr);
+      size_ = st.st_size;
+    }
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+}
+
+void MappedFile::AdviseSequential() const {
+  if (data_ != nullptr) {
+    madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+  }
+}
+
+void MappedFile::Prefetch(const size_t offset, const size_t length) const {
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+  // madvise() takes page aligned addresses
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  const size_t begin = offset / page_size * page_size;
+  const size_t end = std::min(size_, offset + length);
+  madvise(const_cast<char *>(data_) + begin, end - begin, MADV_WILLNEED);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &filename)
+    : data_(nullptr), size_(0) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return;
+  }
+  buffer_.resize(file.tellg());
+  file.seekg(0);
+  if (!buffer_.empty() && file.read(buffer_.data(), buffer_.size())) {
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+  }
+}
+
+MappedFile::~MappedFile() {}
+
+void MappedFile::AdviseSequential() const {}
+
+void MappedFile::Prefetch(const size_t offset, const size_t length) const {}
+
+#endif
+
+}  // namespace environment
@@ -0,0 +1,39 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_MAPPED_FILE_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace environment {
+
+// A read-only view of a whole file which is memory-mapped, so that large
+// preprocessed inputs can be used in place without being copied.
+class MappedFile {
+ public:
+  // Maps `filename`. Check `is_open()` to see whether it succeeded.
+  explicit MappedFile(const std::string &filename);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile();
+
+  bool is_open() const { return data_ != nullptr; }
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Hints the kernel that the file will be read from front to back.
+  void AdviseSequential() const;
+  // Hints the kernel to read `length` bytes from `offset` ahead of use.
+  void Prefetch(const size_t offset, const size_t length) const;
+
+ private:
+  const char *data_;
+  size_t size_;
+  // Fallback storage on platforms without `mmap()`.
+  std::vector<char> buffer_;
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_MAPPED_FILE_H_
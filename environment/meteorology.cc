@@ -1,5 +1,6 @@
 #include "meteorology.h"
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 
@@ -17,9 +18,11 @@ Meteorology::Meteorology(
 void Meteorology::Update(
     const std::chrono::system_clock::time_point &local_time,
     const Weather &weather) {
-  time_t tt = std::chrono::system_clock::to_time_t(local_time);
-  struct tm *tm = localtime(&tt);
-  Update(tm->tm_yday + 1, tm->tm_hour, tm->tm_min, tm->tm_sec, weather);
+  // localtime() is not safe to call from environments stepped in parallel
+  const time_t tt = std::chrono::system_clock::to_time_t(local_time);
+  struct tm tm;
+  localtime_r(&tt, &tm);
+  Update(tm.tm_yday + 1, tm.tm_hour, tm.tm_min, tm.tm_sec, weather);
 }
 
 void Meteorology::Update(const int day_of_year, const int local_hour,
@@ -115,12 +118,16 @@ void Meteorology::UpdateWeather(const Weather &weather) {
       local_solar_hour_, weather.air_temperature.min,
       weather.air_temperature.max, solar_hour_sunrise_, solar_hour_sunset_);
 
-  // TODO: We need relative humidity from weather data to fill in this variable.
-  // Declare a variable here just to make this compilable.
-  double relative_humidity;
+  // Update vapor pressure, whose excess over saturation condenses
+  vapor_pressure_.saturated =
+      CalculateVaporPressure(air_temperature_, 100.0).saturated;
+  vapor_pressure_.actual = std::min(
+      CalculateDailyVaporPressure(weather.air_temperature.min,
+                                  weather.air_temperature.max,
+                                  weather.relative_humidity),
+      vapor_pressure_.saturated);
 
-  // Update vapor pressure
-  vapor_pressure_ = CalculateVaporPressure(air_temperature_, relative_humidity);
+  wind_speed_ = weather.wind_speed;
 }
 
 void Meteorology::UpdateHourlyNetRadiation(const Weather &weather) {
@@ -235,7 +242,10 @@ Meteorology::DayLengthAndTimesSunriseSunset Meteorology::CalculateDayLength(
   // tmp = -((sin(δ) * sin(λ)) / (cos(δ) * cos(λ)))
   double tmp = -((sin(solar_declination) * sin(observer_latitude)) /
                  (cos(solar_declination) * cos(observer_latitude)));
-  double t_sunset = kHoursHalfDay + kPiDividedBy12 * acos(tmp);
+  // Beyond the polar circles the sun may not rise (tmp > 1), giving a day of
+  // 0 hours, or not set (tmp < -1), giving one of 24 hours.
+  tmp = std::min(std::max(tmp, -1.0), 1.0);
+  double t_sunset = kHoursHalfDay + (kHoursHalfDay / kPI) * acos(tmp);
 
   // Formula [2.12] in book p.31
   // 12 - t_sr = t_ss - 12
@@ -429,6 +439,17 @@ Meteorology::VaporPressure Meteorology::CalculateVaporPressure(
   return {saturated, actual};
 }
 
+double Meteorology::CalculateDailyVaporPressure(const double temp_min,
+                                                const double temp_max,
+                                                const double relative_humidity) {
+  // Formula [19] of FAO Irrigation and Drainage Paper 56
+  // e_a = RH_mean / 100 * (e_s(T_min) + e_s(T_max)) / 2
+  return relative_humidity *
+         (CalculateVaporPressure(temp_min, 100.0).saturated +
+          CalculateVaporPressure(temp_max, 100.0).saturated) /
+         2.0 / 100.0;
+}
+
 double Meteorology::CalculateAirTemperature(double solar_hour,
                                             const double temp_min,
                                             const double temp_max,
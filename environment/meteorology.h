@@ -35,6 +35,7 @@ namespace environment {
 // Forward declaration
 class EnergyBalanceInfo;
 class PlantRadiation;
+class WeatherGenerator;
 
 // Represents information about the meteorology, such as the Sun, vapor
 // pressure, wind speed, and air temperature.
@@ -75,11 +76,17 @@ class Meteorology {
   const double &hourly_diffuse_irradiance() const {
     return hourly_solar_irradiance_.diffuse;
   }
+  const double &hourly_net_radiation() const { return hourly_net_radiation_; }
   const double &actual_vapor_pressure() const { return vapor_pressure_.actual; }
   const double &saturated_vapor_pressure() const {
     return vapor_pressure_.saturated;
   }
   const double &air_temperature() const { return air_temperature_; }
+  // Relative humidity (percent)
+  double relative_humidity() const {
+    return 100.0 * vapor_pressure_.actual / vapor_pressure_.saturated;
+  }
+  const double &day_length() const { return day_length_; }
 
   double wind_speed() const { return wind_speed_; }
 
@@ -105,6 +112,7 @@ class Meteorology {
  private:
   friend class PlantRadiation;
   friend class EnergyBalance;
+  friend class WeatherGenerator;
 
   struct SolarIrradiance {
     // Total solar irradiance on a horizontal surface
@@ -133,7 +141,7 @@ class Meteorology {
 
   // Information binded to the current geographic location
   const config::Location &geo_location_;
-  const Climate::ZoneType &climate_zone_;
+  const Climate::ZoneType climate_zone_;
 
   // Information about the current date and time
   double day_of_year_;
@@ -191,8 +199,8 @@ class Meteorology {
 
   VaporPressure vapor_pressure_;
 
-  // TODO: In the book, the wind speed is assumed constant. However, we don't
-  // have the data for wind speed. Just leave it blank for now.
+  // The wind speed (m s^-1) is assumed constant over a day in the book, so it
+  // is the daily wind speed of the weather.
   double wind_speed_ = 0.0f;
 
   // Air temperature (°C)
@@ -280,6 +288,14 @@ class Meteorology {
   static VaporPressure CalculateVaporPressure(const double air_temperature,
                                               const double relative_humidity);
 
+  // Returns the actual vapor pressure (mbar) of a day given minimum air
+  // temperature (°C), maximum air temperature (°C), and daily mean relative
+  // humidity (percent). The air is assumed to hold the same vapor all day, so
+  // its relative humidity falls as it warms.
+  static double CalculateDailyVaporPressure(const double temp_min,
+                                            const double temp_max,
+                                            const double relative_humidity);
+
   // Returns air temperature (°C) given solar hour (hours), minimum air
   // temperature (°C), maximum air temperature (°C), solar hour of sunrise
   // (hours), and solar of sunset (hours).
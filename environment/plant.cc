@@ -1,11 +1,48 @@
 #include "plant.h"
 
+#include "environment/species.h"
+
 namespace environment {
 
+Plant::Plant(const SpeciesId species_id, const Meteorology &meteorology,
+             const double trunk_size, const double root_size_,
+             const Species *species)
+    : species_id_(species_id),
+      position_(),
+      trunk_size_(trunk_size),
+      root_size_(root_size_),
+      growth_({kMaxHealth, false, 0.0, 0.0, 0, SEED, 0.0, 0.0, 1.0}),
+      species_(species),
+      species_params_(species != nullptr ? &species->params()
+                                         : &kDefaultParams),
+      overridden_(0),
+      leaf_index_area_(1),
+      plant_radiation_(leaf_index_area_, meteorology) {
+}  // TODO: Set this value for leaf_index_area cleanly
+
 int Plant::Harvest() {
-  int ret = produce_;
-  produce_ = 0;
+  int ret = produce();
+  growth_.produce = 0;
   return ret;
 }
 
-}  // namespace environment
\ No newline at end of file
+Resources Plant::GrowDays(const int64_t num_days,
+                          const GrowthConditions &conditions,
+                          const Resources &available) {
+  GrowthConditions day = conditions;
+  day.air_temperature = (conditions.daily_air_temperature.min +
+                         conditions.daily_air_temperature.max) /
+                        2.0;
+  day.time_step_days = 1.0;
+  return GrowStep(num_days, day, available);
+}
+
+PlantParams Plant::params() const {
+  PlantParams params = *species_params_;
+  for (const auto &kv : overrides_) {
+    params[kv.first] = kv.second;
+  }
+  return params;
+}
+
+}  // namespace environment
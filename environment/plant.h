@@ -1,14 +1,20 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_PLANT_H_
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_PLANT_H_
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "environment/coordinate.h"
 #include "environment/meteorology.h"
 #include "environment/plant_radiation.h"
+#include "environment/resource.h"
 #include "environment/soil.h"
+#include "environment/species_id.h"
+#include "environment/utility.h"
 #include "environment/water_balance.h"
 
 namespace environment {
@@ -34,11 +40,16 @@ enum class PlantProperty {
   NUM_PROPERTIES
 };
 
-// A collection of plant parameters for specializing a plant model.
-using PlantParams = std::unordered_map<PlantProperty, int64_t>;
+// A collection of plant parameters for specializing a plant model, one value
+// for each property.
+using PlantParams =
+    EnumArray<PlantProperty, int64_t, size_t(PlantProperty::NUM_PROPERTIES)>;
+
+// The parameters of a single plant which differ from those of its species.
+using PlantParamOverrides = std::vector<std::pair<PlantProperty, int64_t>>;
 
 // Default parameters for all plants.
-const PlantParams kDefaultParams = {
+inline const PlantParams kDefaultParams = {
     {PlantProperty::GDD_BASE_TEMPERATURE, 20000},         // 20 C.
     {PlantProperty::MIN_ABSOLUTE_TEMPERATURE, 0},         // 0 C.
     {PlantProperty::MAX_ABSOLUTE_TEMPERATURE, 50000},     // 50 C.
@@ -51,6 +62,19 @@ const PlantParams kDefaultParams = {
 };
 
 class PlantBuilder;  // Forward reference.
+class Species;
+
+// The weather plants grow in, the same for all plants of a field.
+struct GrowthConditions {
+  // Air temperature during the time step(s) (°C), for growing by steps.
+  double air_temperature;
+  // Minimum and maximum air temperature of each day (°C), for growing by days.
+  MinMaxTemperature daily_air_temperature;
+  // Day length (hours), compared to the photo period of the plant.
+  double day_length;
+  // The length of one time step (days).
+  double time_step_days;
+};
 
 // Represents a single plant.
 class Plant {
@@ -59,26 +83,73 @@ class Plant {
   enum Maturity { SEED = 0, SEEDLING, JUVENILE, MATURE, OLD };
 
   // The minimum and maximum (unit-less) health values.
-  static const int kMinHealth = 0;   // Corresponds to a dead plant.
-  static const int kMaxHealth = 10;  // Corresponds to maximial growth.
+  static constexpr int kMinHealth = 0;   // Corresponds to a dead plant.
+  static constexpr int kMaxHealth = 10;  // Corresponds to maximial growth.
+
+  // The state of a plant which changes as it grows, kept together so that the
+  // growth kernel of a species only touches this part of its plants.
+  struct GrowthState {
+    // Health of the plant in range [kMinHealth, kMaxHealth].
+    int health;
+
+    // Is the plant currently flowering?
+    bool flowering;
+
+    // The height of this plant (m)
+    double height;
+
+    // The dry matter of the whole plant (g)
+    double biomass;
+
+    // Accumulated Growing Degree Days, in the units of the GDD parameters.
+    // This accumulated value can be reset by the plant model as needed
+    int accumulated_gdd;
+
+    // The plant's current maturity.
+    Maturity maturity;
+
+    // The current total weight of ripen fruit/vegetable/special crop in the
+    // single crop in grams, fractional as it grows by small amounts.
+    double produce;
+
+    // Days spent at a killing temperature since the plant last lost health.
+    double stress_days;
+
+    // The fraction of its potential growth which the water in the soil allows,
+    // in [0, 1]. Set by the environment before the plant grows.
+    double water_factor;
+  };
 
   virtual ~Plant() {}
 
+  // Returns a copy of this plant, of the same model.
+  virtual std::unique_ptr<Plant> Clone() const = 0;
+
   // Harvest this plant. This should return the value of yield.
   int Harvest();
 
-  // TODO: Specify this function more completely and implement in subclasses.
-  // Given the `available` resources, which should include all soil and non-soil
-  // (e.g., light) resources, attempts to perform growing in the specified
-  // number time step(s). Modifies this and returns the resources consumed,
-  // which should be component-wise less than `available`.  Performs no
-  // accounting in the environment; such accounting is the responsibility of the
-  // caller.
-  // TODO: Figure out a way to trigger this function every timestep.
+  // Given the weather in `conditions` and the `available` resources, which
+  // should include all soil and non-soil (e.g., light) resources, attempts to
+  // perform growing in the specified number time step(s). Modifies this and
+  // returns the resources consumed, which should be component-wise less than
+  // `available`.  Performs no accounting in the environment; such accounting is
+  // the responsibility of the caller. Plants of a registered species are grown
+  // by the kernel of their species instead, see Species::GrowBatch.
   virtual Resources GrowStep(const int64_t num_time_step,
+                             const GrowthConditions &conditions,
                              const Resources &available) = 0;
 
-  const std::string &name() const { return name_; }
+  // As GrowStep, but grows `num_days` whole days at once from the daily
+  // minimum and maximum temperature, which is much faster than growing a long
+  // run by hourly steps. By default, grows one day long step per day at the
+  // mean temperature.
+  virtual Resources GrowDays(const int64_t num_days,
+                             const GrowthConditions &conditions,
+                             const Resources &available);
+
+  // The name of the species of this plant.
+  const std::string &name() const { return species_id_.name(); }
+  SpeciesId species_id() const { return species_id_; }
 
   const Coordinate &position() const { return position_; }
 
@@ -90,13 +161,36 @@ class Plant {
   double root_size() const { return root_size_; }
   void set_root_size(const double root_size) { root_size_ = root_size; }
 
-  int health() const { return health_; }
-  bool flowering() const { return flowering_; }
-  double height() const { return height_; }
-  int accumulated_gdd() const { return accumulated_gdd_; }
-  Maturity maturity() const { return maturity_; }
-  int produce() const { return produce_; }
-  const PlantParams &params() const { return params_; }
+  int health() const { return growth_.health; }
+  bool flowering() const { return growth_.flowering; }
+  double height() const { return growth_.height; }
+  double biomass() const { return growth_.biomass; }
+  int accumulated_gdd() const { return growth_.accumulated_gdd; }
+  Maturity maturity() const { return growth_.maturity; }
+  int produce() const { return int(growth_.produce); }
+  const GrowthState &growth_state() const { return growth_; }
+
+  // The species of this plant, or nullptr if it grows on its own.
+  const Species *species() const { return species_; }
+
+  // Returns the parameter `property` of this plant, the one of its species
+  // unless it was overridden.
+  int64_t param(const PlantProperty property) const {
+    if (overridden_ & PropertyBit(property)) {
+      for (const auto &kv : overrides_) {
+        if (kv.first == property) {
+          return kv.second;
+        }
+      }
+    }
+    return (*species_params_)[property];
+  }
+  // The parameters shared by all plants of the species of this plant.
+  const PlantParams &species_params() const { return *species_params_; }
+  // Returns all parameters of this plant, with its overrides.
+  PlantParams params() const;
+  // Whether this plant overrides any parameter of its species.
+  bool has_overrides() const { return overridden_ != 0; }
 
   const PlantRadiation &plant_radiation() const { return plant_radiation_; }
 
@@ -104,37 +198,52 @@ class Plant {
     plant_radiation_.Update(meteorology);
   }
 
+  void UpdateAbsorbedFlux(const double absorbed_flux) {
+    plant_radiation_.UpdateAbsorbedFlux(absorbed_flux);
+  }
+
+  // Sets the fraction of its potential growth which the soil water allows, see
+  // WaterBalance::GrowthReduction.
+  void UpdateWaterFactor(const double water_factor) {
+    growth_.water_factor = water_factor;
+  }
+
  protected:
   // Constructs a generic plant with default values, only for child class use.
-  Plant(const std::string &name, const Meteorology &meteorology,
-        const double trunk_size = 0.0, const double root_size_ = 0.0)
-      : name_(name),
-        position_(),
-        trunk_size_(trunk_size),
-        root_size_(root_size_),
-        health_(kMaxHealth),
-        flowering_(false),
-        accumulated_gdd_(0),
-        maturity_(SEED),
-        produce_(0),
-        params_(kDefaultParams),
-        leaf_index_area_(1),
-        plant_radiation_(leaf_index_area_, meteorology) {
-  }  // TODO: Set this value for leaf_index_area cleanly
-
-  // Overrides internal parameters with the given `params`.
-  void SetParams(const PlantParams &params) {
-    for (const auto &kv : params) {
-      params_[kv.first] = kv.second;
+  // A plant of a registered `species` shares its parameters, otherwise it uses
+  // kDefaultParams.
+  Plant(const SpeciesId species_id, const Meteorology &meteorology,
+        const double trunk_size = 0.0, const double root_size_ = 0.0,
+        const Species *species = nullptr);
+
+  GrowthState *mutable_growth_state() { return &growth_; }
+
+  // Overrides parameters of the species with the given `overrides`.
+  void SetParams(const PlantParamOverrides &overrides) {
+    for (const auto &kv : overrides) {
+      SetParam(kv.first, kv.second);
+    }
+  }
+  void SetParam(const PlantProperty property, const int64_t value) {
+    if (overridden_ & PropertyBit(property)) {
+      for (auto &kv : overrides_) {
+        if (kv.first == property) {
+          kv.second = value;
+          return;
+        }
+      }
     }
+    overrides_.emplace_back(property, value);
+    overridden_ |= PropertyBit(property);
   }
 
  private:
   friend class PlantBuilder;
   friend class PlantContainer;
+  friend class Species;
 
-  // A descriptive string for this plant (e.g., "avocado").
-  std::string name_;
+  // The kind of this plant (e.g., "avocado").
+  SpeciesId species_id_;
 
   Coordinate position_;
 
@@ -143,32 +252,27 @@ class Plant {
   // Root size or canopy size
   double root_size_;
 
-  // Health of the plant in range [kMinHealth, kMaxHealth].
-  int health_;
+  GrowthState growth_;
 
-  // Is the plant currently flowering?
-  bool flowering_;
-
-  // The height of this plant
-  double height_;
-
-  // Accumulated Growing Degree Days.
-  // This accumulated value can be reset by the plant model as needed
-  int accumulated_gdd_;
-
-  // The plant's current maturity.
-  Maturity maturity_;
+  static_assert(size_t(PlantProperty::NUM_PROPERTIES) <= 32,
+                "a bit of `overridden_` is needed for each property");
+  static uint32_t PropertyBit(const PlantProperty property) {
+    return uint32_t(1) << static_cast<int>(property);
+  }
 
-  // The current total weight of ripen fruit/vegetable/special crop in the
-  // single crop in grams.
-  int produce_;
+  // The static parameters of the species of this plant, and those which this
+  // plant overrides, usually none. Each bit of `overridden_` tells whether
+  // `overrides_` has the property, so that other properties are read without
+  // searching.
+  const Species *species_;
+  const PlantParams *species_params_;
+  PlantParamOverrides overrides_;
+  uint32_t overridden_;
 
-  // A collection of static parameters of this plant.
-  PlantParams params_;
+  // declared before `plant_radiation_`, which is initialized from it
+  double leaf_index_area_;
 
   PlantRadiation plant_radiation_;
-
-  double leaf_index_area_;
 };
 
 }  // namespace environment
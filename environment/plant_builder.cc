@@ -7,27 +7,39 @@ namespace environment {
 
 bool PlantBuilder::RegisterPlant(const std::string &model_name,
                                  const PlantGenerator &generator) {
-  if (!models_.count(model_name)) {
-    models_[model_name] = generator;
-    return true;
+  const SpeciesId model = SpeciesId::Intern(model_name);
+  if (!model.valid()) {
+    return false;
   }
-  return false;
+  auto &all = models();
+  if (all.size() <= model.value()) {
+    all.resize(model.value() + 1);
+  }
+  if (all[model.value()]) {
+    return false;
+  }
+  all[model.value()] = generator;
+  return true;
 }
 
-void PlantBuilder::UnregisterPlant(const std::string &model_name) {
-  models_.erase(model_name);
+void PlantBuilder::UnregisterPlant(const SpeciesId model) {
+  auto &all = models();
+  if (model.value() < all.size()) {
+    all[model.value()] = nullptr;
+  }
 }
 
-Plant *PlantBuilder::NewPlant(const std::string &model_name,
+Plant *PlantBuilder::NewPlant(const SpeciesId model,
                               const Meteorology &meteorology) {
-  return NewPlant(model_name, meteorology, PlantParams());
+  return NewPlant(model, meteorology, PlantParamOverrides());
 }
 
-Plant *PlantBuilder::NewPlant(const std::string &model_name,
+Plant *PlantBuilder::NewPlant(const SpeciesId model,
                               const Meteorology &meteorology,
-                              const PlantParams &overrides) {
-  if (models_.count(model_name)) {
-    Plant *p = models_[model_name](meteorology);
+                              const PlantParamOverrides &overrides) {
+  const auto &all = models();
+  if (model.valid() && model.value() < all.size() && all[model.value()]) {
+    Plant *p = all[model.value()](model, meteorology);
     p->SetParams(overrides);
     return p;
   }
@@ -36,16 +48,20 @@ Plant *PlantBuilder::NewPlant(const std::string &model_name,
 
 std::vector<std::string> PlantBuilder::GetPlantList() {
   std::vector<std::string> plant_list;
-  plant_list.reserve(models_.size());
+  const auto &all = models();
 
-  for (const auto &p : models_) {
-    plant_list.push_back(p.first);
+  for (size_t i = 0; i < all.size(); ++i) {
+    if (all[i]) {
+      plant_list.push_back(SpeciesId(i).name());
+    }
   }
 
   return plant_list;
 }
 
-// Definition
-std::unordered_map<std::string, PlantGenerator> PlantBuilder::models_;
+std::vector<PlantGenerator> &PlantBuilder::models() {
+  static std::vector<PlantGenerator> models;
+  return models;
+}
 
 }  // namespace environment
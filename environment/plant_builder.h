@@ -2,37 +2,37 @@
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_PLANT_BUILDER_H_
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "environment/plant.h"
+#include "environment/species_id.h"
 
 namespace environment {
 
-// A generator function for constructing a new plant object.
-using PlantGenerator = std::function<Plant *(const Meteorology &meteorology)>;
+// A generator function for constructing a new plant object of `species_id`.
+using PlantGenerator = std::function<Plant *(const SpeciesId species_id,
+                                             const Meteorology &meteorology)>;
 
 // TODO: Create a public method to show all available plant names.
 // A non-instantiable class to construct plant objects by model/spec.
 class PlantBuilder {
  public:
   // Registers the given plant generation function `generator` under the given
-  // `model_name` if not already registered.  Returns true upon success.
+  // `model_name` if not already registered, interning the name.  Returns true
+  // upon success.
   static bool RegisterPlant(const std::string &model_name,
                             const PlantGenerator &generator);
 
-  // Unregisters the given model name, if present.
-  static void UnregisterPlant(const std::string &model_name);
+  // Unregisters the given model, if present. Its id stays interned.
+  static void UnregisterPlant(const SpeciesId model);
 
   // Constructs and returns a new Plant object using the generator registered
-  // under `model_name` and passes `overrides` to the generator.  If no model is
-  // found or an error occurs, returns nullptr.  Does not retain ownership of
-  // the returned pointer.
-  static Plant *NewPlant(const std::string &model_name,
-                         const Meteorology &meteorology);
-  static Plant *NewPlant(const std::string &model_name,
-                         const Meteorology &meteorology,
-                         const PlantParams &overrides);
+  // under `model` and applies `overrides` to it.  If no model is found or an
+  // error occurs, returns nullptr.  Does not retain ownership of the returned
+  // pointer.
+  static Plant *NewPlant(const SpeciesId model, const Meteorology &meteorology);
+  static Plant *NewPlant(const SpeciesId model, const Meteorology &meteorology,
+                         const PlantParamOverrides &overrides);
 
   // Returns a list of all registered plant model names
   static std::vector<std::string> GetPlantList();
@@ -40,21 +40,23 @@ class PlantBuilder {
  private:
   PlantBuilder() {}
 
-  // Maps from registered plant model name strings to generator functions for
-  // constructing Plant objects of that type.
-  static std::unordered_map<std::string, PlantGenerator> models_;
+  // The generator functions for constructing Plant objects of each registered
+  // model, indexed by its id. Constructed on first use, as models are
+  // registered by static initializers in other translation units.
+  static std::vector<PlantGenerator> &models();
 };
 
-#define DEF_PLANT(_PLANT, _NAME)                                          \
-  class _PLANT##_generator_class {                                        \
-   public:                                                                \
-    _PLANT##_generator_class() {                                          \
-      PlantBuilder::RegisterPlant(                                        \
-          _NAME, PlantGenerator([](const Meteorology &meteorology) {      \
-            return new environment::plants::_PLANT(_NAME, meteorology);   \
-          }));                                                            \
-    }                                                                     \
-    ~_PLANT##_generator_class() { PlantBuilder::UnregisterPlant(_NAME); } \
+#define DEF_PLANT(_PLANT, _NAME)                                              \
+  class _PLANT##_generator_class {                                            \
+   public:                                                                    \
+    _PLANT##_generator_class() {                                              \
+      PlantBuilder::RegisterPlant(                                            \
+          _NAME, PlantGenerator([](const SpeciesId species_id,                \
+                                   const Meteorology &meteorology) {          \
+            return new environment::plants::_PLANT(species_id, meteorology);  \
+          }));                                                                \
+    }                                                                         \
+    ~_PLANT##_generator_class() { PlantBuilder::UnregisterPlant(_NAME); }     \
   };
 
 #define ADD_PLANT(_PLANT, _NAME) \
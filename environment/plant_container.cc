@@ -1,9 +1,46 @@
 #include "plant_container.h"
 
+#include <unordered_map>
+
 #include "environment/plant_builder.h"
 
 namespace environment {
 
+namespace {
+
+void AddResources(const Resources &resources, Resources *sum) {
+  for (size_t i = 0; i < Resources::size(); ++i) {
+    (*sum)[Resources::key(i)] += resources[Resources::key(i)];
+  }
+}
+
+}  // namespace
+
+PlantContainer::PlantContainer(const PlantContainer &other)
+    : plants_(),
+      kdtree_(),
+      canopy_version_(other.canopy_version_),
+      batches_valid_(false) {
+  plants_.reserve(other.plants_.size());
+  for (const auto &plant : other.plants_) {
+    plants_.push_back(plant->Clone());
+  }
+  if (!plants_.empty()) {
+    ConstructPlantKDTree();
+  }
+}
+
+PlantContainer &PlantContainer::operator=(const PlantContainer &other) {
+  if (this != &other) {
+    PlantContainer copy(other);
+    plants_ = std::move(copy.plants_);
+    kdtree_ = std::move(copy.kdtree_);
+    canopy_version_ = copy.canopy_version_;
+    batches_valid_ = false;
+  }
+  return *this;
+}
+
 Plant *PlantContainer::operator[](const Coordinate &coordinate) {
   return GetPlant(coordinate);
 }
@@ -12,11 +49,11 @@ const Plant *PlantContainer::operator[](const Coordinate &coordinate) const {
   return GetPlant(coordinate);
 }
 
-Plant *PlantContainer::AddPlant(const std::string &plant_name,
+Plant *PlantContainer::AddPlant(const SpeciesId plant_type,
                                 const Coordinate &coordinate,
                                 const Meteorology &meteorology) {
   std::unique_ptr<Plant> new_plant(
-      PlantBuilder::NewPlant(plant_name, meteorology));
+      PlantBuilder::NewPlant(plant_type, meteorology));
   if (new_plant == nullptr) {
     return nullptr;
   }
@@ -28,6 +65,8 @@ Plant *PlantContainer::AddPlant(const std::string &plant_name,
 
   plants_.push_back(std::move(new_plant));
   ConstructPlantKDTree();
+  ++canopy_version_;
+  batches_valid_ = false;
   return plants_.back().get();
 }
 
@@ -36,17 +75,71 @@ bool PlantContainer::DelPlant(const Plant &plant) {
 }
 
 bool PlantContainer::DelPlant(const Coordinate &coordinate) {
+  if (plants_.empty()) {
+    return false;
+  }
   point_t position = coordinate.To2DVector();
   size_t index = kdtree_->nearest_index(position);
   if (IsSameLocationIn2D(plants_[index]->position(), coordinate)) {
     plants_.erase(plants_.begin() + index);
     ConstructPlantKDTree();
+    ++canopy_version_;
+    batches_valid_ = false;
     return true;
   }
   return false;
 }
 
+Resources PlantContainer::GrowPlants(const int64_t num_time_step,
+                                     const GrowthConditions &conditions,
+                                     const Resources &available) {
+  if (!batches_valid_) {
+    GroupPlants();
+  }
+
+  Resources consumed;
+  for (const auto &batch : batches_) {
+    AddResources(batch.species->GrowBatch(batch.plants.data(),
+                                          batch.plants.size(), num_time_step,
+                                          conditions, available),
+                 &consumed);
+  }
+  for (Plant *plant : custom_plants_) {
+    AddResources(plant->GrowStep(num_time_step, conditions, available),
+                 &consumed);
+  }
+  return consumed;
+}
+
+Resources PlantContainer::GrowPlantsDays(const int64_t num_days,
+                                         const GrowthConditions &conditions,
+                                         const Resources &available) {
+  if (!batches_valid_) {
+    GroupPlants();
+  }
+
+  Resources consumed;
+  for (const auto &batch : batches_) {
+    AddResources(batch.species->GrowBatchDays(batch.plants.data(),
+                                              batch.plants.size(), num_days,
+                                              conditions, available),
+                 &consumed);
+  }
+  for (Plant *plant : custom_plants_) {
+    AddResources(plant->GrowDays(num_days, conditions, available), &consumed);
+  }
+  return consumed;
+}
+
 Plant *PlantContainer::GetPlant(const Coordinate &coordinate) {
+  return const_cast<Plant *>(
+      static_cast<const PlantContainer *>(this)->GetPlant(coordinate));
+}
+
+const Plant *PlantContainer::GetPlant(const Coordinate &coordinate) const {
+  if (plants_.empty()) {
+    return nullptr;
+  }
   point_t position = coordinate.To2DVector();
   size_t index = kdtree_->nearest_index(position);
   if (index < plants_.size() &&
@@ -56,10 +149,6 @@ Plant *PlantContainer::GetPlant(const Coordinate &coordinate) {
   return nullptr;
 }
 
-const Plant *PlantContainer::GetPlant(const Coordinate &coordinate) const {
-  return GetPlant(coordinate);
-}
-
 PlantContainer::iterator PlantContainer::begin() { return plants_.begin(); }
 PlantContainer::const_iterator PlantContainer::begin() const {
   return plants_.begin();
@@ -103,6 +192,25 @@ bool PlantContainer::CheckPosition(const Coordinate &position,
   return res.empty();
 }
 
+void PlantContainer::GroupPlants() {
+  batches_.clear();
+  custom_plants_.clear();
+  std::unordered_map<const Species *, size_t> batch_index;
+  for (const auto &plant : plants_) {
+    const Species *species = plant->species();
+    if (species == nullptr || plant->has_overrides()) {
+      custom_plants_.push_back(plant.get());
+      continue;
+    }
+    auto it = batch_index.emplace(species, batches_.size()).first;
+    if (it->second == batches_.size()) {
+      batches_.push_back({species, {}});
+    }
+    batches_[it->second].plants.push_back(plant.get());
+  }
+  batches_valid_ = true;
+}
+
 void PlantContainer::ConstructPlantKDTree() {
   pointVec points;
   for (const auto &plant : plants_) {
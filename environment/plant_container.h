@@ -3,11 +3,15 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "KDTree/KDTree.hpp"
 
 #include "environment/coordinate.h"
 #include "environment/plant.h"
+#include "environment/resource.h"
+#include "environment/species.h"
+#include "environment/species_id.h"
 
 namespace environment {
 
@@ -25,7 +29,11 @@ class PlantContainer {
   using value_type = std::unique_ptr<Plant>;
   using size_type = std::vector<std::unique_ptr<Plant>>::size_type;
 
-  PlantContainer() : plants_(), kdtree_(){};
+  PlantContainer()
+      : plants_(), kdtree_(), canopy_version_(0), batches_valid_(false){};
+  // Copies are deep, every plant is cloned.
+  PlantContainer(const PlantContainer &other);
+  PlantContainer &operator=(const PlantContainer &other);
 
   // Fetches a plant pointer specified by the `coordinate` here.
   // Returns `nullptr` if no plant is found.
@@ -33,7 +41,7 @@ class PlantContainer {
   const Plant *operator[](const Coordinate &coordinate) const;
 
   // The returned pointer belongs to this class. The caller should not free it.
-  Plant *AddPlant(const std::string &plant_name, const Coordinate &coordinate,
+  Plant *AddPlant(const SpeciesId plant_type, const Coordinate &coordinate,
                   const Meteorology &meteorology);
   bool DelPlant(const Plant &plant);
   bool DelPlant(const Coordinate &coordinate);
@@ -42,6 +50,20 @@ class PlantContainer {
   Plant *GetPlant(const Coordinate &coordinate);
   const Plant *GetPlant(const Coordinate &coordinate) const;
 
+  // Increases whenever a plant is added or deleted, so that users of the canopy
+  // geometry can tell whether it has changed since they last looked at it.
+  uint64_t canopy_version() const { return canopy_version_; }
+
+  // Grows every plant by `num_time_step` step(s), those of a species with one
+  // call of its kernel per species, and returns the resources consumed.
+  Resources GrowPlants(const int64_t num_time_step,
+                       const GrowthConditions &conditions,
+                       const Resources &available);
+  // The same for `num_days` whole days, see Plant::GrowDays.
+  Resources GrowPlantsDays(const int64_t num_days,
+                           const GrowthConditions &conditions,
+                           const Resources &available);
+
   // capacity
   size_type size() const { return plants_.size(); }
   bool empty() const { return plants_.empty(); }
@@ -64,9 +86,24 @@ class PlantContainer {
  private:
   bool CheckPosition(const Coordinate &position, const double size);
   void ConstructPlantKDTree();
+  // Sorts the plants into `batches_` and `custom_plants_`.
+  void GroupPlants();
+
+  // The plants of a species which are grown by its kernel.
+  struct SpeciesBatch {
+    const Species *species;
+    std::vector<Plant *> plants;
+  };
 
   std::vector<std::unique_ptr<Plant>> plants_;
   std::unique_ptr<KDTree> kdtree_;
+  uint64_t canopy_version_;
+
+  // Regrouped on the next growth after plants are added or deleted. Plants
+  // without a species, or which override its parameters, grow one by one.
+  std::vector<SpeciesBatch> batches_;
+  std::vector<Plant *> custom_plants_;
+  bool batches_valid_;
 };
 
 }  // namespace environment
@@ -9,7 +9,8 @@ PlantRadiation::PlantRadiation(const double leaf_index_area,
     : meteorology_(meteorology),
       total_leaf_area_index_(leaf_index_area),
       kExtinctionCoefficientForDiffuse(
-          CalculateExtinctionCoefficientForDiffuse()) {
+          CalculateExtinctionCoefficientForDiffuse()),
+      absorbed_flux_(0.0) {
   // Update (Initialize) this class with the given `meteorology`.
   Update(meteorology_);
 }
@@ -28,6 +28,7 @@ class PlantRadiation {
   void Update(const int day_of_year, const double solar_hour);
 
   // TODO: add accessors for other classes to use
+  double leaf_area_index() const { return total_leaf_area_index_; }
   double total_flux_density_shaded() const {
     return total_flux_density_shaded_;
   };
@@ -35,7 +36,15 @@ class PlantRadiation {
     return total_flux_density_sunlit_;
   };
 
+  // Records the radiant flux absorbed by the whole plant (W), which is traced
+  // by the photon simulator.
+  void UpdateAbsorbedFlux(const double absorbed_flux) {
+    absorbed_flux_ = absorbed_flux;
+  }
+  double absorbed_flux() const { return absorbed_flux_; }
+
  private:
+  friend class CellEnergyBalance;
   friend class EnergyBalance;
 
   // Solar radiation intercepted by the canopies
@@ -101,6 +110,10 @@ class PlantRadiation {
   // This is denoted as I_sh or Q_sh in the book.
   double total_flux_density_shaded_;
 
+  // The radiant flux absorbed by the whole plant (W) as traced by the photon
+  // simulator. It stays 0 if no photon simulator is running.
+  double absorbed_flux_;
+
   // Only updates information about the current solar hour in this class
   // according to the provided `meteorology`.
   void UpdateSolarHour(const Meteorology &meteorology);
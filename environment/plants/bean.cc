@@ -2,9 +2,29 @@
 
 #include "environment/plant.h"
 #include "environment/plant_builder.h"
+#include "environment/species.h"
 
 namespace environment {
 
+namespace plants {
+
+const PlantParams kBeanParams = {
+    {PlantProperty::GDD_BASE_TEMPERATURE, 10000},        // 10 C.
+    {PlantProperty::MIN_ABSOLUTE_TEMPERATURE, -2000},    // -2 C.
+    {PlantProperty::MAX_ABSOLUTE_TEMPERATURE, 40000},    // 40 C.
+    {PlantProperty::MIN_NEW_GROWTH_TEMPERATURE, 0},      // 0 C.
+    {PlantProperty::MAX_NEW_GROWTH_TEMPERATURE, 35000},  // 35 C.
+    {PlantProperty::MIN_PHOTO_PERIOD, 0},                // 0 s.
+    {PlantProperty::MAX_PHOTO_PERIOD, 86400},            // 24 hours.
+    {PlantProperty::MAX_HARVEST_YIELD, 50},              // 50 g.
+    {PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM, 500000}  // 500 degree-days.
+};
+
+}  // namespace plants
+
+using plants::BeanModel;
+
+ADD_SPECIES(BeanModel, "bean", plants::kBeanParams);
 ADD_PLANT(Bean, "bean");
 
 }  // namespace environment
@@ -1,24 +1,61 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_PLANTS_BEAN_H_
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_PLANTS_BEAN_H_
 
+#include <memory>
 #include <string>
 
+#include "environment/gdd_growth_model.h"
 #include "environment/plant.h"
+#include "environment/species.h"
 #include "environment/utility.h"
 
 namespace environment {
 
 namespace plants {
 
+// The traits of common beans for their growth model.
+struct BeanTraits {
+  static constexpr double kGddToFullBloom = 600.0;
+  static constexpr double kMaxHeight = 0.5;
+  static constexpr double kBiomassPerGdd = 0.1;
+};
+
+// The growth model of beans, grown by the kernel of their species, see
+// ModelSpecies.
+using BeanModel = GddGrowthModel<BeanTraits>;
+
+// The parameters of the bean species.
+extern const PlantParams kBeanParams;
+
 class Bean : public Plant {
  public:
-  Bean(const std::string &name, const Meteorology &meteorology)
-      : Plant(name, meteorology) {}
+  Bean(const SpeciesId species_id, const Meteorology &meteorology)
+      : Plant(species_id, meteorology, 0.0, 0.0,
+              SpeciesRegistry::GetSpecies(species_id)) {}
 
-  // TODO: Fill in.
+  std::unique_ptr<Plant> Clone() const override {
+    return std::make_unique<Bean>(*this);
+  }
+
+  // Grows this bean alone, as for beans which override parameters of their
+  // species.
   virtual Resources GrowStep(const int64_t num_time_step,
+                             const GrowthConditions &conditions,
+                             const Resources &available) override {
+    Resources consumed;
+    BeanModel::Grow(BeanModel::MakeParams(params()), mutable_growth_state(),
+                    num_time_step, conditions, available, &consumed);
+    return consumed;
+  }
+
+  virtual Resources GrowDays(const int64_t num_days,
+                             const GrowthConditions &conditions,
                              const Resources &available) override {
-    return Resources();
+    Resources consumed;
+    BeanModel::GrowDays(BeanModel::MakeParams(params()),
+                        mutable_growth_state(), num_days, conditions,
+                        available, &consumed);
+    return consumed;
   }
 };
 
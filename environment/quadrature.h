@@ -0,0 +1,102 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_QUADRATURE_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_QUADRATURE_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace environment {
+
+// Options of IntegrateGaussLegendre. The defaults integrate a smooth daily
+// curve, such as a heat flux over the hours of daylight, to about 0.1% in 15
+// evaluations, and never take more than 155.
+struct QuadratureOptions {
+  // An interval is accepted when the estimates of it as a whole and as two
+  // halves differ by at most this fraction of the latter, in every component.
+  double relative_tolerance = 1e-3;
+  // ... or by at most this much, for components which integrate to about 0.
+  double absolute_tolerance = 1e-9;
+  // The number of times an interval may be halved.
+  int max_depth = 3;
+};
+
+namespace internal {
+
+// Nodes on [-1, 1] and weights of the 5-point Gauss-Legendre rule, which is
+// exact for polynomials up to degree 9.
+constexpr size_t kGaussLegendrePoints = 5;
+constexpr double kGaussLegendreNodes[kGaussLegendrePoints] = {
+    -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831,
+    0.9061798459386640};
+constexpr double kGaussLegendreWeights[kGaussLegendrePoints] = {
+    0.2369268850561891, 0.4786286704993665, 0.5688888888888889,
+    0.4786286704993665, 0.2369268850561891};
+
+template <size_t N, typename F>
+std::array<double, N> GaussLegendre(const F &f, const double a,
+                                    const double b) {
+  const double half_width = (b - a) / 2.0;
+  const double center = (a + b) / 2.0;
+  std::array<double, N> sum = {};
+  for (size_t i = 0; i < kGaussLegendrePoints; ++i) {
+    const std::array<double, N> value =
+        f(center + half_width * kGaussLegendreNodes[i]);
+    for (size_t j = 0; j < N; ++j) {
+      sum[j] += kGaussLegendreWeights[i] * value[j];
+    }
+  }
+  for (size_t j = 0; j < N; ++j) {
+    sum[j] *= half_width;
+  }
+  return sum;
+}
+
+template <size_t N, typename F>
+std::array<double, N> AdaptiveGaussLegendre(
+    const F &f, const double a, const double b,
+    const std::array<double, N> &whole, const QuadratureOptions &options,
+    const int depth) {
+  const double middle = (a + b) / 2.0;
+  const std::array<double, N> left = GaussLegendre<N>(f, a, middle);
+  const std::array<double, N> right = GaussLegendre<N>(f, middle, b);
+  std::array<double, N> halves;
+  bool converged = true;
+  for (size_t j = 0; j < N; ++j) {
+    halves[j] = left[j] + right[j];
+    converged = converged &&
+                std::abs(halves[j] - whole[j]) <=
+                    std::max(options.relative_tolerance * std::abs(halves[j]),
+                             options.absolute_tolerance);
+  }
+  if (converged || depth >= options.max_depth) {
+    return halves;
+  }
+  const std::array<double, N> left_sum =
+      AdaptiveGaussLegendre<N>(f, a, middle, left, options, depth + 1);
+  const std::array<double, N> right_sum =
+      AdaptiveGaussLegendre<N>(f, middle, b, right, options, depth + 1);
+  for (size_t j = 0; j < N; ++j) {
+    halves[j] = left_sum[j] + right_sum[j];
+  }
+  return halves;
+}
+
+}  // namespace internal
+
+// Returns the integral of `f` from `a` to `b`, where `f(x)` returns
+// `std::array<double, N>`, so that several quantities computed together are
+// integrated by the same evaluations. Intervals are split in halves where the
+// 5-point Gauss-Legendre rule has not converged yet, so smooth integrands take
+// few evaluations and only the rough parts are refined.
+template <size_t N, typename F>
+std::array<double, N> IntegrateGaussLegendre(
+    const F &f, const double a, const double b,
+    const QuadratureOptions &options = QuadratureOptions()) {
+  return internal::AdaptiveGaussLegendre<N>(
+      f, a, b, internal::GaussLegendre<N>(f, a, b), options, 0);
+}
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_QUADRATURE_H_
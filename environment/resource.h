@@ -1,7 +1,10 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_RESOURCE_H_
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_RESOURCE_H_
 
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+#include "environment/utility.h"
 
 // Ralph: This used to be in utility.h. Because of the need of
 // putting `ResourceType` in the namespace environment, I moved it here.
@@ -14,12 +17,14 @@ enum class ResourceType {
   POTASSIUM,
   CALCIUM,
   MAGNESIUM,
-  SULFUR
+  SULFUR,
+  NUM_RESOURCES
 };
 
-// TODO: Document this Resources map based upon the right units for the value
+// TODO: Document these Resources based upon the right units for the value
 // type.
-using Resources = std::unordered_map<ResourceType, int64_t>;
+using Resources =
+    EnumArray<ResourceType, int64_t, size_t(ResourceType::NUM_RESOURCES)>;
 
 }  // namespace environment
 
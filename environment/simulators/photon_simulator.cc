@@ -2,6 +2,8 @@
 
 #include "environment/environment.h"
 #include "environment/meteorology.h"
+#include "environment/plant.h"
+#include "photons/tracing/photon_tracer.h"
 
 // extend third party library
 namespace _462 {
@@ -18,43 +20,56 @@ namespace simulator {
 namespace photonsimulator {
 
 PhotonSimulator::PhotonSimulator(const int number, const _462::real_t distance,
-                                 const _462::real_t height)
-    : num_of_photons_near_by_(number),
+                                 const _462::real_t height,
+                                 const std::string &asset_dir)
+    : asset_dir_(asset_dir),
+      num_of_photons_near_by_(number),
       max_distance_(distance),
       sun_height_(height),
-      kdtree_(nullptr) {}
+      photon_power_(0.0),
+      scene_env_id_(0),
+      scene_canopy_version_(0) {}
 
 void PhotonSimulator::SimulateToTime(
     environment::Environment *env,
     const std::chrono::system_clock::time_point &time) {
   // the part for model
-  FreeModels();
   LoadModels(env);
 
   // the part for photon
+  alive_photons_.clear();
+  absorb_photons_.clear();
+
+  // Move the sun to the given time.
+  environment::Meteorology meteorology(env->meteorology());
+  meteorology.Update(time, env->weather());
+
+  // No photon reaches the plants while the sun is below the horizon.
+  if (meteorology.solar_elevation() <= 0.0) {
+    photon_power_ = 0.0;
+    WriteResultToEnv(env);
+    return;
+  }
+
   /**
    * TODO: check terrain orientation
    * we regard north as y asix
    */
-  // TODO: Since the sun info may not be correct, we may need to fix this.
-  _462::Vector3 sun_dir(-sin(env->meteorology().solar_azimuth()),
-                        -cos(env->meteorology().solar_azimuth()),
-                        -cos(env->meteorology().solar_inclination()));
-  _462::Vector3 sun_strength(env->meteorology().hourly_total_irradiance(),
-                             env->meteorology().hourly_total_irradiance(),
-                             env->meteorology().hourly_total_irradiance());
-  double latitude_diff = (env->config().location.latitude_top -
-                          env->config().location.latitude_bottom) /
-                         100.0f;
-  double longtitude_diff = (env->config().location.longitude_right -
-                            env->config().location.longitude_left) /
-                           100.0f;
-  alive_photons_.clear();
-  absorb_photons_.clear();
-  PhotonEmit(sun_dir, sun_strength, env->config().location.latitude_bottom,
-             env->config().location.latitude_top, latitude_diff,
-             env->config().location.longitude_left,
-             env->config().location.longitude_right, longtitude_diff);
+  _462::Vector3 sun_dir = _462::normalize(
+      _462::Vector3(-sin(meteorology.solar_azimuth()),
+                    -cos(meteorology.solar_azimuth()),
+                    -cos(meteorology.solar_inclination())));
+  _462::Vector3 sun_strength(meteorology.hourly_total_irradiance(),
+                             meteorology.hourly_total_irradiance(),
+                             meteorology.hourly_total_irradiance());
+
+  // Photons are emitted from the center of each patch of a grid covering the
+  // terrain, so each of them carries the flux falling on its patch.
+  const double terrain_size = env->terrain().size();
+  const double step = terrain_size / kPhotonsPerSide;
+  photon_power_ = meteorology.hourly_total_irradiance() * step * step;
+  PhotonEmit(sun_dir, sun_strength, step / 2.0, terrain_size, step,
+             step / 2.0, terrain_size, step);
 
   PhotonsModify();
 
@@ -65,40 +80,107 @@ void PhotonSimulator::SimulateToTime(
 
 void PhotonSimulator::FreeModels() {
   models_.clear();
+  model_plants_.clear();
+  model_files_.clear();
+  scene_env_id_ = 0;
+}
+
+void PhotonSimulator::LoadModels(environment::Environment *env) {
+  auto &plant_container = env->mutable_terrain().plant_container();
+  if (scene_env_id_ != env->id() ||
+      scene_canopy_version_ != plant_container.canopy_version()) {
+    FreeModels();
+    for (auto &plant : plant_container) {
+      const char *file = PlantModelFile(plant->name(), plant->maturity());
+      // a species without a model is not in the scene and absorbs nothing
+      if (file == nullptr) {
+        continue;
+      }
+      const environment::Coordinate &position = plant->position();
+      models_.emplace_back(GeometryCache::Get(asset_dir_ + file),
+                           _462::Vector3(position.x, position.y, position.z));
+      model_plants_.push_back(plant.get());
+      model_files_.push_back(file);
+    }
+    scene_env_id_ = env->id();
+    scene_canopy_version_ = plant_container.canopy_version();
+    return;
+  }
+
+  // The canopy is unchanged, so only the plants which have grown into another
+  // stage need to instance another geometry.
+  for (size_t i = 0; i < models_.size(); ++i) {
+    const environment::Plant *plant = model_plants_[i];
+    const char *file = PlantModelFile(plant->name(), plant->maturity());
+    if (file != model_files_[i]) {
+      const environment::Coordinate &position = plant->position();
+      models_[i] =
+          Model(GeometryCache::Get(asset_dir_ + file),
+                _462::Vector3(position.x, position.y, position.z));
+      model_files_[i] = file;
+    }
+    models_[i].ResetPhotons();
+  }
 }
 
-// TODO: implement these two functions after refining class plant
-void PhotonSimulator::LoadModels(environment::Environment *env) {}
-void PhotonSimulator::WriteResultToEnv(environment::Environment *env) {}
+void PhotonSimulator::WriteResultToEnv(environment::Environment *env) {
+  for (size_t i = 0; i < models_.size(); ++i) {
+    model_plants_[i]->UpdateAbsorbedFlux(models_[i].GetPhotons() *
+                                         photon_power_);
+  }
+}
+
+const char *PhotonSimulator::PlantModelFile(const std::string &plant_name,
+                                            const int maturity) {
+  // the models of the seedling, the juvenile and the mature plant
+  const char *const *files;
+  static const char *const kCornFiles[] = {filepath::corn1, filepath::corn2,
+                                           filepath::corn3};
+  static const char *const kSquashFiles[] = {
+      filepath::squash1, filepath::squash2, filepath::squash3};
+  if (plant_name == "corn") {
+    files = kCornFiles;
+  } else if (plant_name == "bean" || plant_name == "squash") {
+    files = kSquashFiles;
+  } else {
+    return nullptr;
+  }
+
+  if (maturity <= environment::Plant::SEEDLING) {
+    return files[0];
+  } else if (maturity == environment::Plant::JUVENILE) {
+    return files[1];
+  }
+  return files[2];
+}
 
 void PhotonSimulator::PhotonEmit(
     const _462::Vector3 &sun_direction, const _462::Vector3 &sun_strength,
     const double latitude_bottom, const double latitude_top,
     const double latitudeDiff, const double longitude_left,
     const double longitude_right, const double longitudeDiff) {
-  for (_462::real_t i = (_462::real_t)latitude_bottom;
-       i <= (_462::real_t)latitude_top; i += (_462::real_t)latitudeDiff) {
-    for (_462::real_t j = (_462::real_t)longitude_left;
-         j <= (_462::real_t)longitude_right; j += (_462::real_t)longitudeDiff) {
-      alive_photons_.push_back(Photon(
-          sun_direction, _462::Vector3(i, j, sun_height_), sun_strength));
-    }
-  }
+  tracing::EmitGrid<_462::real_t>(
+      latitude_bottom, latitude_top, latitudeDiff, longitude_left,
+      longitude_right, longitudeDiff,
+      [&](const _462::real_t i, const _462::real_t j) {
+        // Photons are emitted at `sun_height_` along the sun direction so
+        // that they would land on the grid point (i, j) on the ground.
+        _462::Vector3 ground(i, j, 0.0);
+        alive_photons_.push_back(
+            Photon(sun_direction,
+                   ground - sun_direction * (sun_height_ / -sun_direction.z),
+                   sun_strength));
+      });
 }
 
-void PhotonSimulator::ConstructKDTree(std::vector<Photon> &p) {
-  pointVec points;
-  for (const auto photon : p) {
-    point_t pt = {photon.pos.x, photon.pos.y, photon.pos.z};
-    points.push_back(pt);
-  }
-  kdtree_ = kdtree_ = std::make_shared<KDTree>(points);
+void PhotonSimulator::ConstructPhotonMap(const std::vector<Photon> &p) {
+  photon_map_.BuildFrom(p);
 }
 
-indexArr PhotonSimulator::LookuptKDTree(const _462::Vector3 &point,
-                                        const _462::real_t distance) const {
-  point_t pt = {point.x, point.y, point.z};
-  return kdtree_->neighborhood_indices(pt, distance);
+void PhotonSimulator::LookupPhotonMap(const _462::Vector3 &point,
+                                      const _462::real_t distance) {
+  const float p[3] = {(float)point.x, (float)point.y, (float)point.z};
+  photon_map_.FindInRadius(p, distance, &nearby_photons_);
 }
 
 _462::Vector3 PhotonSimulator::GetPixelColor(const _462::Vector3 &ray_pos,
@@ -106,7 +188,7 @@ _462::Vector3 PhotonSimulator::GetPixelColor(const _462::Vector3 &ray_pos,
   _462::Vector3 direct, global;
   const Face *min_face = nullptr;
   const Mesh *min_mesh = nullptr;
-  const Model *min_model = nullptr;
+  Model *min_model = nullptr;
   std::tie(min_model, min_mesh, min_face) =
       FindFirstIntersect(ray_pos, ray_dir);
   _462::Vector3 result;
@@ -116,9 +198,9 @@ _462::Vector3 PhotonSimulator::GetPixelColor(const _462::Vector3 &ray_pos,
     direct = min_model->GetFaceTextureColor(*min_face, *min_mesh, intersect);
 
     global = _462::Vector3(0.0, 0.0, 0.0);
-    auto res = LookuptKDTree(intersect, 0.025);
+    LookupPhotonMap(intersect, 0.025);
     int count = 0;
-    for (const auto index : res) {
+    for (const auto index : nearby_photons_) {
       _462::real_t dist = _462::distance(absorb_photons_[index].pos, intersect);
       _462::Vector3 color = absorb_photons_[index].power;
       if (dist >= 1.0f) {
@@ -173,29 +255,19 @@ _462::Vector3 PhotonSimulator::GetRayDir(const int x, const int y,
   return t;
 }
 
-PhotonSimulator::RadianceResult PhotonSimulator::RussianRoulette(
-    const _462::real_t abr, const _462::real_t ref,
-    const _462::real_t trans) const {
-  _462::real_t a = (rand() % 100) / 100.0f;
-  if (a < abr)
-    return RadianceResult::kAbsorb;
-  else if (a < abr + ref)
-    return RadianceResult::kReflect;
-  else
-    return RadianceResult::kRefract;
-}
-
-std::tuple<Model *, Mesh *, Face *> PhotonSimulator::FindFirstIntersect(
-    const _462::Vector3 &pos, const _462::Vector3 &dir) {
-  Face *min_face = nullptr;
-  Mesh *min_mesh = nullptr;
+std::tuple<Model *, const Mesh *, const Face *>
+PhotonSimulator::FindFirstIntersect(const _462::Vector3 &pos,
+                                    const _462::Vector3 &dir) {
+  const Face *min_face = nullptr;
+  const Mesh *min_mesh = nullptr;
   Model *min_model = nullptr;
   _462::real_t min_distance = std::numeric_limits<double>::max();
   for (auto &model : models_) {
-    Face *face = nullptr;
-    Mesh *mesh = nullptr;
+    const Face *face = nullptr;
+    const Mesh *mesh = nullptr;
     _462::real_t distance = model.FindFirstIntersect(&face, &mesh, pos, dir);
     if (distance < min_distance) {
+      min_distance = distance;
       min_face = face;
       min_mesh = mesh;
       min_model = &model;
@@ -205,71 +277,37 @@ std::tuple<Model *, Mesh *, Face *> PhotonSimulator::FindFirstIntersect(
 }
 
 void PhotonSimulator::PhotonsModify() {
-  while (!alive_photons_.empty()) {
-    for (int i = 0; i < alive_photons_.size(); i++) {
-      Face *min_face = nullptr;
-      Mesh *min_mesh = nullptr;
-      Model *min_model = nullptr;
-      std::tie(min_model, min_mesh, min_face) =
-          FindFirstIntersect(alive_photons_[i].pos, alive_photons_[i].dir);
-      if (min_face != nullptr) {
-        _462::Vector3 intersect = min_model->GetIntersect(
-            *min_face, alive_photons_[i].pos, alive_photons_[i].dir);
-        RadianceResult res = RussianRoulette(min_face->material.aborption,
-                                             min_face->material.reflection,
-                                             min_face->material.transmision);
-        switch (res) {
-          case RadianceResult::kAbsorb: {
-            absorb_photons_.push_back(
-                Photon(min_face->normal, intersect, alive_photons_[i].power));
-            alive_photons_.erase(alive_photons_.begin() + i--);
-            min_face->photons++;
-            break;
-          }
-          case RadianceResult::kReflect: {
-            _462::Vector3 ref =
-                GetReflect(alive_photons_[i].dir, min_face->normal);
-            alive_photons_[i].pos = intersect;
-            alive_photons_[i].dir = ref;
-            break;
-          }
-          case RadianceResult::kRefract: {
-            _462::Vector3 ref =
-                GetRefract(alive_photons_[i].dir, min_face->normal, 1.0);
-            alive_photons_[i].pos = intersect;
-            alive_photons_[i].dir = ref;
-            break;
-          }
-          default:
-            std::cout << "Error result!" << std::endl;
-        }
-      } else {
-        alive_photons_.erase(alive_photons_.begin() + i--);
-      }
+  Model *hit_model = nullptr;
+  const auto find_hit = [&](const Photon &photon,
+                            tracing::Hit<_462::Vector3> *hit) {
+    const Face *face = nullptr;
+    const Mesh *mesh = nullptr;
+    std::tie(hit_model, mesh, face) =
+        FindFirstIntersect(photon.pos, photon.dir);
+    if (face == nullptr) {
+      return false;
     }
+    hit->point = hit_model->GetIntersect(*face, photon.pos, photon.dir);
+    hit->normal = face->normal;
+    hit->absorption = face->material.aborption;
+    hit->reflection = face->material.reflection;
+    return true;
+  };
+  const auto absorb = [&](const Photon &photon,
+                          const tracing::Hit<_462::Vector3> &hit) {
+    absorb_photons_.push_back(Photon(hit.normal, hit.point, photon.power));
+    hit_model->AddPhoton();
+  };
+  const auto uniform = []() { return (rand() % 100) / 100.0; };
+  for (auto &photon : alive_photons_) {
+    tracing::TracePhoton<_462::Vector3>(&photon, find_hit, absorb, uniform);
   }
+  alive_photons_.clear();
   if (is_rendering_) {
-    ConstructKDTree(absorb_photons_);
+    ConstructPhotonMap(absorb_photons_);
   }
 }
 
-_462::Vector3 PhotonSimulator::GetReflect(const _462::Vector3 &dir,
-                                          const _462::Vector3 &norm) const {
-  _462::Vector3 normal = normalize(norm);
-  return (dir - 2 * _462::Hadamard((_462::Hadamard(dir, normal)), normal));
-}
-
-_462::Vector3 PhotonSimulator::GetRefract(const _462::Vector3 &dir,
-                                          const _462::Vector3 &norm,
-                                          _462::real_t coef) const {
-  return _462::Vector3(
-      -sqrt(1 - coef * coef *
-                    (1 - _462::squared_length(_462::Hadamard(dir, norm)) *
-                             _462::squared_length(_462::Hadamard(dir, norm)))) *
-          norm +
-      coef * (dir + _462::squared_length(_462::Hadamard(dir, norm)) * norm));
-}
-
 }  // namespace photonsimulator
 
 }  // namespace simulator
@@ -1,44 +1,64 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTON_SIMULATOR_H_
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTON_SIMULATOR_H_
 
+#include <string>
 #include <tuple>
 #include <vector>
 
-#include "KDTree/KDTree.hpp"
-
 #include "photons/model/model.h"
 #include "photons/photon/photon.h"
 #include "photons/photon_simulator_config.h"
+#include "photons/tracing/photon_map.h"
 #include "simulator.h"
 
+// forward declaration to avoid circular dependency
+namespace environment {
+class Plant;
+}
+
 namespace simulator {
 
 namespace photonsimulator {
 
 class PhotonSimulator : public Simulator {
  public:
+  // `asset_dir` is the directory in which the 3D models of plants are stored.
   PhotonSimulator(const int number, const _462::real_t distance,
-                  const _462::real_t height);
+                  const _462::real_t height,
+                  const std::string &asset_dir = filepath::defaultpath);
   void SimulateToTime(
       environment::Environment *env,
       const std::chrono::system_clock::time_point &time) override;
 
  private:
-  // common
-  enum class RadianceResult { kAbsorb = 0, kReflect, kRefract };
-
   // TODO: add interface if necessary
   bool is_rendering_ = false;
 
   // the part for model
+  const std::string asset_dir_;
+  // Each plant in the scene is an instance of the geometry of its type and
+  // growth stage placed at its position.
   std::vector<Model> models_;
+  // The plant which each model in `models_` represents, and the 3d-obj file
+  // the model instances.
+  std::vector<environment::Plant *> model_plants_;
+  std::vector<const char *> model_files_;
+  // The id of the environment and the version of its canopy which `models_`
+  // is built from. Not its address, which a later environment may reuse.
+  uint64_t scene_env_id_;
+  uint64_t scene_canopy_version_;
 
   // the part for photon
   const int num_of_photons_near_by_;
   const _462::real_t max_distance_;
   const _462::real_t sun_height_;
   std::vector<Photon> alive_photons_, absorb_photons_;
-  std::shared_ptr<KDTree> kdtree_;
+  // The radiant flux carried by a single emitted photon (W).
+  _462::real_t photon_power_;
+  // index over `absorb_photons_`, built for rendering
+  tracing::PhotonMap photon_map_;
+  // reused by the lookups in `photon_map_` to avoid allocating per pixel
+  std::vector<uint32_t> nearby_photons_;
 
   // emit all photons to the space by specific parameters
   /***
@@ -55,17 +75,11 @@ class PhotonSimulator : public Simulator {
   // let all photons transmit in the space
   void PhotonsModify();
 
-  // this function is used to randomize the result of one photon, the parameters
-  // are three posibilities
-  RadianceResult RussianRoulette(const _462::real_t abr, const _462::real_t ref,
-                                 const _462::real_t tran) const;
-
-  void ConstructKDTree(std::vector<Photon> &p);
+  void ConstructPhotonMap(const std::vector<Photon> &p);
 
-  // heap is the min-heap returned by the function, distance is the max_distance
-  // for the nearest photon for the special point
-  indexArr LookuptKDTree(const _462::Vector3 &point,
-                         const _462::real_t distance) const;
+  // fills `nearby_photons_` with the indices of the absorbed photons within
+  // `distance` of `point`
+  void LookupPhotonMap(const _462::Vector3 &point, const _462::real_t distance);
 
   // return the pixel RGB value
   _462::Vector3 GetPixelColor(const _462::Vector3 &ray_pos,
@@ -86,27 +100,25 @@ class PhotonSimulator : public Simulator {
                             const _462::Vector3 &camera_ctr,
                             const _462::Vector3 &camera_up);
 
-  // get the reflect direction of the input dir and the normal
-  _462::Vector3 GetReflect(const _462::Vector3 &dir,
-                           const _462::Vector3 &norm) const;
-
-  // get the refract direction of the input dir and the normal
-  _462::Vector3 GetRefract(const _462::Vector3 &dir, const _462::Vector3 &norm,
-                           _462::real_t coef) const;
-
   // this function will return the Model, Mesh, and Face that is first hitted by
   // certain ray identified by pos and dir
-  std::tuple<Model *, Mesh *, Face *> FindFirstIntersect(
+  std::tuple<Model *, const Mesh *, const Face *> FindFirstIntersect(
       const _462::Vector3 &pos, const _462::Vector3 &dir);
 
-  // write result to environment
+  // write the flux absorbed by each plant back to the environment
   void WriteResultToEnv(environment::Environment *env);
 
-  // free 3d-obj model from memory
+  // free the instances of 3d-obj models in the current scene
   void FreeModels();
 
-  // load 3d-obj model from disk
+  // update the scene to the plants in the environment, it is only rebuilt if
+  // the canopy has changed since the last call
   void LoadModels(environment::Environment *env);
+
+  // returns the file name of the 3d-obj model for the plant type and stage,
+  // nullptr if the type has no model
+  static const char *PlantModelFile(const std::string &plant_name,
+                                    const int maturity);
 };
 
 }  // namespace photonsimulator
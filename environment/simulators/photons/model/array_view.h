@@ -0,0 +1,44 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_ARRAY_VIEW_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_ARRAY_VIEW_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// A read-only view of a contiguous array which is owned elsewhere, e.g. by a
+// `std::vector` or a memory-mapped file.
+template <typename T>
+class ArrayView {
+ public:
+  using const_iterator = const T *;
+
+  ArrayView() : data_(nullptr), size_(0) {}
+  ArrayView(const T *data, const size_t size) : data_(data), size_(size) {}
+  ArrayView(const std::vector<T> &v) : data_(v.data()), size_(v.size()) {}
+
+  const T &operator[](const size_t i) const {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  const T *data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+ private:
+  const T *data_;
+  size_t size_;
+};
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_ARRAY_VIEW_H_
@@ -0,0 +1,77 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_BINARY_MESH_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_BINARY_MESH_H_
+
+#include <cstdint>
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// The layout of preprocessed binary mesh files (`.mesh`), which are written by
+// `tools/mesh_converter` from 3d-obj files. A file is a `Header` followed by
+// sections of plain arrays, which are used in place after the file is mapped
+// into memory. The arrays use the in-memory layout of the machine which wrote
+// them, so the header records the sizes needed to detect a mismatch.
+namespace binarymesh {
+
+const char kMagic[8] = "AGROMSH";
+const uint32_t kVersion = 1;
+// every section starts at a multiple of this
+const uint64_t kAlignment = 16;
+const char kExtension[] = ".mesh";
+
+struct Section {
+  uint64_t offset;  // in bytes from the beginning of the file
+  uint64_t count;   // number of elements
+};
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t real_size;  // sizeof(_462::real_t)
+  uint32_t face_size;  // sizeof(Face)
+  uint32_t node_size;  // sizeof(BvhNode)
+
+  Section vertices;          // _462::Vector3
+  Section normals;           // _462::Vector3
+  Section texcoords;         // _462::Vector2
+  Section faces;             // Face
+  Section meshes;            // MeshRecord
+  Section materials;         // MaterialRecord
+  Section textures;          // TextureRecord
+  Section texels;            // unsigned char, RGB
+  Section bvh_nodes;         // BvhNode
+  Section bvh_face_indices;  // uint32_t
+};
+
+// A range of faces sharing a material and a texture.
+struct MeshRecord {
+  uint32_t first_face;
+  uint32_t num_faces;
+  uint32_t material_id;
+  int32_t texture_id;  // -1 if there is no texture
+};
+
+// The part of a 3d-obj material used for rendering.
+struct MaterialRecord {
+  float ambient[3];
+  float diffuse[3];
+  float specular[3];
+  float shininess;
+};
+
+// A texture decoded into RGB, its texels start at `first_texel`.
+struct TextureRecord {
+  int32_t w, h;
+  int32_t comp;
+  uint32_t reserved;
+  uint64_t first_texel;
+};
+
+}  // namespace binarymesh
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_BINARY_MESH_H_
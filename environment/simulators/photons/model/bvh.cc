@@ -0,0 +1,167 @@
+#include "bvh.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+namespace photonsimulator {
+
+namespace bvh {
+
+namespace {
+
+struct Bounds {
+  _462::real_t min[3];
+  _462::real_t max[3];
+
+  Bounds() {
+    for (int axis = 0; axis < 3; ++axis) {
+      min[axis] = std::numeric_limits<_462::real_t>::infinity();
+      max[axis] = -std::numeric_limits<_462::real_t>::infinity();
+    }
+  }
+
+  void Extend(const _462::Vector3 &p) {
+    const _462::real_t v[3] = {p.x, p.y, p.z};
+    for (int axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], v[axis]);
+      max[axis] = std::max(max[axis], v[axis]);
+    }
+  }
+
+  int LongestAxis() const {
+    int longest = 0;
+    for (int axis = 1; axis < 3; ++axis) {
+      if (max[axis] - min[axis] > max[longest] - min[longest]) {
+        longest = axis;
+      }
+    }
+    return longest;
+  }
+};
+
+// Builds the subtree over `face_indices[begin, end)` and returns its index.
+uint32_t BuildNode(const ArrayView<_462::Vector3> &vertices,
+                   const ArrayView<Face> &faces,
+                   const std::vector<_462::Vector3> &centroids,
+                   const uint32_t begin, const uint32_t end,
+                   std::vector<BvhNode> *nodes,
+                   std::vector<uint32_t> *face_indices) {
+  Bounds bounds, centroid_bounds;
+  for (uint32_t i = begin; i < end; ++i) {
+    const Face &face = faces[(*face_indices)[i]];
+    bounds.Extend(vertices[face.vertex1.vertex_index]);
+    bounds.Extend(vertices[face.vertex2.vertex_index]);
+    bounds.Extend(vertices[face.vertex3.vertex_index]);
+    centroid_bounds.Extend(centroids[(*face_indices)[i]]);
+  }
+
+  const uint32_t index = nodes->size();
+  nodes->emplace_back();
+  for (int axis = 0; axis < 3; ++axis) {
+    (*nodes)[index].bounds_min[axis] = bounds.min[axis];
+    (*nodes)[index].bounds_max[axis] = bounds.max[axis];
+  }
+
+  const int axis = centroid_bounds.LongestAxis();
+  if (end - begin <= kMaxLeafSize ||
+      centroid_bounds.max[axis] <= centroid_bounds.min[axis]) {
+    (*nodes)[index].first = begin;
+    (*nodes)[index].count = end - begin;
+    return index;
+  }
+
+  // split at the median centroid along the longest axis
+  const uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(
+      face_indices->begin() + begin, face_indices->begin() + mid,
+      face_indices->begin() + end, [&](const uint32_t a, const uint32_t b) {
+        const _462::real_t ca[3] = {centroids[a].x, centroids[a].y,
+                                    centroids[a].z};
+        const _462::real_t cb[3] = {centroids[b].x, centroids[b].y,
+                                    centroids[b].z};
+        return ca[axis] < cb[axis];
+      });
+
+  BuildNode(vertices, faces, centroids, begin, mid, nodes, face_indices);
+  const uint32_t right =
+      BuildNode(vertices, faces, centroids, mid, end, nodes, face_indices);
+  (*nodes)[index].first = right;
+  (*nodes)[index].count = 0;
+  return index;
+}
+
+}  // namespace
+
+void Build(const ArrayView<_462::Vector3> &vertices,
+           const ArrayView<Face> &faces, std::vector<BvhNode> *nodes,
+           std::vector<uint32_t> *face_indices) {
+  nodes->clear();
+  face_indices->clear();
+  if (faces.empty()) {
+    return;
+  }
+
+  std::vector<_462::Vector3> centroids;
+  centroids.reserve(faces.size());
+  for (const auto &face : faces) {
+    centroids.push_back((vertices[face.vertex1.vertex_index] +
+                         vertices[face.vertex2.vertex_index] +
+                         vertices[face.vertex3.vertex_index]) /
+                        3.0);
+    face_indices->push_back(face_indices->size());
+  }
+
+  nodes->reserve(2 * faces.size() / kMaxLeafSize + 1);
+  BuildNode(vertices, faces, centroids, 0, faces.size(), nodes, face_indices);
+}
+
+bool IsValid(const ArrayView<BvhNode> &nodes,
+             const ArrayView<uint32_t> &face_indices, const size_t num_faces) {
+  for (const uint32_t face_index : face_indices) {
+    if (face_index >= num_faces) {
+      return false;
+    }
+  }
+  if (nodes.empty()) {
+    return true;
+  }
+
+  // the nodes to visit with their depths
+  std::vector<std::pair<uint32_t, int>> stack = {{0, 0}};
+  std::vector<bool> reached(nodes.size(), false);
+  size_t num_reached = 0;
+  while (!stack.empty()) {
+    const auto [index, depth] = stack.back();
+    stack.pop_back();
+    if (reached[index] || depth > kMaxDepth) {
+      return false;
+    }
+    reached[index] = true;
+    ++num_reached;
+
+    const BvhNode &node = nodes[index];
+    if (node.is_leaf()) {
+      if (node.first + (uint64_t)node.count > face_indices.size()) {
+        return false;
+      }
+      continue;
+    }
+    const uint64_t left = index + (uint64_t)1;
+    if (left >= nodes.size() || node.first <= index ||
+        node.first >= nodes.size()) {
+      return false;
+    }
+    stack.emplace_back(left, depth + 1);
+    stack.emplace_back(node.first, depth + 1);
+  }
+  return num_reached == nodes.size();
+}
+
+}  // namespace bvh
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
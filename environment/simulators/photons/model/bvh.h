@@ -0,0 +1,126 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_BVH_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_BVH_H_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Optimized-Photon-Mapping/src/math/vector.hpp"
+
+#include "array_view.h"
+#include "face.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// A node of a bounding volume hierarchy stored in a flat array. The left child
+// of an inner node directly follows it, and `first` is its right child. A leaf
+// covers `count` faces listed from `first` in the face index array.
+struct BvhNode {
+  _462::real_t bounds_min[3];
+  _462::real_t bounds_max[3];
+  uint32_t first;
+  uint32_t count;  // 0 for inner nodes
+
+  bool is_leaf() const { return count > 0; }
+};
+
+// A bounding volume hierarchy over the faces of a geometry, used to find the
+// faces hit by a ray without testing all of them.
+namespace bvh {
+
+// maximum number of faces in a leaf
+const uint32_t kMaxLeafSize = 4;
+// maximum depth of a hierarchy, the root being at depth 0; the depth of a
+// balanced hierarchy over 2^32 faces is at most 63
+const int kMaxDepth = 63;
+
+// Builds the hierarchy of `faces` into `nodes` and `face_indices`.
+void Build(const ArrayView<_462::Vector3> &vertices,
+           const ArrayView<Face> &faces, std::vector<BvhNode> *nodes,
+           std::vector<uint32_t> *face_indices);
+
+// Returns whether `nodes` and `face_indices` form a hierarchy as `Build` lays
+// it out over `num_faces` faces: each node is reached once from the root, the
+// children of a node come after it, no branch is deeper than `kMaxDepth`, and
+// the leaves refer to faces within range. `Traverse` relies on this.
+bool IsValid(const ArrayView<BvhNode> &nodes,
+             const ArrayView<uint32_t> &face_indices, const size_t num_faces);
+
+// Returns the distance along `dir` at which the ray enters the box of `node`,
+// or infinity if it misses the box. `inv_dir` is 1 / `dir` component-wise.
+inline _462::real_t IntersectBox(const BvhNode &node,
+                                 const _462::Vector3 &origin,
+                                 const _462::Vector3 &inv_dir) {
+  const _462::real_t o[3] = {origin.x, origin.y, origin.z};
+  const _462::real_t inv[3] = {inv_dir.x, inv_dir.y, inv_dir.z};
+  _462::real_t t_min = 0.0;
+  _462::real_t t_max = std::numeric_limits<_462::real_t>::infinity();
+  for (int axis = 0; axis < 3; ++axis) {
+    _462::real_t t0 = (node.bounds_min[axis] - o[axis]) * inv[axis];
+    _462::real_t t1 = (node.bounds_max[axis] - o[axis]) * inv[axis];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    t_min = t0 > t_min ? t0 : t_min;
+    t_max = t1 < t_max ? t1 : t_max;
+    if (t_min > t_max) {
+      return std::numeric_limits<_462::real_t>::infinity();
+    }
+  }
+  return t_min;
+}
+
+// Visits the faces whose boxes are hit by the ray, nearer boxes first.
+// `visit(face_index)` returns the distance of the nearest hit found so far, so
+// boxes further than it are skipped.
+template <typename Visitor>
+void Traverse(const ArrayView<BvhNode> &nodes,
+              const ArrayView<uint32_t> &face_indices,
+              const _462::Vector3 &origin, const _462::Vector3 &dir,
+              Visitor visit) {
+  if (nodes.empty()) {
+    return;
+  }
+
+  const _462::Vector3 inv_dir(1.0 / dir.x, 1.0 / dir.y, 1.0 / dir.z);
+  _462::real_t nearest = std::numeric_limits<_462::real_t>::infinity();
+  // holds at most one node per level
+  uint32_t stack[kMaxDepth + 1];
+  int top = 0;
+  if (IntersectBox(nodes[0], origin, inv_dir) < nearest) {
+    stack[top++] = 0;
+  }
+
+  while (top > 0) {
+    const BvhNode &node = nodes[stack[--top]];
+    if (node.is_leaf()) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        nearest = visit(face_indices[i]);
+      }
+      continue;
+    }
+
+    const uint32_t left = &node - nodes.data() + 1;
+    const uint32_t right = node.first;
+    const _462::real_t t_left = IntersectBox(nodes[left], origin, inv_dir);
+    const _462::real_t t_right = IntersectBox(nodes[right], origin, inv_dir);
+    // push the further child first so that the nearer one is visited first
+    if (t_left <= t_right) {
+      if (t_right < nearest) stack[top++] = right;
+      if (t_left < nearest) stack[top++] = left;
+    } else {
+      if (t_left < nearest) stack[top++] = left;
+      if (t_right < nearest) stack[top++] = right;
+    }
+  }
+}
+
+}  // namespace bvh
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_BVH_H_
@@ -10,8 +10,8 @@ namespace simulator {
 namespace photonsimulator {
 
 _462::Vector2 GetTexcoord(const Face &face, const _462::Vector3 &pos,
-                          const std::vector<_462::Vector3> &vertices,
-                          const std::vector<_462::Vector2> &texcoords) {
+                          const ArrayView<_462::Vector3> &vertices,
+                          const ArrayView<_462::Vector2> &texcoords) {
   _462::Vector3 vertex12, vertex13, vertex1p;
   _462::real_t k12, k13;
   _462::Vector2 texcoord;
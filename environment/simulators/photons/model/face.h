@@ -5,6 +5,7 @@
 
 #include "Optimized-Photon-Mapping/src/math/vector.hpp"
 
+#include "array_view.h"
 #include "material.h"
 
 namespace simulator {
@@ -17,13 +18,13 @@ struct Vertex {
       : vertex_index(vertex_index),
         normal_index(normal_index),
         texcoord_index(texcoord_index) {}
-  ~Vertex() {}
 
   int vertex_index;
   int normal_index;
   int texcoord_index;
 };
 
+// Faces are plain data, so that they can be mapped from binary mesh files.
 struct Face {
   Face() = delete;
   Face(const Vertex &v1, const Vertex &v2, const Vertex &v3,
@@ -31,7 +32,6 @@ struct Face {
       : vertex1(v1),
         vertex2(v2),
         vertex3(v3),
-        photons(0),
         material_id_(material_id_),
         material(),
         normal(normal){};
@@ -45,15 +45,12 @@ struct Face {
    */
   int material_id_;
   Material material;  // TODO: how to import material info
-
-  // count of photons
-  size_t photons;
 };
 
 // given point on face, return its texture coordinate
 _462::Vector2 GetTexcoord(const Face &face, const _462::Vector3 &pos,
-                          const std::vector<_462::Vector3> &vertices_,
-                          const std::vector<_462::Vector2> &texcoords_);
+                          const ArrayView<_462::Vector3> &vertices_,
+                          const ArrayView<_462::Vector2> &texcoords_);
 
 }  // namespace photonsimulator
 
@@ -0,0 +1,752 @@
+#include "geometry.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+#ifndef STBI_INCLUDE_STB_IMAGE_H
+#define STB_IMAGE_IMPLEMENTATION
+#include "tinyobjloader/examples/viewer/stb_image.h"
+#endif
+
+#include "Optimized-Photon-Mapping/src/math/math.hpp"
+#include "Optimized-Photon-Mapping/src/math/vector.hpp"
+
+#include "environment/simulators/photons/photon_simulator_config.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+const char PathSeparator =
+#if defined _WIN32 || defined __CYGWIN__
+    '\\';
+#else
+    '/';
+#endif
+
+// auxiliary functions
+static bool FileExists(const std::string &abs_filename);
+static bool IsUpToDate(const std::string &binary_filename,
+                       const std::string &filename);
+static std::string GetBaseDir(const std::string &filepath);
+static bool HasSmoothingGroup(const tinyobj::shape_t &shape);
+// Ralph: Should parameters be changed to `Vector3`s? or are there existed
+// functions in library for this?
+// wym: I add following function, but I would suggest that do not modify the
+// code.
+static _462::Vector3 CalcNormal(const _462::Vector3 &v0,
+                                const _462::Vector3 &v1,
+                                const _462::Vector3 &v2);
+static void CalcNormal(float N[3], float v0[3], float v1[3], float v2[3]);
+static void ComputeSmoothingNormals(
+    const tinyobj::attrib_t &attrib, const tinyobj::shape_t &shape,
+    std::map<int, _462::Vector3> &smooth_vertex_normals);
+
+Texture::Texture(const int texture_id, const int w, const int h,
+                 const int comp, const unsigned char *image)
+    : texture_id(texture_id),
+      w(w),
+      h(h),
+      comp(comp),
+      storage_(image, image + w * h * kNumOfChannels) {
+  buffer = storage_;
+}
+
+Texture::Texture(const int texture_id, const int w, const int h,
+                 const int comp, const ArrayView<unsigned char> &image)
+    : texture_id(texture_id), buffer(image), w(w), h(h), comp(comp) {}
+
+std::mutex GeometryCache::mutex_;
+std::map<std::string, std::shared_ptr<Geometry>> GeometryCache::cache_;
+
+std::shared_ptr<Geometry> GeometryCache::Get(const std::string &filename) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(filename);
+  if (it == cache_.end()) {
+    std::string binary_filename =
+        filename.substr(0, filename.find_last_of('.')) + binarymesh::kExtension;
+    if (!IsUpToDate(binary_filename, filename)) {
+      binary_filename = filename;
+    }
+    auto geometry = std::make_shared<Geometry>(binary_filename.c_str());
+    if (!geometry->is_loaded()) {
+      std::cerr << filename << " is loaded instead" << std::endl;
+      geometry = std::make_shared<Geometry>(filename.c_str());
+    }
+    it = cache_.emplace(filename, geometry).first;
+  }
+  return it->second;
+}
+
+void GeometryCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+Geometry::Geometry(const char *filename) : loaded_(true) {
+  const std::string name(filename);
+  const std::string extension(binarymesh::kExtension);
+  if (name.size() >= extension.size() &&
+      name.compare(name.size() - extension.size(), extension.size(),
+                   extension) == 0) {
+    if (!LoadBinaryMesh(filename)) {
+      std::cerr << "Unable to load binary mesh: " << filename << std::endl;
+      // empty rather than half loaded
+      loaded_ = false;
+      vertices_ = normals_ = ArrayView<_462::Vector3>();
+      texcoords_ = ArrayView<_462::Vector2>();
+      faces_ = ArrayView<Face>();
+      bvh_nodes_ = ArrayView<BvhNode>();
+      bvh_face_indices_ = ArrayView<uint32_t>();
+      meshes_.clear();
+      materials_.clear();
+      texture_infos_.clear();
+      mapped_file_.reset();
+    }
+  } else {
+    LoadObjModel(filename);
+  }
+}
+
+size_t Geometry::GetTotalFaces() const { return faces_.size(); }
+
+const Mesh &Geometry::GetMeshOfFace(const uint32_t face_index) const {
+  assert(!meshes_.empty());
+  // the last mesh whose first face is not after `face_index`
+  auto it = std::upper_bound(meshes_.begin(), meshes_.end(), face_index,
+                             [](const uint32_t index, const Mesh &mesh) {
+                               return index < mesh.first_face();
+                             });
+  return *std::prev(it);
+}
+
+void Geometry::SetMeshes(const ArrayView<binarymesh::MeshRecord> &records) {
+  meshes_.clear();
+  meshes_.reserve(records.size());
+  for (const auto &record : records) {
+    meshes_.emplace_back(
+        ArrayView<Face>(faces_.data() + record.first_face, record.num_faces),
+        record.first_face, record.material_id, record.texture_id);
+  }
+}
+
+// Sets `view` to the `section` of the mapped file `data`. Returns false if the
+// section does not lie within the file or is misaligned.
+template <typename T>
+static bool GetSection(const char *data, const size_t size,
+                       const binarymesh::Section &section, ArrayView<T> *view) {
+  if (section.offset % alignof(T) != 0 || section.offset > size ||
+      section.count > (size - section.offset) / sizeof(T)) {
+    return false;
+  }
+  *view = ArrayView<T>(reinterpret_cast<const T *>(data + section.offset),
+                       section.count);
+  return true;
+}
+
+bool Geometry::LoadBinaryMesh(const char *filename) {
+  mapped_file_.reset(new environment::MappedFile(filename));
+  if (!mapped_file_->is_open() ||
+      mapped_file_->size() < sizeof(binarymesh::Header)) {
+    return false;
+  }
+  mapped_file_->AdviseSequential();
+
+  const char *data = mapped_file_->data();
+  const size_t size = mapped_file_->size();
+  binarymesh::Header header;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, binarymesh::kMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != binarymesh::kVersion) {
+    std::cerr << filename << " is not a binary mesh of version "
+              << binarymesh::kVersion << std::endl;
+    return false;
+  }
+  // The arrays are used in place, so they must have been written with the
+  // same layout.
+  if (header.real_size != sizeof(_462::real_t) ||
+      header.face_size != sizeof(Face) || header.node_size != sizeof(BvhNode)) {
+    std::cerr << filename << " was written on an incompatible platform"
+              << std::endl;
+    return false;
+  }
+
+  ArrayView<binarymesh::MeshRecord> mesh_records;
+  ArrayView<binarymesh::MaterialRecord> material_records;
+  ArrayView<binarymesh::TextureRecord> texture_records;
+  ArrayView<unsigned char> texels;
+  if (!GetSection(data, size, header.vertices, &vertices_) ||
+      !GetSection(data, size, header.normals, &normals_) ||
+      !GetSection(data, size, header.texcoords, &texcoords_) ||
+      !GetSection(data, size, header.faces, &faces_) ||
+      !GetSection(data, size, header.meshes, &mesh_records) ||
+      !GetSection(data, size, header.materials, &material_records) ||
+      !GetSection(data, size, header.textures, &texture_records) ||
+      !GetSection(data, size, header.texels, &texels) ||
+      !GetSection(data, size, header.bvh_nodes, &bvh_nodes_) ||
+      !GetSection(data, size, header.bvh_face_indices, &bvh_face_indices_)) {
+    std::cerr << filename << " is truncated" << std::endl;
+    return false;
+  }
+
+  // The indices in the arrays are used unchecked when tracing, so a file
+  // referring outside of its sections is rejected. Every vertex has a normal,
+  // the loader of 3d-obj files falls back to the normal of the face.
+  auto is_valid_vertex = [this](const Vertex &vertex) {
+    return vertex.vertex_index >= 0 &&
+           (uint64_t)vertex.vertex_index < vertices_.size() &&
+           vertex.normal_index >= 0 &&
+           vertex.normal_index < (int64_t)normals_.size() &&
+           vertex.texcoord_index >= -1 &&
+           vertex.texcoord_index < (int64_t)texcoords_.size();
+  };
+  for (const Face &face : faces_) {
+    if (!is_valid_vertex(face.vertex1) || !is_valid_vertex(face.vertex2) ||
+        !is_valid_vertex(face.vertex3)) {
+      std::cerr << filename << " has an invalid face" << std::endl;
+      return false;
+    }
+  }
+  if (!bvh::IsValid(bvh_nodes_, bvh_face_indices_, faces_.size())) {
+    std::cerr << filename << " has an invalid bounding volume hierarchy"
+              << std::endl;
+    return false;
+  }
+
+  // The meshes are looked up by their first faces, so they have to cover the
+  // faces in order.
+  if (!faces_.empty() &&
+      (mesh_records.empty() || mesh_records[0].first_face != 0)) {
+    std::cerr << filename << " has faces without a mesh" << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < mesh_records.size(); ++i) {
+    const binarymesh::MeshRecord &record = mesh_records[i];
+    if (record.first_face + (uint64_t)record.num_faces > faces_.size() ||
+        (i > 0 && record.first_face < mesh_records[i - 1].first_face) ||
+        record.material_id >= material_records.size() ||
+        record.texture_id < -1 ||
+        record.texture_id >= (int64_t)texture_records.size()) {
+      std::cerr << filename << " has an invalid mesh" << std::endl;
+      return false;
+    }
+  }
+  SetMeshes(mesh_records);
+
+  for (const auto &record : material_records) {
+    tinyobj::material_t material;
+    for (int i = 0; i < 3; ++i) {
+      material.ambient[i] = record.ambient[i];
+      material.diffuse[i] = record.diffuse[i];
+      material.specular[i] = record.specular[i];
+    }
+    material.shininess = record.shininess;
+    materials_.push_back(material);
+  }
+
+  for (const auto &record : texture_records) {
+    const uint64_t num_texels = (uint64_t)record.w * record.h * kNumOfChannels;
+    if (record.w < 0 || record.h < 0 || record.first_texel > texels.size() ||
+        num_texels > texels.size() - record.first_texel) {
+      std::cerr << filename << " has an invalid texture" << std::endl;
+      return false;
+    }
+    texture_infos_.emplace_back(
+        texture_infos_.size(), record.w, record.h, record.comp,
+        ArrayView<unsigned char>(texels.data() + record.first_texel,
+                                 num_texels));
+  }
+
+  return true;
+}
+
+namespace {
+
+// Appends `count` elements of `array` to `out` as a section starting at the
+// next multiple of `binarymesh::kAlignment`.
+template <typename T>
+binarymesh::Section AppendSection(const T *array, const size_t count,
+                                  std::vector<char> *out) {
+  out->resize((out->size() + binarymesh::kAlignment - 1) /
+              binarymesh::kAlignment * binarymesh::kAlignment);
+  binarymesh::Section section;
+  section.offset = out->size();
+  section.count = count;
+  const char *bytes = reinterpret_cast<const char *>(array);
+  out->insert(out->end(), bytes, bytes + count * sizeof(T));
+  return section;
+}
+
+template <typename T>
+binarymesh::Section AppendSection(const ArrayView<T> &array,
+                                  std::vector<char> *out) {
+  return AppendSection(array.data(), array.size(), out);
+}
+
+template <typename T>
+binarymesh::Section AppendSection(const std::vector<T> &array,
+                                  std::vector<char> *out) {
+  return AppendSection(array.data(), array.size(), out);
+}
+
+}  // namespace
+
+bool Geometry::WriteBinaryMesh(const std::string &filename) const {
+  std::vector<binarymesh::MeshRecord> mesh_records;
+  for (const auto &mesh : meshes_) {
+    binarymesh::MeshRecord record;
+    record.first_face = mesh.first_face();
+    record.num_faces = mesh.faces().size();
+    record.material_id = mesh.material_id();
+    record.texture_id = mesh.texture_id();
+    mesh_records.push_back(record);
+  }
+
+  std::vector<binarymesh::MaterialRecord> material_records;
+  for (const auto &material : materials_) {
+    binarymesh::MaterialRecord record;
+    for (int i = 0; i < 3; ++i) {
+      record.ambient[i] = material.ambient[i];
+      record.diffuse[i] = material.diffuse[i];
+      record.specular[i] = material.specular[i];
+    }
+    record.shininess = material.shininess;
+    material_records.push_back(record);
+  }
+
+  std::vector<binarymesh::TextureRecord> texture_records;
+  std::vector<unsigned char> texels;
+  for (const auto &texture : texture_infos_) {
+    binarymesh::TextureRecord record;
+    record.w = texture.w;
+    record.h = texture.h;
+    record.comp = texture.comp;
+    record.reserved = 0;
+    record.first_texel = texels.size();
+    texels.insert(texels.end(), texture.buffer.begin(), texture.buffer.end());
+    texture_records.push_back(record);
+  }
+
+  binarymesh::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, binarymesh::kMagic, sizeof(header.magic));
+  header.version = binarymesh::kVersion;
+  header.real_size = sizeof(_462::real_t);
+  header.face_size = sizeof(Face);
+  header.node_size = sizeof(BvhNode);
+
+  std::vector<char> out(sizeof(header));
+  header.vertices = AppendSection(vertices_, &out);
+  header.normals = AppendSection(normals_, &out);
+  header.texcoords = AppendSection(texcoords_, &out);
+  header.faces = AppendSection(faces_, &out);
+  header.meshes = AppendSection(mesh_records, &out);
+  header.materials = AppendSection(material_records, &out);
+  header.textures = AppendSection(texture_records, &out);
+  header.texels = AppendSection(texels, &out);
+  header.bvh_nodes = AppendSection(bvh_nodes_, &out);
+  header.bvh_face_indices = AppendSection(bvh_face_indices_, &out);
+  std::memcpy(out.data(), &header, sizeof(header));
+
+  FILE *fp = fopen(filename.c_str(), "wb");
+  if (!fp) {
+    return false;
+  }
+  const bool ret = fwrite(out.data(), 1, out.size(), fp) == out.size();
+  return fclose(fp) == 0 && ret;
+}
+
+// Ralph: This function looks way too long. Refactor it.
+// wym: this function is not written by us, and I don't know the source
+// (@Hangjie),the function is highly modified compared to the origin version.
+void Geometry::LoadObjModel(const char *filename) {
+  tinyobj::attrib_t attrib;
+  std::vector<tinyobj::shape_t> shapes;
+
+  // I/O operation
+  {
+    std::string base_dir = GetBaseDir(filename);
+    std::string warn;
+    std::string err;
+    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials_, &warn, &err,
+                                filename, base_dir.c_str());
+    if (!warn.empty()) {
+      std::cout << "WARN: " << warn << std::endl;
+    }
+    // Ralph: If error occurs, should it continue to run?
+    // wym: I think so. cerr does not stop the program.
+    if (!err.empty()) {
+      std::cerr << err << std::endl;
+    }
+    // Append `default` material
+    materials_.push_back(tinyobj::material_t());
+
+    // Load diffuse textures
+    {
+      for (size_t m = 0; m < materials_.size(); m++) {
+        const tinyobj::material_t &mp = materials_[m];
+
+        if (mp.diffuse_texname.length() > 0) {
+          // Only load the texture if it is not already loaded
+          if (textures_.find(mp.diffuse_texname) == textures_.end()) {
+            int w, h;
+            int comp;
+
+            std::string texture_filename = mp.diffuse_texname;
+            if (!FileExists(texture_filename)) {
+              // Append base dir.
+              texture_filename = base_dir + mp.diffuse_texname;
+              if (!FileExists(texture_filename)) {
+                std::cerr << "Unable to find file: " << mp.diffuse_texname
+                          << std::endl;
+                exit(1);
+              }
+            }
+
+            // Textures are decoded into RGB buffers on the CPU, uploading
+            // them to OpenGL is left to `ModelRenderer`.
+            unsigned char *image = stbi_load(texture_filename.c_str(), &w, &h,
+                                             &comp, kNumOfChannels);
+            if (!image) {
+              std::cerr << "Unable to load texture: " << texture_filename
+                        << std::endl;
+              exit(1);
+            }
+            std::cout << "Loaded texture: " << texture_filename << ", w = " << w
+                      << ", h = " << h << ", comp = " << comp << std::endl;
+
+            const int texture_id = texture_infos_.size();
+            texture_infos_.emplace_back(texture_id, w, h, comp, image);
+            stbi_image_free(image);
+            textures_.insert(std::make_pair(mp.diffuse_texname, texture_id));
+          }
+        }
+      }
+    }
+  }
+
+  // Convert tiny_obj_loader format
+  for (auto it = attrib.vertices.begin(); it != attrib.vertices.end(); it += 3)
+    storage_.vertices.push_back(_462::Vector3((_462::real_t)*it,
+                                      (_462::real_t)*std::next(it),
+                                      (_462::real_t)*std::next(it, 2)));
+  for (auto it = attrib.normals.begin(); it != attrib.normals.end(); it += 3)
+    storage_.normals.push_back(_462::Vector3((_462::real_t)*it,
+                                             (_462::real_t)*std::next(it),
+                                             (_462::real_t)*std::next(it, 2)));
+  // flip y texture coordinate
+  for (auto it = attrib.texcoords.begin(); it != attrib.texcoords.end();
+       it += 2)
+    storage_.texcoords.push_back(
+        _462::Vector2((_462::real_t)*it, (_462::real_t)*std::next(it)));
+
+  // Load mesh
+  for (size_t s = 0; s < shapes.size(); s++) {
+    binarymesh::MeshRecord mesh;
+    mesh.first_face = storage_.faces.size();
+    mesh.texture_id = -1;
+
+    // Check for smoothing group and compute smoothing normals
+    std::map<int, _462::Vector3> smooth_vertex_normals;
+    if (HasSmoothingGroup(shapes[s])) {
+      std::cout << "Compute smoothingNormal for shape [" << s << "]"
+                << std::endl;
+      ComputeSmoothingNormals(attrib, shapes[s], smooth_vertex_normals);
+    }
+
+    for (size_t f = 0; f < shapes[s].mesh.indices.size() / 3; f++) {
+      Vertex v1(0, 0, 0), v2(0, 0, 0), v3(0, 0, 0);
+
+      tinyobj::index_t idx0 = shapes[s].mesh.indices[3 * f + 0];
+      tinyobj::index_t idx1 = shapes[s].mesh.indices[3 * f + 1];
+      tinyobj::index_t idx2 = shapes[s].mesh.indices[3 * f + 2];
+
+      // update material_id for face
+      int material_id_ = shapes[s].mesh.material_ids[f];
+      if ((material_id_ < 0) ||
+          (material_id_ >= static_cast<int>(materials_.size()))) {
+        // Invaid material ID. Use default material.
+        // Default material is added to the last item in `materials`.
+        material_id_ = materials_.size() - 1;
+      }
+
+      float diffuse[3];
+      for (size_t i = 0; i < 3; i++) {
+        diffuse[i] = materials_[material_id_].diffuse[i];
+      }
+
+      // update texcoord index
+      if (attrib.texcoords.size() > 0) {
+        if ((idx0.texcoord_index < 0) || (idx1.texcoord_index < 0) ||
+            (idx2.texcoord_index < 0)) {
+          // face does not contain valid uv index.
+          // negative texture coordinate index points to 0
+          v1.texcoord_index = -1;
+          v2.texcoord_index = -1;
+          v3.texcoord_index = -1;
+        } else {
+          // Don't forget to flip Y coord. for OpenGL rendering
+          v1.texcoord_index = idx0.texcoord_index;
+          v2.texcoord_index = idx1.texcoord_index;
+          v3.texcoord_index = idx2.texcoord_index;
+        }
+      } else {
+        // negative texture coordinate index points to 0
+        v1.texcoord_index = -1;
+        v2.texcoord_index = -1;
+        v3.texcoord_index = -1;
+      }
+
+      // update vertex index
+      v1.vertex_index = idx0.vertex_index;
+      v2.vertex_index = idx1.vertex_index;
+      v3.vertex_index = idx2.vertex_index;
+
+      _462::Vector3 face_normal = CalcNormal(
+          storage_.vertices[v1.vertex_index], storage_.vertices[v2.vertex_index],
+          storage_.vertices[v3.vertex_index]);
+
+      // update normal index
+      {
+        bool invalid_normal_index = false;
+        if (attrib.normals.size() > 0) {
+          int nf0 = idx0.normal_index;
+          int nf1 = idx1.normal_index;
+          int nf2 = idx2.normal_index;
+
+          if ((nf0 < 0) || (nf1 < 0) || (nf2 < 0)) {
+            // normal index is missing from this face.
+            invalid_normal_index = true;
+          } else {
+            v1.normal_index = nf0;
+            v2.normal_index = nf1;
+            v3.normal_index = nf2;
+          }
+        } else {
+          invalid_normal_index = true;
+        }
+
+        if (invalid_normal_index && !smooth_vertex_normals.empty()) {
+          // Use smoothing normals
+          int f0 = idx0.vertex_index;
+          int f1 = idx1.vertex_index;
+          int f2 = idx2.vertex_index;
+
+          if (f0 >= 0 && f1 >= 0 && f2 >= 0) {
+            v1.normal_index = storage_.normals.size();
+            storage_.normals.push_back(smooth_vertex_normals[f0]);
+            v2.normal_index = storage_.normals.size();
+            storage_.normals.push_back(smooth_vertex_normals[f1]);
+            v3.normal_index = storage_.normals.size();
+            storage_.normals.push_back(smooth_vertex_normals[f2]);
+
+            invalid_normal_index = false;
+          }
+        }
+
+        if (invalid_normal_index) {
+          v1.normal_index = v2.normal_index = v3.normal_index = storage_.normals.size();
+          storage_.normals.push_back(face_normal);
+        }
+      }
+
+      storage_.faces.push_back(Face(v1, v2, v3, face_normal, material_id_));
+    }
+    mesh.num_faces = storage_.faces.size() - mesh.first_face;
+
+    // update material_id_ for mesh
+    // OpenGL viewer does not support texturing with per-face material.
+    if (shapes[s].mesh.material_ids.size() > 0 &&
+        shapes[s].mesh.material_ids.size() > s) {
+      mesh.material_id =
+          shapes[s].mesh.material_ids[0];  // use the material ID
+                                           // of the first face.
+    } else {
+      mesh.material_id = materials_.size() - 1;  // = ID for default material.
+    }
+
+    // update texture_id
+    if ((mesh.material_id < materials_.size())) {
+      std::string diffuse_texname =
+          materials_[mesh.material_id].diffuse_texname;
+      if (textures_.find(diffuse_texname) != textures_.end()) {
+        mesh.texture_id = textures_[diffuse_texname];
+      }
+    } else {
+      // Invalid material ID. Use default material.
+      mesh.material_id = materials_.size() - 1;
+      std::cout << "Texture for " << filename << " not specified." << std::endl;
+    }
+
+    // update mesh
+    storage_.meshes.push_back(mesh);
+  }
+
+  bvh::Build(storage_.vertices, storage_.faces, &storage_.bvh_nodes,
+             &storage_.bvh_face_indices);
+
+  vertices_ = storage_.vertices;
+  normals_ = storage_.normals;
+  texcoords_ = storage_.texcoords;
+  faces_ = storage_.faces;
+  bvh_nodes_ = storage_.bvh_nodes;
+  bvh_face_indices_ = storage_.bvh_face_indices;
+  SetMeshes(storage_.meshes);
+}
+
+const Texture &Geometry::GetTextureInfo(const int texture_id) const {
+  assert(texture_id >= 0 && texture_id < texture_infos_.size());
+  return texture_infos_[texture_id];
+}
+
+// auxiliary functions
+
+// Returns whether the binary mesh `binary_filename` exists and is not older
+// than `filename`, which it is converted from.
+static bool IsUpToDate(const std::string &binary_filename,
+                       const std::string &filename) {
+  std::error_code error;
+  const auto binary_time =
+      std::filesystem::last_write_time(binary_filename, error);
+  if (error) {
+    return false;
+  }
+  const auto time = std::filesystem::last_write_time(filename, error);
+  // without its source, the binary mesh is all there is
+  if (error || binary_time >= time) {
+    return true;
+  }
+  std::cerr << binary_filename << " is older than " << filename
+            << ", which is loaded instead" << std::endl;
+  return false;
+}
+
+static bool FileExists(const std::string &abs_filename) {
+  bool ret;
+  FILE *fp = fopen(abs_filename.c_str(), "rb");
+  if (fp) {
+    ret = true;
+    fclose(fp);
+  } else {
+    ret = false;
+  }
+
+  return ret;
+}
+
+static std::string GetBaseDir(const std::string &filepath) {
+  if (filepath.find_last_of("/\\") != std::string::npos)
+    return filepath.substr(0, filepath.find_last_of("/\\")) + PathSeparator;
+  return "." + PathSeparator;
+}
+
+static bool HasSmoothingGroup(const tinyobj::shape_t &shape) {
+  for (auto smoothing_group_id : shape.mesh.smoothing_group_ids) {
+    if (smoothing_group_id > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void ComputeSmoothingNormals(
+    const tinyobj::attrib_t &attrib, const tinyobj::shape_t &shape,
+    std::map<int, _462::Vector3> &smooth_vertex_normals) {
+  smooth_vertex_normals.clear();
+
+  for (size_t f = 0; f < shape.mesh.indices.size() / 3; f++) {
+    // Get the three indexes of the face (all faces_ are triangular)
+    tinyobj::index_t idx0 = shape.mesh.indices[3 * f + 0];
+    tinyobj::index_t idx1 = shape.mesh.indices[3 * f + 1];
+    tinyobj::index_t idx2 = shape.mesh.indices[3 * f + 2];
+
+    // Get the three vertex indexes and coordinates
+    int vertex_index[3];  // indexes
+    float v[3][3];        // coordinates
+
+    for (int k = 0; k < 3; k++) {
+      vertex_index[0] = idx0.vertex_index;
+      vertex_index[1] = idx1.vertex_index;
+      vertex_index[2] = idx2.vertex_index;
+
+      v[0][k] = attrib.vertices[3 * vertex_index[0] + k];
+      v[1][k] = attrib.vertices[3 * vertex_index[1] + k];
+      v[2][k] = attrib.vertices[3 * vertex_index[2] + k];
+    }
+
+    // Compute the normal of the face
+    float normal[3];
+    CalcNormal(normal, v[0], v[1], v[2]);
+
+    // Add the normal to the three vertexes
+    for (size_t i = 0; i < 3; ++i) {
+      auto iter = smooth_vertex_normals.find(vertex_index[i]);
+      if (iter != smooth_vertex_normals.end()) {
+        // add
+        iter->second.x += normal[0];
+        iter->second.y += normal[1];
+        iter->second.z += normal[2];
+      } else {
+        smooth_vertex_normals[vertex_index[i]].x = normal[0];
+        smooth_vertex_normals[vertex_index[i]].y = normal[1];
+        smooth_vertex_normals[vertex_index[i]].z = normal[2];
+      }
+    }
+
+  }  // f
+
+  // Normalize the normals, that is, make them unit vectors
+  for (auto iter = smooth_vertex_normals.begin();
+       iter != smooth_vertex_normals.end(); iter++) {
+    normalize(iter->second);
+  }
+
+}  // ComputeSmoothingNormals
+
+static void CalcNormal(float N[3], float v0[3], float v1[3], float v2[3]) {
+  float v10[3];
+  v10[0] = v1[0] - v0[0];
+  v10[1] = v1[1] - v0[1];
+  v10[2] = v1[2] - v0[2];
+
+  float v20[3];
+  v20[0] = v2[0] - v0[0];
+  v20[1] = v2[1] - v0[1];
+  v20[2] = v2[2] - v0[2];
+
+  N[0] = v20[1] * v10[2] - v20[2] * v10[1];
+  N[1] = v20[2] * v10[0] - v20[0] * v10[2];
+  N[2] = v20[0] * v10[1] - v20[1] * v10[0];
+
+  float len2 = N[0] * N[0] + N[1] * N[1] + N[2] * N[2];
+  if (len2 > 0.0f) {
+    float len = sqrtf(len2);
+
+    N[0] /= len;
+    N[1] /= len;
+    N[2] /= len;
+  }
+}
+
+static _462::Vector3 CalcNormal(const _462::Vector3 &v0,
+                                const _462::Vector3 &v1,
+                                const _462::Vector3 &v2) {
+  _462::Vector3 v10 = v1 - v0;
+  _462::Vector3 v20 = v2 - v0;
+
+  _462::Vector3 N(v20.y * v10.z - v20.z * v10.y, v20.z * v10.x - v20.x * v10.z,
+                  v20.x * v10.y - v20.y * v10.x);
+  return _462::normalize(N);
+}
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
@@ -0,0 +1,157 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_GEOMETRY_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_GEOMETRY_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Optimized-Photon-Mapping/src/math/vector.hpp"
+#include "tinyobjloader/tiny_obj_loader.h"
+
+#include "environment/mapped_file.h"
+#include "environment/utility.h"
+
+#include "array_view.h"
+#include "binary_mesh.h"
+#include "bvh.h"
+#include "mesh.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// A texture decoded into an RGB buffer on the CPU. The buffer is either owned
+// by the texture or mapped from a binary mesh file.
+struct Texture {
+  Texture() = delete;
+  // Copies the `w` x `h` RGB pixels in `image`.
+  Texture(const int texture_id, const int w, const int h, const int comp,
+          const unsigned char *image);
+  // Refers to the `w` x `h` RGB pixels in `image` without copying them.
+  Texture(const int texture_id, const int w, const int h, const int comp,
+          const ArrayView<unsigned char> &image);
+  Texture(const Texture &) = delete;
+  Texture(Texture &&rhs) noexcept = default;
+
+  // index of this texture in its geometry
+  int texture_id;
+  ArrayView<unsigned char> buffer;
+  int w, h;
+  int comp;  // channels in the file, 3 = rgb, 4 = rgba
+
+ private:
+  std::vector<unsigned char> storage_;
+};
+
+// The geometry, materials and textures of a plant model. It is placed at the
+// origin and shared by all the `Model`s which instance it, so it is never
+// modified once loaded. It needs no OpenGL context, see `ModelRenderer` for
+// drawing it.
+//
+// It is either parsed from a 3d-obj file, or mapped from a preprocessed binary
+// mesh file (see binary_mesh.h) and used in place, which is much faster.
+class Geometry {
+ public:
+  Geometry() = delete;
+  // Loads a binary mesh file if `filename` ends with `.mesh`, otherwise parses
+  // it as a 3d-obj file. An invalid binary mesh file leaves it empty, see
+  // `is_loaded()`.
+  explicit Geometry(const char *filename);
+  Geometry(const Geometry &) = delete;
+  Geometry &operator=(const Geometry &) = delete;
+
+  // Writes this geometry to a binary mesh file. Returns false on failure.
+  bool WriteBinaryMesh(const std::string &filename) const;
+
+  size_t GetTotalFaces() const;
+
+  const ArrayView<_462::Vector3> &vertices() const { return vertices_; }
+  const ArrayView<_462::Vector3> &normals() const { return normals_; }
+  const ArrayView<_462::Vector2> &texcoords() const { return texcoords_; }
+  // faces of all meshes, each mesh covers a contiguous range
+  const ArrayView<Face> &faces() const { return faces_; }
+  const std::vector<Mesh> &meshes() const { return meshes_; }
+  const std::vector<tinyobj::material_t> &materials() const {
+    return materials_;
+  }
+  const std::vector<Texture> &texture_infos() const { return texture_infos_; }
+  const Texture &GetTextureInfo(const int texture_id) const;
+
+  // bounding volume hierarchy over `faces()`
+  const ArrayView<BvhNode> &bvh_nodes() const { return bvh_nodes_; }
+  const ArrayView<uint32_t> &bvh_face_indices() const {
+    return bvh_face_indices_;
+  }
+  // Returns the mesh which the face at `face_index` belongs to.
+  const Mesh &GetMeshOfFace(const uint32_t face_index) const;
+  // Whether this geometry is mapped from a binary mesh file.
+  bool is_mapped() const { return mapped_file_ != nullptr; }
+  // Whether its file was loaded. Only binary mesh files are rejected.
+  bool is_loaded() const { return loaded_; }
+  // An id which no other geometry has had, to key caches on.
+  uint64_t id() const { return id_.value(); }
+
+ private:
+  // Arrays owned by this geometry when it is parsed from a 3d-obj file.
+  struct Storage {
+    std::vector<_462::Vector3> vertices;
+    std::vector<_462::Vector3> normals;
+    std::vector<_462::Vector2> texcoords;
+    std::vector<Face> faces;
+    std::vector<binarymesh::MeshRecord> meshes;
+    std::vector<BvhNode> bvh_nodes;
+    std::vector<uint32_t> bvh_face_indices;
+  };
+
+  Storage storage_;
+  bool loaded_;
+  InstanceId id_;
+  // The binary mesh file this geometry is mapped from, if any.
+  std::unique_ptr<environment::MappedFile> mapped_file_;
+
+  ArrayView<_462::Vector3> vertices_;
+  ArrayView<_462::Vector3> normals_;
+  ArrayView<_462::Vector2> texcoords_;
+  ArrayView<Face> faces_;
+  ArrayView<BvhNode> bvh_nodes_;
+  ArrayView<uint32_t> bvh_face_indices_;
+  std::vector<Mesh> meshes_;
+  // texture file name to its index in `texture_infos_`
+  std::map<std::string, int> textures_;
+  std::vector<tinyobj::material_t> materials_;
+  std::vector<Texture> texture_infos_;
+
+  void LoadObjModel(const char *filename);
+  // Returns false if `filename` is not a valid binary mesh file.
+  bool LoadBinaryMesh(const char *filename);
+  // Builds `meshes_` over `faces_` from the mesh records.
+  void SetMeshes(const ArrayView<binarymesh::MeshRecord> &records);
+};
+
+// Process-wide cache of the geometry loaded from 3d-obj files, so that each
+// file is only parsed once no matter how many plants use it. The file of a
+// plant is chosen by its type and growth stage.
+class GeometryCache {
+ public:
+  // Returns the geometry of `filename`, loading it from disk on first use. If a
+  // binary mesh file converted from it (the same path with the `.mesh`
+  // extension) exists and is not older than it, that file is mapped instead,
+  // unless it is invalid.
+  static std::shared_ptr<Geometry> Get(const std::string &filename);
+
+  // Drops all cached geometry. Models which are still alive keep theirs.
+  static void Clear();
+
+ private:
+  static std::mutex mutex_;
+  static std::map<std::string, std::shared_ptr<Geometry>> cache_;
+};
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_GEOMETRY_H_
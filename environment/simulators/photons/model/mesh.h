@@ -2,43 +2,41 @@
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_MESH_H_
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include "Optimized-Photon-Mapping/src/math/vector.hpp"
-#include "tinyobjloader/tiny_obj_loader.h"
 
-#include "environment/simulators/photons/stdafx.h"
+#include "array_view.h"
 #include "face.h"
 
 namespace simulator {
 
 namespace photonsimulator {
 
+// A contiguous range of the faces of a geometry which share a material and a
+// texture.
 class Mesh {
  public:
-  void AddFace(const Face &face) { faces_.push_back(face); }
-
-  // OpenGL rendering
-  void Render(const std::vector<tinyobj::material_t> &materials_,
-              const _462::Vector3 &rel_pos_);
-  void WriteOpenGLBuffer(const std::vector<_462::Vector3> &vertices_,
-                         const std::vector<_462::Vector3> &normals_,
-                         const std::vector<_462::Vector2> &texcoords_);
-  void DeleteOpenGLBuffer();
-
-  // functions for photon mapping
-  size_t GetPhotons() const;
+  Mesh(const ArrayView<Face> &faces, const uint32_t first_face,
+       const size_t material_id, const int texture_id)
+      : faces_(faces),
+        first_face_(first_face),
+        material_id_(material_id),
+        texture_id_(texture_id) {}
+
+  const ArrayView<Face> &faces() const { return faces_; }
+  // index of the first face of this mesh in the geometry
+  uint32_t first_face() const { return first_face_; }
+  size_t material_id() const { return material_id_; }
+  // index of the texture in the geometry, -1 if there is no texture
+  int texture_id() const { return texture_id_; }
 
  private:
-  friend class Model;
-
-  std::vector<Face> faces_;  // triangle faces_
-  GLuint vb_id_;             // vertex buffer id
-  int num_triangles_;
+  ArrayView<Face> faces_;  // triangle faces_
+  uint32_t first_face_;
   size_t material_id_;
-  GLuint texture_id_;
-
-  void LoadObjModel(const char *filename);
+  int texture_id_;
 };
 
 }  // namespace photonsimulator
@@ -0,0 +1,141 @@
+#include "mesh_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "environment/simulators/photons/photon_simulator_config.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+namespace {
+
+const size_t kSizeOfBufferVertex =
+    kSizeOfVertexBuffer + kSizeOfNormalBuffer + kSizeOfTexcoordBuffer;
+
+bool VertexLess(const Vertex &a, const Vertex &b) {
+  if (a.vertex_index != b.vertex_index) {
+    return a.vertex_index < b.vertex_index;
+  }
+  if (a.normal_index != b.normal_index) {
+    return a.normal_index < b.normal_index;
+  }
+  return a.texcoord_index < b.texcoord_index;
+}
+
+bool SameVertex(const Vertex &a, const Vertex &b) {
+  return a.vertex_index == b.vertex_index &&
+         a.normal_index == b.normal_index &&
+         a.texcoord_index == b.texcoord_index;
+}
+
+const Vertex &Corner(const ArrayView<Face> &faces, const uint32_t corner) {
+  const Face &face = faces[corner / 3];
+  switch (corner % 3) {
+    case 0:
+      return face.vertex1;
+    case 1:
+      return face.vertex2;
+    default:
+      return face.vertex3;
+  }
+}
+
+}  // namespace
+
+size_t MeshBuffer::num_vertices() const {
+  return vertices.size() / kSizeOfBufferVertex;
+}
+
+void BuildMeshBuffer(const Geometry &geometry, const Mesh &mesh,
+                     MeshBuffer *buffer) {
+  const auto &faces = mesh.faces();
+  const uint32_t num_corners = faces.size() * 3;
+
+  // sort the corners so that equal ones are adjacent, then number the
+  // distinct ones in that order
+  std::vector<uint32_t> order(num_corners);
+  for (uint32_t i = 0; i < num_corners; ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+    return VertexLess(Corner(faces, a), Corner(faces, b));
+  });
+
+  buffer->indices.resize(num_corners);
+  uint32_t num_vertices = 0;
+  for (uint32_t i = 0; i < num_corners; ++i) {
+    if (i > 0 && !SameVertex(Corner(faces, order[i]), Corner(faces, order[i - 1]))) {
+      ++num_vertices;
+    }
+    buffer->indices[order[i]] = num_vertices;
+  }
+  if (num_corners > 0) {
+    ++num_vertices;
+  }
+
+  const auto &vertices = geometry.vertices();
+  const auto &normals = geometry.normals();
+  const auto &texcoords = geometry.texcoords();
+  buffer->vertices.resize(num_vertices * kSizeOfBufferVertex);
+  for (uint32_t i = 0; i < num_corners; ++i) {
+    // the first corner of each distinct vertex writes it
+    if (i > 0 && buffer->indices[order[i]] == buffer->indices[order[i - 1]]) {
+      continue;
+    }
+    const Vertex &corner = Corner(faces, order[i]);
+    float *out =
+        buffer->vertices.data() + buffer->indices[order[i]] * kSizeOfBufferVertex;
+    const _462::Vector3 &vertex = vertices[corner.vertex_index];
+    const _462::Vector3 &normal = normals[corner.normal_index];
+    out[0] = vertex.x;
+    out[1] = vertex.y;
+    out[2] = vertex.z;
+    out[3] = normal.x;
+    out[4] = normal.y;
+    out[5] = normal.z;
+    if (corner.texcoord_index != -1) {
+      out[6] = texcoords[corner.texcoord_index].x;
+      out[7] = texcoords[corner.texcoord_index].y;
+    } else {
+      out[6] = 0.0f;
+      out[7] = 0.0f;
+    }
+  }
+}
+
+void BuildMeshBuffers(const Geometry &geometry,
+                      std::vector<MeshBuffer> *buffers,
+                      unsigned int num_threads) {
+  const auto &meshes = geometry.meshes();
+  buffers->resize(meshes.size());
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = std::min<size_t>(num_threads, meshes.size());
+
+  // meshes differ a lot in size, so threads take the next one when done
+  std::atomic<size_t> next(0);
+  auto build = [&]() {
+    for (size_t i = next++; i < meshes.size(); i = next++) {
+      BuildMeshBuffer(geometry, meshes[i], &(*buffers)[i]);
+    }
+  };
+  if (num_threads <= 1) {
+    build();
+    return;
+  }
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    threads.emplace_back(build);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
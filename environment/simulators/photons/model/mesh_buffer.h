@@ -0,0 +1,42 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_MESH_BUFFER_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_MESH_BUFFER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry.h"
+#include "mesh.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// The vertex and index data of a mesh as uploaded to OpenGL. Corners of faces
+// which share the same vertex, normal and texture coordinate are stored once,
+// and `indices` lists the vertices of each triangle.
+struct MeshBuffer {
+  // interleaved kSizeOfVertexBuffer positions, kSizeOfNormalBuffer normals
+  // and kSizeOfTexcoordBuffer texture coordinates per vertex
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+
+  size_t num_vertices() const;
+};
+
+// Builds the buffer of `mesh` into `buffer`, reusing its storage. The arrays
+// are sized exactly before they are filled.
+void BuildMeshBuffer(const Geometry &geometry, const Mesh &mesh,
+                     MeshBuffer *buffer);
+
+// Builds the buffers of all the meshes of `geometry`, in parallel on up to
+// `num_threads` threads, or one per core if it is 0. This does not need an
+// OpenGL context.
+void BuildMeshBuffers(const Geometry &geometry,
+                      std::vector<MeshBuffer> *buffers,
+                      unsigned int num_threads = 0);
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_MESH_BUFFER_H_
@@ -0,0 +1,175 @@
+#include "renderer.h"
+
+#include "environment/simulators/photons/photon_simulator_config.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+ModelRenderer::~ModelRenderer() { DeleteAllBuffers(); }
+
+void ModelRenderer::WriteBuffer(const Geometry &geometry) {
+  if (buffers_.find(geometry.id()) != buffers_.end()) {
+    return;
+  }
+
+  Buffers &buffers = buffers_[geometry.id()];
+  for (const auto &texture : geometry.texture_infos()) {
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // textures are always decoded into RGB
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, texture.w, texture.h, 0, GL_RGB,
+                 GL_UNSIGNED_BYTE, texture.buffer.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    buffers.texture_ids.push_back(texture_id);
+  }
+
+  BuildMeshBuffers(geometry, &mesh_buffers_);
+  for (const auto &mesh_buffer : mesh_buffers_) {
+    GLuint vb_id = 0, ib_id = 0;
+    if (!mesh_buffer.indices.empty()) {
+      vb_id = AcquireBuffer();
+      glBindBuffer(GL_ARRAY_BUFFER, vb_id);
+      glBufferData(GL_ARRAY_BUFFER, mesh_buffer.vertices.size() * sizeof(float),
+                   mesh_buffer.vertices.data(), GL_STATIC_DRAW);
+      ib_id = AcquireBuffer();
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib_id);
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                   mesh_buffer.indices.size() * sizeof(uint32_t),
+                   mesh_buffer.indices.data(), GL_STATIC_DRAW);
+    }
+    buffers.vb_ids.push_back(vb_id);
+    buffers.ib_ids.push_back(ib_id);
+    buffers.num_indices.push_back(mesh_buffer.indices.size());
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void ModelRenderer::DeleteBuffer(const Geometry &geometry) {
+  auto it = buffers_.find(geometry.id());
+  if (it != buffers_.end()) {
+    DeleteBuffer(it);
+  }
+}
+
+std::unordered_map<uint64_t, ModelRenderer::Buffers>::iterator
+ModelRenderer::DeleteBuffer(
+    std::unordered_map<uint64_t, Buffers>::iterator it) {
+  Buffers &buffers = it->second;
+  for (size_t i = 0; i < buffers.vb_ids.size(); ++i) {
+    ReleaseBuffer(buffers.vb_ids[i]);
+    ReleaseBuffer(buffers.ib_ids[i]);
+  }
+  if (!buffers.texture_ids.empty()) {
+    glDeleteTextures(buffers.texture_ids.size(), buffers.texture_ids.data());
+  }
+  return buffers_.erase(it);
+}
+
+void ModelRenderer::DeleteAllBuffers() {
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    it = DeleteBuffer(it);
+  }
+  if (!free_buffer_ids_.empty()) {
+    glDeleteBuffers(free_buffer_ids_.size(), free_buffer_ids_.data());
+    free_buffer_ids_.clear();
+  }
+}
+
+GLuint ModelRenderer::AcquireBuffer() {
+  if (free_buffer_ids_.empty()) {
+    GLuint id;
+    glGenBuffers(1, &id);
+    return id;
+  }
+  const GLuint id = free_buffer_ids_.back();
+  free_buffer_ids_.pop_back();
+  return id;
+}
+
+void ModelRenderer::ReleaseBuffer(const GLuint id) {
+  if (id > 0) {
+    free_buffer_ids_.push_back(id);
+  }
+}
+
+void ModelRenderer::Render(const Model &model) {
+  const Geometry &geometry = model.geometry();
+  WriteBuffer(geometry);
+
+  const Buffers &buffers = buffers_[geometry.id()];
+  const auto &meshes = geometry.meshes();
+  for (size_t i = 0; i < meshes.size(); ++i) {
+    const int texture_index = meshes[i].texture_id();
+    const GLuint texture_id =
+        texture_index >= 0 ? buffers.texture_ids[texture_index] : 0;
+    RenderMesh(geometry, meshes[i], buffers.vb_ids[i], buffers.ib_ids[i],
+               buffers.num_indices[i], texture_id, model.rel_pos());
+  }
+}
+
+void ModelRenderer::RenderMesh(const Geometry &geometry, const Mesh &mesh,
+                               const GLuint vb_id, const GLuint ib_id,
+                               const GLsizei num_indices,
+                               const GLuint texture_id,
+                               const _462::Vector3 &rel_pos) {
+  const tinyobj::material_t &material =
+      geometry.materials()[mesh.material_id()];
+  GLfloat mat_ambient[] = {material.ambient[0], material.ambient[1],
+                           material.ambient[2], 1.0f};
+  GLfloat mat_diffuse[] = {material.diffuse[0], material.diffuse[1],
+                           material.diffuse[2], 1.0f};
+  GLfloat mat_specular[] = {material.specular[0], material.specular[1],
+                            material.specular[2], 1.0f};
+  GLfloat mat_shininess[] = {material.shininess};
+  glPushMatrix();
+  glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, mat_ambient);
+  glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, mat_diffuse);
+  glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, mat_specular);
+  glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, mat_shininess);
+  glTranslatef(rel_pos.x, rel_pos.y, rel_pos.z);
+
+  glPolygonMode(GL_FRONT, GL_FILL);
+  glPolygonMode(GL_BACK, GL_FILL);
+
+  glEnable(GL_POLYGON_OFFSET_FILL);
+  glPolygonOffset(1.0, 1.0);
+  GLsizei stride =
+      (kSizeOfVertexBuffer + kSizeOfNormalBuffer + kSizeOfTexcoordBuffer) *
+      sizeof(float);
+
+  if (vb_id > 0) {
+    glBindBuffer(GL_ARRAY_BUFFER, vb_id);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib_id);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    // bind texture if loaded
+    if (mesh.texture_id() != -1)
+      glBindTexture(GL_TEXTURE_2D, texture_id);
+    else {
+      glBindTexture(GL_TEXTURE_2D, 0);
+      glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glVertexPointer(3, GL_FLOAT, stride, (const void *)0);
+    glNormalPointer(GL_FLOAT, stride, (const void *)(sizeof(float) * 3));
+    glTexCoordPointer(2, GL_FLOAT, stride, (const void *)(sizeof(float) * 6));
+
+    glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT,
+                   (const void *)0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  }
+
+  glPopMatrix();
+}
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
@@ -0,0 +1,77 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_RENDERER_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_RENDERER_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "environment/simulators/photons/stdafx.h"
+#include "geometry.h"
+#include "mesh_buffer.h"
+#include "model.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// Uploads the geometry of models to OpenGL and draws them. This is the only
+// part of the photon simulator which needs an OpenGL context, so it is left
+// out of headless builds (`make HEADLESS=1`).
+class ModelRenderer {
+ public:
+  ModelRenderer() = default;
+  ModelRenderer(const ModelRenderer &) = delete;
+  ModelRenderer &operator=(const ModelRenderer &) = delete;
+
+  ~ModelRenderer();
+
+  // Writes the vertex buffers and textures of `geometry`. Buffers are written
+  // once and shared by all models instancing the geometry. The vertex data of
+  // the meshes is built in parallel before it is uploaded.
+  void WriteBuffer(const Geometry &geometry);
+  // Releases the buffers of `geometry`. The buffer objects are kept and
+  // reused by the next geometry written, so reloading a scene does not
+  // create new ones.
+  void DeleteBuffer(const Geometry &geometry);
+  // Deletes all the buffer objects, including the ones kept for reuse.
+  void DeleteAllBuffers();
+
+  // Draws `model`, writing the buffers of its geometry if needed.
+  void Render(const Model &model);
+
+ private:
+  // OpenGL objects of a geometry
+  struct Buffers {
+    // vertex and index buffer ids and number of indices of each mesh
+    std::vector<GLuint> vb_ids;
+    std::vector<GLuint> ib_ids;
+    std::vector<GLsizei> num_indices;
+    // OpenGL texture id of each texture
+    std::vector<GLuint> texture_ids;
+  };
+
+  // by the id of the geometry, as a freed geometry's address may be reused by
+  // a new one
+  std::unordered_map<uint64_t, Buffers> buffers_;
+  // buffer objects released by DeleteBuffer, to be reused
+  std::vector<GLuint> free_buffer_ids_;
+  // CPU side of the meshes being uploaded, kept to avoid reallocating
+  std::vector<MeshBuffer> mesh_buffers_;
+
+  GLuint AcquireBuffer();
+  void ReleaseBuffer(const GLuint id);
+  // Releases the buffers at `it`, returning the next ones.
+  std::unordered_map<uint64_t, Buffers>::iterator DeleteBuffer(
+      std::unordered_map<uint64_t, Buffers>::iterator it);
+
+  static void RenderMesh(const Geometry &geometry, const Mesh &mesh,
+                         const GLuint vb_id, const GLuint ib_id,
+                         const GLsizei num_indices, const GLuint texture_id,
+                         const _462::Vector3 &rel_pos);
+};
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_MODEL_RENDERER_H_
@@ -17,6 +17,9 @@ const size_t kSizeOfTexcoordBuffer = 2;
 // RGB = 3, RGBA = 4, we use RGB here
 const size_t kNumOfChannels = 3;
 
+// number of photons emitted along each side of the terrain
+const int kPhotonsPerSide = 100;
+
 // constant for kd-tree
 const int kXAXIS = 0;  // use x-axis
 const int kYAXIS = 1;  // use y-axis
@@ -24,7 +27,7 @@ const int kZAXIS = 2;  // use z-axis
 const int kLEAF = 3;   // just leaf
 
 namespace filepath {
-const char defaultpath[] = "";
+const char defaultpath[] = "environment/simulators/photons/asset/";
 const char corn1[] = "Corn1.obj";
 const char corn2[] = "Corn2.obj";
 const char corn3[] = "Corn3.obj";
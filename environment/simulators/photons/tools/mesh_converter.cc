@@ -0,0 +1,37 @@
+// Converts 3d-obj plant models into binary mesh files (see
+// model/binary_mesh.h), which are mapped into memory instead of being parsed
+// when the photon simulator loads the models.
+//
+// Usage: mesh_converter <model.obj>...
+// Each model is written next to its source with the `.mesh` extension.
+#include <iostream>
+#include <string>
+
+#include "environment/simulators/photons/model/binary_mesh.h"
+#include "environment/simulators/photons/model/geometry.h"
+
+using simulator::photonsimulator::Geometry;
+namespace binarymesh = simulator::photonsimulator::binarymesh;
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <model.obj>..." << std::endl;
+    return 1;
+  }
+
+  int ret = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string filename(argv[i]);
+    const std::string output =
+        filename.substr(0, filename.find_last_of('.')) + binarymesh::kExtension;
+    Geometry geometry(filename.c_str());
+    if (geometry.WriteBinaryMesh(output)) {
+      std::cout << filename << " -> " << output << " ("
+                << geometry.GetTotalFaces() << " faces)" << std::endl;
+    } else {
+      std::cerr << "Unable to write " << output << std::endl;
+      ret = 1;
+    }
+  }
+  return ret;
+}
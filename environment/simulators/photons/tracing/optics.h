@@ -0,0 +1,136 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_OPTICS_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_OPTICS_H_
+
+#include <cmath>
+
+namespace simulator {
+
+namespace photonsimulator {
+
+namespace tracing {
+
+// The tolerance of the intersections of rays with faces.
+constexpr double kEpsilon = 1e-6;
+
+// What happens to a photon when it hits a face.
+enum class Interaction { kAbsorb = 0, kReflect, kRefract };
+
+// Chooses the interaction of a photon with a face, given the probabilities of
+// absorption and reflection, and a uniform random number `u` in [0, 1). It is
+// refracted otherwise.
+inline Interaction RussianRoulette(const double absorption,
+                                   const double reflection, const double u) {
+  if (u < absorption) {
+    return Interaction::kAbsorb;
+  } else if (u < absorption + reflection) {
+    return Interaction::kReflect;
+  } else {
+    return Interaction::kRefract;
+  }
+}
+
+// The functions below work on any vector type `Vec` with `x`, `y` and `z`
+// members and a constructor from them, so that they do not depend on the
+// operators of a particular vector library.
+
+template <typename Vec>
+inline double Dot(const Vec &a, const Vec &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Returns `dir` mirrored about the plane with `normal`, which need not be
+// normalized.
+template <typename Vec>
+inline Vec Reflect(const Vec &dir, const Vec &normal) {
+  const double scale = 2.0 * Dot(dir, normal) / Dot(normal, normal);
+  return Vec(dir.x - scale * normal.x, dir.y - scale * normal.y,
+             dir.z - scale * normal.z);
+}
+
+// Returns `dir` refracted through the plane with unit `normal`, where `eta` is
+// the ratio of the refractive indices of the two sides. The normal may face
+// either side. Returns the reflection on total internal reflection.
+template <typename Vec>
+inline Vec Refract(const Vec &dir, const Vec &normal, const double eta) {
+  double cos_in = -Dot(dir, normal);
+  double sign = 1.0;
+  if (cos_in < 0.0) {
+    // the normal points to the same side as the ray
+    cos_in = -cos_in;
+    sign = -1.0;
+  }
+  const double k = 1.0 - eta * eta * (1.0 - cos_in * cos_in);
+  if (k < 0.0) {
+    return Reflect(dir, normal);
+  }
+  const double scale = sign * (eta * cos_in - std::sqrt(k));
+  return Vec(eta * dir.x + scale * normal.x, eta * dir.y + scale * normal.y,
+             eta * dir.z + scale * normal.z);
+}
+
+// Returns whether `p`, which lies in the plane of the triangle `abc`, is
+// inside the triangle.
+template <typename Vec>
+inline bool IsInTriangle(const Vec &a, const Vec &b, const Vec &c,
+                         const Vec &p) {
+  const Vec v0(c.x - a.x, c.y - a.y, c.z - a.z);
+  const Vec v1(b.x - a.x, b.y - a.y, b.z - a.z);
+  const Vec v2(p.x - a.x, p.y - a.y, p.z - a.z);
+  const double dot00 = Dot(v0, v0);
+  const double dot01 = Dot(v0, v1);
+  const double dot02 = Dot(v0, v2);
+  const double dot11 = Dot(v1, v1);
+  const double dot12 = Dot(v1, v2);
+  const double inver_deno = 1 / (dot00 * dot11 - dot01 * dot01);
+  const double u = (dot11 * dot02 - dot01 * dot12) * inver_deno;
+  if (u < 0 || u > 1) {
+    return false;
+  }
+  const double v = (dot00 * dot12 - dot01 * dot02) * inver_deno;
+  if (v < 0 || v > 1) {
+    return false;
+  }
+  return u + v <= 1;
+}
+
+// Returns the point where the line through `point` along `dir` crosses the
+// plane through `plane_point` with `plane_normal`, and sets `*distance` to
+// its signed distance along the normalized `dir`. The line must not be
+// parallel to the plane.
+template <typename Vec>
+inline Vec IntersectPlane(const Vec &plane_point, const Vec &plane_normal,
+                          const Vec &point, const Vec &dir, double *distance) {
+  const double len = std::sqrt(Dot(dir, dir));
+  const Vec unit(dir.x / len, dir.y / len, dir.z / len);
+  const Vec to_plane(plane_point.x - point.x, plane_point.y - point.y,
+                     plane_point.z - point.z);
+  const double d = Dot(to_plane, plane_normal) / Dot(unit, plane_normal);
+  *distance = d;
+  return Vec(point.x + d * unit.x, point.y + d * unit.y, point.z + d * unit.z);
+}
+
+// Returns whether the ray from `pos` along `dir` hits the triangle `abc` with
+// `normal`, which need not be normalized, and sets `*point` to the hit and
+// `*distance` to its distance along the ray. Faces parallel to the ray are
+// missed, and so are hits behind it or within `kEpsilon` of its start, such as
+// on the face a reflected photon leaves.
+template <typename Vec>
+inline bool IntersectTriangle(const Vec &a, const Vec &b, const Vec &c,
+                              const Vec &normal, const Vec &pos,
+                              const Vec &dir, Vec *point, double *distance) {
+  const double cos_angle = Dot(dir, normal) / std::sqrt(Dot(dir, dir)) /
+                           std::sqrt(Dot(normal, normal));
+  if (std::abs(cos_angle) < kEpsilon) {
+    return false;
+  }
+  *point = IntersectPlane(a, normal, pos, dir, distance);
+  return *distance >= kEpsilon && IsInTriangle(a, b, c, *point);
+}
+
+}  // namespace tracing
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_OPTICS_H_
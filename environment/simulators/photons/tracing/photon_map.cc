@@ -0,0 +1,124 @@
+#include "photon_map.h"
+
+#include <limits>
+
+namespace simulator {
+
+namespace photonsimulator {
+
+namespace tracing {
+
+namespace {
+
+// Returns the number of nodes in the left subtree of a left-balanced tree of
+// `n` nodes, where every level is full except the last one, which is filled
+// from the left.
+size_t LeftSubtreeSize(const size_t n) {
+  if (n <= 1) {
+    return 0;
+  }
+  // number of levels which are full
+  int levels = 0;
+  while ((size_t(2) << levels) - 1 <= n) {
+    ++levels;
+  }
+  const size_t full = (size_t(1) << levels) - 1;
+  const size_t last_level = n - full;
+  const size_t half_last_level = size_t(1) << (levels - 1);
+  return (full - 1) / 2 + std::min(last_level, half_last_level);
+}
+
+}  // namespace
+
+void PhotonMap::Build(const float *positions, const size_t count) {
+  nodes_.resize(count);
+  std::vector<uint32_t> order(count);
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  BuildSubtree(positions, 0, &order, 0, order.size());
+}
+
+void PhotonMap::BuildSubtree(const float *positions, const size_t node,
+                             std::vector<uint32_t> *order, const size_t begin,
+                             const size_t end) {
+  if (begin >= end) {
+    return;
+  }
+
+  // split on the axis along which the photons spread the most
+  float lower[3], upper[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    lower[axis] = std::numeric_limits<float>::max();
+    upper[axis] = std::numeric_limits<float>::lowest();
+  }
+  for (size_t i = begin; i < end; ++i) {
+    const float *pos = positions + 3 * (*order)[i];
+    for (int axis = 0; axis < 3; ++axis) {
+      lower[axis] = std::min(lower[axis], pos[axis]);
+      upper[axis] = std::max(upper[axis], pos[axis]);
+    }
+  }
+  uint32_t axis = 0;
+  for (uint32_t a = 1; a < 3; ++a) {
+    if (upper[a] - lower[a] > upper[axis] - lower[axis]) {
+      axis = a;
+    }
+  }
+
+  const size_t median = begin + LeftSubtreeSize(end - begin);
+  std::nth_element(order->begin() + begin, order->begin() + median,
+                   order->begin() + end,
+                   [&](const uint32_t a, const uint32_t b) {
+                     return positions[3 * a + axis] < positions[3 * b + axis];
+                   });
+
+  const uint32_t index = (*order)[median];
+  Node &n = nodes_[node];
+  n.pos[0] = positions[3 * index];
+  n.pos[1] = positions[3 * index + 1];
+  n.pos[2] = positions[3 * index + 2];
+  n.index = index;
+  n.axis = axis;
+
+  BuildSubtree(positions, 2 * node + 1, order, begin, median);
+  BuildSubtree(positions, 2 * node + 2, order, median + 1, end);
+}
+
+void PhotonMap::FindInRadius(const float point[3], const float radius,
+                             std::vector<uint32_t> *result) const {
+  result->clear();
+  if (nodes_.empty()) {
+    return;
+  }
+
+  const float radius2 = radius * radius;
+  size_t stack[kMaxStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const size_t i = stack[--top];
+    const Node &node = nodes_[i];
+    const float d = point[node.axis] - node.pos[node.axis];
+    const size_t near_child = d < 0 ? 2 * i + 1 : 2 * i + 2;
+    const size_t far_child = d < 0 ? 2 * i + 2 : 2 * i + 1;
+    if (d * d <= radius2 && far_child < nodes_.size()) {
+      stack[top++] = far_child;
+    }
+    if (near_child < nodes_.size()) {
+      stack[top++] = near_child;
+    }
+    const float dx = point[0] - node.pos[0];
+    const float dy = point[1] - node.pos[1];
+    const float dz = point[2] - node.pos[2];
+    if (dx * dx + dy * dy + dz * dz <= radius2) {
+      result->push_back(node.index);
+    }
+  }
+}
+
+}  // namespace tracing
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
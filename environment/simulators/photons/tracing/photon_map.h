@@ -0,0 +1,166 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_PHOTON_MAP_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_PHOTON_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simulator {
+
+namespace photonsimulator {
+
+// The photon tracing core shared by the photon simulator and the viz. It does
+// not depend on the vector types of either, positions are passed as floats.
+namespace tracing {
+
+// A spatial index over the positions of photons, stored as a left-balanced
+// KD-tree in one flat array: the children of node `i` are `2i + 1` and
+// `2i + 2`, so no pointers or per-node allocations are needed. Queries write
+// into buffers supplied by the caller, which can be reused across queries so
+// that they do not allocate once the buffers have grown.
+class PhotonMap {
+ public:
+  // A photon found by a query and its squared distance to the query point.
+  struct Neighbor {
+    uint32_t index;  // index of the photon in the container the map is built
+                     // from
+    float distance2;
+  };
+
+  PhotonMap() = default;
+
+  // Rebuilds the index over `count` positions stored as consecutive xyz
+  // triples.
+  void Build(const float *positions, const size_t count);
+
+  // Rebuilds the index over the `pos` of the photons in `photons`, which may
+  // be of any type with `x`, `y` and `z` members.
+  template <typename Photons>
+  void BuildFrom(const Photons &photons);
+
+  size_t size() const { return nodes_.size(); }
+  bool empty() const { return nodes_.empty(); }
+
+  // Replaces the contents of `result` with the indices of all photons within
+  // `radius` of `point`, in no particular order.
+  void FindInRadius(const float point[3], const float radius,
+                    std::vector<uint32_t> *result) const;
+
+  // Finds the `k` photons nearest to `point` which are within `max_radius` of
+  // it and for which `accept(index)` returns true. `result` must have room for
+  // `k` neighbors; the number found is returned and they are stored in no
+  // particular order.
+  template <typename Filter>
+  size_t FindNearest(const float point[3], const size_t k,
+                     const float max_radius, Neighbor *result,
+                     Filter accept) const;
+  size_t FindNearest(const float point[3], const size_t k,
+                     const float max_radius, Neighbor *result) const {
+    return FindNearest(point, k, max_radius, result,
+                       [](const uint32_t) { return true; });
+  }
+
+ private:
+  struct Node {
+    float pos[3];
+    uint32_t index;  // index of the photon
+    uint32_t axis;   // the axis this node splits its subtree on
+  };
+
+  // the depth of a left-balanced tree over 2^32 photons is at most 32, and
+  // each level pushes at most two nodes
+  static const int kMaxStackSize = 64;
+
+  std::vector<Node> nodes_;
+  // positions of the photons being indexed, kept to avoid reallocating
+  std::vector<float> positions_;
+
+  // Places the photons in `order[begin, end)` in the subtree rooted at `node`.
+  void BuildSubtree(const float *positions, const size_t node,
+                    std::vector<uint32_t> *order, const size_t begin,
+                    const size_t end);
+
+  static bool CloserThan(const Neighbor &a, const Neighbor &b) {
+    return a.distance2 < b.distance2;
+  }
+};
+
+template <typename Photons>
+void PhotonMap::BuildFrom(const Photons &photons) {
+  positions_.clear();
+  for (const auto &photon : photons) {
+    positions_.push_back(photon.pos.x);
+    positions_.push_back(photon.pos.y);
+    positions_.push_back(photon.pos.z);
+  }
+  Build(positions_.data(), positions_.size() / 3);
+}
+
+template <typename Filter>
+size_t PhotonMap::FindNearest(const float point[3], const size_t k,
+                              const float max_radius, Neighbor *result,
+                              Filter accept) const {
+  if (nodes_.empty() || k == 0) {
+    return 0;
+  }
+
+  // squared distance of the farthest photon which may still be kept
+  float radius2 = max_radius * max_radius;
+  size_t found = 0;
+
+  // Nodes are pushed with the squared distance to their splitting plane, so
+  // subtrees which fell out of the shrinking radius are skipped when popped.
+  struct Entry {
+    size_t node;
+    float plane_distance2;
+  } stack[kMaxStackSize];
+  int top = 0;
+  stack[top++] = {0, 0.0f};
+  while (top > 0) {
+    const Entry entry = stack[--top];
+    if (entry.plane_distance2 > radius2) {
+      continue;
+    }
+    const size_t i = entry.node;
+    const Node &node = nodes_[i];
+    const float d = point[node.axis] - node.pos[node.axis];
+    const size_t near_child = d < 0 ? 2 * i + 1 : 2 * i + 2;
+    const size_t far_child = d < 0 ? 2 * i + 2 : 2 * i + 1;
+    if (far_child < nodes_.size()) {
+      stack[top++] = {far_child, d * d};
+    }
+    if (near_child < nodes_.size()) {
+      stack[top++] = {near_child, entry.plane_distance2};
+    }
+
+    const float dx = point[0] - node.pos[0];
+    const float dy = point[1] - node.pos[1];
+    const float dz = point[2] - node.pos[2];
+    const float distance2 = dx * dx + dy * dy + dz * dz;
+    if (distance2 > radius2 || !accept(node.index)) {
+      continue;
+    }
+    // `result[0, found)` is a max-heap on the distance
+    if (found < k) {
+      result[found++] = {node.index, distance2};
+      std::push_heap(result, result + found, CloserThan);
+    } else {
+      std::pop_heap(result, result + found, CloserThan);
+      result[found - 1] = {node.index, distance2};
+      std::push_heap(result, result + found, CloserThan);
+    }
+    if (found == k) {
+      radius2 = result[0].distance2;
+    }
+  }
+  return found;
+}
+
+}  // namespace tracing
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_PHOTON_MAP_H_
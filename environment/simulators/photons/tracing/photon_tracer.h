@@ -0,0 +1,75 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_PHOTON_TRACER_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_PHOTON_TRACER_H_
+
+#include "optics.h"
+
+namespace simulator {
+
+namespace photonsimulator {
+
+namespace tracing {
+
+// Calls `emit(x, y)` for each point of a grid on the ground, from `x_min` by
+// `x_step` up to `x_max` included, and likewise in y. Only the rows of x
+// numbered `batch` modulo `num_batches` are emitted, so that the batches of a
+// progressive render each cover the whole grid and together emit it once.
+template <typename Real, typename EmitFunc>
+void EmitGrid(const Real x_min, const Real x_max, const Real x_step,
+              const Real y_min, const Real y_max, const Real y_step,
+              EmitFunc emit, const int batch = 0, const int num_batches = 1) {
+  int row = 0;
+  for (Real x = x_min; x <= x_max; x += x_step, ++row) {
+    if (row % num_batches != batch) {
+      continue;
+    }
+    for (Real y = y_min; y <= y_max; y += y_step) {
+      emit(x, y);
+    }
+  }
+}
+
+// Where a photon hits a face, and how the face treats it.
+template <typename Vec>
+struct Hit {
+  Vec point;
+  // the unit normal of the face, on either side
+  Vec normal;
+  double absorption;
+  double reflection;
+};
+
+// Bounces `photon`, anything with `pos` and `dir` members of type `Vec`,
+// through a scene until it is absorbed or leaves the scene. At each bounce
+// `find_hit(*photon, &hit)` returns whether the photon hits a face, and
+// `absorb(*photon, hit)` is called if the Russian roulette absorbs it there.
+// Otherwise it is reflected or refracted from the point of the hit. `uniform()`
+// returns a uniform random number in [0, 1). Returns whether it was absorbed.
+template <typename Vec, typename PhotonT, typename FindHitFunc,
+          typename AbsorbFunc, typename UniformFunc>
+bool TracePhoton(PhotonT *photon, FindHitFunc find_hit, AbsorbFunc absorb,
+                 UniformFunc uniform) {
+  Hit<Vec> hit;
+  while (find_hit(*photon, &hit)) {
+    switch (RussianRoulette(hit.absorption, hit.reflection, uniform())) {
+      case Interaction::kAbsorb:
+        absorb(*photon, hit);
+        return true;
+      case Interaction::kReflect:
+        photon->dir = Reflect(photon->dir, hit.normal);
+        break;
+      case Interaction::kRefract:
+        photon->dir = Refract(photon->dir, hit.normal, 1.0);
+        break;
+    }
+    photon->pos = hit.point;
+  }
+  return false;
+}
+
+}  // namespace tracing
+
+}  // namespace photonsimulator
+
+}  // namespace simulator
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SIMULATORS_PHOTONS_TRACING_PHOTON_TRACER_H_
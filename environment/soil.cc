@@ -1,9 +1,36 @@
 #include "soil.h"
 
+#include <assert.h>
 #include <limits>
 
 namespace environment {
 
+namespace {
+
+// Layers of thickness (m), evaporation fraction and root fraction.
+// The two thin layers of the original model, of which the lower one holds the
+// roots.
+const SoilProfile kClayProfile = {{{0.02, 0.26, 0.0}, {0.03, 0.74, 1.0}}};
+// Drier textures root deeper, down to 0.35 m.
+const SoilProfile kSiltProfile = {
+    {{0.02, 0.26, 0.0}, {0.03, 0.74, 0.4}, {0.10, 0.0, 0.4}, {0.20, 0.0, 0.2}}};
+const SoilProfile kSandProfile = {
+    {{0.02, 0.26, 0.0}, {0.03, 0.74, 0.2}, {0.10, 0.0, 0.4}, {0.20, 0.0, 0.4}}};
+
+}  // namespace
+
+const SoilProfile &Soil::Profile(const Texture texture) {
+  switch (texture) {
+    case SILT:
+      return kSiltProfile;
+    case SAND:
+      return kSandProfile;
+    case CLAY:
+    default:
+      return kClayProfile;
+  }
+}
+
 Soil::Soil(const Texture texture, const double pH, const double salinity,
            const double organic_matter, const double water_content_layer_1,
            const double water_content_layer_2)
@@ -11,29 +38,51 @@ Soil::Soil(const Texture texture, const double pH, const double salinity,
       pH_(pH),
       salinity_(salinity),
       organic_matter_(organic_matter),
-      water_content_({water_content_layer_1, water_content_layer_2}) {}
-
-void Soil::UpdateWaterContent(double rainfall,
-                              double total_flux_density_sunlit_potential,
-                              double total_flux_density_shaded_potential) {
-  water_content_ = WaterBalance::DailyWaterContent(
-      rainfall, water_content_.water_amount_1, water_content_.water_amount_2,
-      total_flux_density_sunlit_potential, total_flux_density_shaded_potential);
+      water_content_(Profile(texture).num_layers(), water_content_layer_2) {
+  water_content_.front() = water_content_layer_1;
+}
+
+Soil::Soil(const Texture texture, const double pH, const double salinity,
+           const double organic_matter,
+           const std::vector<double> &water_content)
+    : texture_(texture),
+      pH_(pH),
+      salinity_(salinity),
+      organic_matter_(organic_matter),
+      water_content_(water_content) {
+  assert(water_content_.size() == Profile(texture).num_layers());
+}
+
+void Soil::UpdateWaterContent(double rainfall, double latent_heat_soil,
+                              double latent_heat_crop, double days) {
+  // a single column, whose layers are already contiguous
+  double evaporation;
+  double percolation;
+  WaterBalance::UpdateWaterContent(profile(), 1, days, &rainfall,
+                                   &latent_heat_soil, &latent_heat_crop,
+                                   water_content_.data(), &evaporation,
+                                   &percolation);
 }
 
 void Soil::AddWaterToSoil(double water_amount) {
   // TODO: Should all water just be added to the top layer?
-  water_content_.water_amount_1 += water_amount;
+  water_content_.front() += water_amount;
+}
+
+double Soil::root_zone_water_content() const {
+  const SoilProfile &soil_profile = profile();
+  double water_content = 0.0;
+  for (size_t k = 0; k < soil_profile.num_layers(); ++k) {
+    water_content += soil_profile.layers[k].root_fraction * water_content_[k];
+  }
+  return water_content;
 }
 
 bool operator==(const Soil &lhs, const Soil &rhs) {
   return (lhs.texture() == rhs.texture()) && (lhs.pH() == rhs.pH()) &&
          (lhs.salinity() == rhs.salinity()) &&
          (lhs.organic_matter() == rhs.organic_matter()) &&
-         (lhs.water_content().water_amount_1 ==
-          rhs.water_content().water_amount_1) &&
-         (lhs.water_content().water_amount_2 ==
-          rhs.water_content().water_amount_2);
+         (lhs.water_content() == rhs.water_content());
 }
 
 }  // namespace environment
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SOIL_H_
 
 #include <optional>
+#include <vector>
 
 #include "environment/resource.h"
 #include "environment/utility.h"
@@ -17,23 +18,44 @@ class Soil {
  public:
   enum Texture { CLAY = 0, SILT, SAND };
 
+  // The layers of the soil of `texture`, which all soils of it share.
+  static const SoilProfile &Profile(const Texture texture);
+
+  // The top layer holds `water_content_layer_1` and every layer below it
+  // `water_content_layer_2` (m3 m-3).
   Soil(const Texture texture, const double pH, const double salinity,
        const double organic_matter, const double water_content_layer_1,
        const double water_content_layer_2);
+  // `water_content` holds the water content of each layer of the profile of
+  // `texture`, top down.
+  Soil(const Texture texture, const double pH, const double salinity,
+       const double organic_matter, const std::vector<double> &water_content);
 
-  void UpdateWaterContent(double rainfall,
-                          double total_flux_density_sunlit_potential,
-                          double total_flux_density_shaded_potential);
+  // Updates the water content given the rainfall (mm) and the latent heat of
+  // the evaporation from the soil and of the transpiration of the crop
+  // (J m^-2) over the `days` since the last update.
+  void UpdateWaterContent(double rainfall, double latent_heat_soil,
+                          double latent_heat_crop, double days);
 
   void AddWaterToSoil(double water_amount);
 
+  // Sets the water content of `layer`, e.g. after water has flowed between
+  // cells.
+  void set_water_content(const size_t layer, const double water_content) {
+    water_content_[layer] = water_content;
+  }
+
   double pH() const { return pH_; }
   double salinity() const { return salinity_; }
   double organic_matter() const { return organic_matter_; }
   Texture texture() const { return texture_; }
-  const WaterBalance::DailyWaterContentReturn &water_content() const {
-    return water_content_;
-  }
+  const SoilProfile &profile() const { return Profile(texture_); }
+  // The volumetric water content (m3 m-3) of each layer, top down.
+  const std::vector<double> &water_content() const { return water_content_; }
+  // The water content of the top layer, which evaporates.
+  double surface_water_content() const { return water_content_.front(); }
+  // The water content of the layers weighted by their fraction of the roots.
+  double root_zone_water_content() const;
 
  private:
   Texture texture_;
@@ -43,7 +65,7 @@ class Soil {
 
   Resources resources_;
 
-  WaterBalance::DailyWaterContentReturn water_content_;
+  std::vector<double> water_content_;
 };
 
 bool operator==(const Soil &lhs, const Soil &rhs);
@@ -1,5 +1,7 @@
 #include "soil_container.h"
 
+#include "environment/meteorology.h"
+
 namespace environment {
 
 SoilContainer::SoilContainer(const size_t size)
@@ -23,4 +25,66 @@ const Soil &SoilContainer::GetSoil(const Coordinate &coordinate) const {
   return operator[](coordinate);
 }
 
+void SoilContainer::UpdateWaterContent(
+    const std::vector<Coordinate> &coordinates, const double rainfall,
+    const std::vector<double> &latent_heat_flux_soil,
+    const std::vector<double> &latent_heat_flux_crop, const double seconds,
+    std::vector<Coordinate> *changed_cells) {
+  for (const Soil::Texture texture : {Soil::CLAY, Soil::SILT, Soil::SAND}) {
+    soils_.clear();
+    cells_.clear();
+    latent_heat_soil_.clear();
+    latent_heat_crop_.clear();
+    for (size_t i = 0; i < coordinates.size(); ++i) {
+      Soil &soil = operator[](coordinates[i]);
+      if (soil.texture() == texture) {
+        soils_.push_back(&soil);
+        cells_.push_back(i);
+        latent_heat_soil_.push_back(latent_heat_flux_soil[i] * seconds);
+        latent_heat_crop_.push_back(latent_heat_flux_crop[i] * seconds);
+      }
+    }
+    if (soils_.empty()) {
+      continue;
+    }
+
+    const SoilProfile &profile = Soil::Profile(texture);
+    const size_t num_cells = soils_.size();
+    const size_t num_layers = profile.num_layers();
+    water_content_.resize(num_layers * num_cells);
+    for (size_t i = 0; i < num_cells; ++i) {
+      const std::vector<double> &water_content = soils_[i]->water_content();
+      for (size_t k = 0; k < num_layers; ++k) {
+        water_content_[k * num_cells + i] = water_content[k];
+      }
+    }
+    rainfall_.assign(num_cells, rainfall);
+    evaporation_.resize(num_cells);
+    percolation_.resize(num_cells);
+    WaterBalance::UpdateWaterContent(
+        profile, num_cells, seconds / kSecsPerDay, rainfall_.data(),
+        latent_heat_soil_.data(), latent_heat_crop_.data(),
+        water_content_.data(), evaporation_.data(), percolation_.data());
+    for (size_t i = 0; i < num_cells; ++i) {
+      bool changed = false;
+      for (size_t k = 0; k < num_layers; ++k) {
+        const double water_content = water_content_[k * num_cells + i];
+        changed |= water_content != soils_[i]->water_content()[k];
+        soils_[i]->set_water_content(k, water_content);
+      }
+      if (changed && changed_cells != nullptr) {
+        changed_cells->push_back(coordinates[cells_[i]]);
+      }
+    }
+  }
+}
+
+void SoilContainer::UpdateWaterContent(
+    const std::vector<Coordinate> &coordinates, const double rainfall,
+    const double seconds, std::vector<Coordinate> *changed_cells) {
+  no_latent_heat_.assign(coordinates.size(), 0.0);
+  UpdateWaterContent(coordinates, rainfall, no_latent_heat_, no_latent_heat_,
+                     seconds, changed_cells);
+}
+
 }  // namespace environment
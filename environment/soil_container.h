@@ -16,6 +16,9 @@ class SoilContainer : private std::vector<std::vector<Soil>> {
   // soil instances are dumb instances.
   SoilContainer(const size_t size);
 
+  // The number of cells along each side of the grid.
+  using std::vector<std::vector<Soil>>::size;
+
   // Retrieves a soil instance by giving its position (`struct Coordinate`).
   // For example, (*this)[Coordinate(1, 2)] fetches the soil on coordinate (1, 2).
   Soil &operator[](const Coordinate &coordinate);
@@ -24,6 +27,41 @@ class SoilContainer : private std::vector<std::vector<Soil>> {
   // Retrieves a soil instance by giving its position (`struct Coordinate`)
   Soil &GetSoil(const Coordinate &coordinate);
   const Soil &GetSoil(const Coordinate &coordinate) const;
+
+  // Updates the water content of the soil on `coordinates` given the rainfall
+  // (mm) and the latent heat fluxes (W m^-2) of the evaporation from the soil
+  // and of the transpiration of the crop on each of them, in the same order,
+  // over `seconds`. The cells whose water content changed are appended to
+  // `changed_cells` unless it is null. The soils of each profile are gathered
+  // layer by layer, so that the water balance of a layer is computed for all
+  // of them at once.
+  void UpdateWaterContent(const std::vector<Coordinate> &coordinates,
+                          const double rainfall,
+                          const std::vector<double> &latent_heat_flux_soil,
+                          const std::vector<double> &latent_heat_flux_crop,
+                          const double seconds,
+                          std::vector<Coordinate> *changed_cells = nullptr);
+
+  // Updates the water content of the soil on `coordinates` given the rainfall
+  // (mm) alone over `seconds`, for the cells which neither evaporate nor
+  // transpire.
+  void UpdateWaterContent(const std::vector<Coordinate> &coordinates,
+                          const double rainfall, const double seconds,
+                          std::vector<Coordinate> *changed_cells = nullptr);
+
+ private:
+  // The cells being updated, their index in the coordinates, and their
+  // inputs and water content, layer-major. Reused by every update.
+  std::vector<Soil *> soils_;
+  std::vector<size_t> cells_;
+  std::vector<double> rainfall_;
+  std::vector<double> latent_heat_soil_;
+  std::vector<double> latent_heat_crop_;
+  std::vector<double> water_content_;
+  std::vector<double> evaporation_;
+  std::vector<double> percolation_;
+  // The latent heat of the cells which neither evaporate nor transpire.
+  std::vector<double> no_latent_heat_;
 };
 
 }  // namespace environment
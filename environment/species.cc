@@ -0,0 +1,50 @@
+#include "species.h"
+
+namespace environment {
+
+bool SpeciesRegistry::RegisterSpecies(std::unique_ptr<Species> species) {
+  const SpeciesId id = species->id();
+  if (!id.valid()) {
+    return false;
+  }
+  auto &all = SpeciesRegistry::species();
+  if (all.size() <= id.value()) {
+    all.resize(id.value() + 1);
+  }
+  if (all[id.value()] != nullptr) {
+    return false;
+  }
+  all[id.value()] = std::move(species);
+  return true;
+}
+
+void SpeciesRegistry::UnregisterSpecies(const SpeciesId id) {
+  auto &all = species();
+  if (id.value() < all.size()) {
+    all[id.value()].reset();
+  }
+}
+
+const Species *SpeciesRegistry::GetSpecies(const SpeciesId id) {
+  const auto &all = species();
+  return id.value() < all.size() ? all[id.value()].get() : nullptr;
+}
+
+std::vector<std::string> SpeciesRegistry::GetSpeciesList() {
+  std::vector<std::string> species_list;
+
+  for (const auto &species : species()) {
+    if (species != nullptr) {
+      species_list.push_back(species->name());
+    }
+  }
+
+  return species_list;
+}
+
+std::vector<std::unique_ptr<Species>> &SpeciesRegistry::species() {
+  static std::vector<std::unique_ptr<Species>> species;
+  return species;
+}
+
+}  // namespace environment
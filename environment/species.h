@@ -0,0 +1,148 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SPECIES_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SPECIES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "environment/plant.h"
+#include "environment/resource.h"
+#include "environment/species_id.h"
+
+namespace environment {
+
+// A kind of plant. All plants of a species share its parameters, and they are
+// grown together by its kernel, so that a field of one crop costs one virtual
+// call per time step instead of one per plant.
+class Species {
+ public:
+  virtual ~Species() {}
+
+  SpeciesId id() const { return id_; }
+  const std::string &name() const { return id_.name(); }
+  // The parameters shared by all plants of this species.
+  const PlantParams &params() const { return params_; }
+
+  // Grows the `count` plants in `plants`, which are all of this species and
+  // override none of its parameters, as if GrowStep was called on each of
+  // them. Returns the resources consumed by all of them.
+  virtual Resources GrowBatch(Plant *const *plants, const size_t count,
+                              const int64_t num_time_step,
+                              const GrowthConditions &conditions,
+                              const Resources &available) const = 0;
+  // As GrowBatch, but as if GrowDays was called on each plant.
+  virtual Resources GrowBatchDays(Plant *const *plants, const size_t count,
+                                  const int64_t num_days,
+                                  const GrowthConditions &conditions,
+                                  const Resources &available) const = 0;
+
+ protected:
+  Species(const std::string &name, const PlantParams &params)
+      : id_(SpeciesId::Intern(name)), params_(params) {}
+
+  static Plant::GrowthState *mutable_growth_state(Plant *plant) {
+    return &plant->growth_;
+  }
+
+ private:
+  SpeciesId id_;
+  PlantParams params_;
+};
+
+// A species whose plants grow by the model `Model`, a struct of the form
+//
+//   struct Model {
+//     // the parameters used by the model, in the units it computes in
+//     struct Params { ... };
+//     static Params MakeParams(const PlantParams &params);
+//     // Grows one plant, adds the resources it consumed to `consumed`.
+//     static void Grow(const Params &params, Plant::GrowthState *state,
+//                      int64_t num_time_step,
+//                      const GrowthConditions &conditions,
+//                      const Resources &available, Resources *consumed);
+//     // The same for whole days, see Plant::GrowDays.
+//     static void GrowDays(const Params &params, Plant::GrowthState *state,
+//                          int64_t num_days,
+//                          const GrowthConditions &conditions,
+//                          const Resources &available, Resources *consumed);
+//   };
+//
+// The kernel is compiled for each model, so that `Grow` is inlined into the
+// loop over the plants and its parameters are converted once per species.
+template <typename Model>
+class ModelSpecies : public Species {
+ public:
+  ModelSpecies(const std::string &name, const PlantParams &params)
+      : Species(name, params), model_params_(Model::MakeParams(params)) {}
+
+  Resources GrowBatch(Plant *const *plants, const size_t count,
+                      const int64_t num_time_step,
+                      const GrowthConditions &conditions,
+                      const Resources &available) const override {
+    Resources consumed;
+    for (size_t i = 0; i < count; ++i) {
+      Model::Grow(model_params_, mutable_growth_state(plants[i]),
+                  num_time_step, conditions, available, &consumed);
+    }
+    return consumed;
+  }
+
+  Resources GrowBatchDays(Plant *const *plants, const size_t count,
+                          const int64_t num_days,
+                          const GrowthConditions &conditions,
+                          const Resources &available) const override {
+    Resources consumed;
+    for (size_t i = 0; i < count; ++i) {
+      Model::GrowDays(model_params_, mutable_growth_state(plants[i]), num_days,
+                      conditions, available, &consumed);
+    }
+    return consumed;
+  }
+
+ private:
+  const typename Model::Params model_params_;
+};
+
+// A non-instantiable class holding the registered species by id.
+class SpeciesRegistry {
+ public:
+  // Registers `species` under its name if not already registered. Returns
+  // true upon success.
+  static bool RegisterSpecies(std::unique_ptr<Species> species);
+
+  // Unregisters the species named `name`, if present.
+  static void UnregisterSpecies(const SpeciesId id);
+
+  // Returns the species of `id`, or nullptr if there is none.
+  static const Species *GetSpecies(const SpeciesId id);
+
+  // Returns a list of all registered species names
+  static std::vector<std::string> GetSpeciesList();
+
+ private:
+  SpeciesRegistry() {}
+
+  // Indexed by id. Constructed on first use, as species are registered by
+  // static initializers in other translation units.
+  static std::vector<std::unique_ptr<Species>> &species();
+};
+
+#define DEF_SPECIES(_MODEL, _NAME, _PARAMS)                                   \
+  class _MODEL##_species_class {                                              \
+   public:                                                                    \
+    _MODEL##_species_class() {                                                \
+      SpeciesRegistry::RegisterSpecies(                                       \
+          std::make_unique<ModelSpecies<_MODEL>>(_NAME, _PARAMS));            \
+    }                                                                         \
+    ~_MODEL##_species_class() { SpeciesRegistry::UnregisterSpecies(_NAME); }  \
+  };
+
+#define ADD_SPECIES(_MODEL, _NAME, _PARAMS) \
+  DEF_SPECIES(_MODEL, _NAME, _PARAMS);      \
+  static _MODEL##_species_class _MODEL##_species_singleton;
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SPECIES_H_
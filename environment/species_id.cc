@@ -0,0 +1,56 @@
+#include "species_id.h"
+
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+namespace environment {
+
+namespace {
+
+struct SpeciesTable {
+  // indexed by id, a deque so that returned names stay valid as it grows
+  std::deque<std::string> names;
+  std::unordered_map<std::string, uint16_t> ids;
+};
+
+// Constructed on first use, as names are interned by static initializers in
+// other translation units.
+SpeciesTable &Table() {
+  static SpeciesTable table = {{std::string()}, {}};
+  return table;
+}
+
+}  // namespace
+
+SpeciesId SpeciesId::Intern(const std::string &name) {
+  SpeciesTable &table = Table();
+  auto it = table.ids.find(name);
+  if (it != table.ids.end()) {
+    return SpeciesId(it->second);
+  }
+  if (name.empty() ||
+      table.names.size() > std::numeric_limits<uint16_t>::max()) {
+    return SpeciesId();
+  }
+
+  const uint16_t value = table.names.size();
+  table.names.push_back(name);
+  table.ids.emplace(name, value);
+  return SpeciesId(value);
+}
+
+SpeciesId SpeciesId::Find(const std::string &name) {
+  const SpeciesTable &table = Table();
+  auto it = table.ids.find(name);
+  return it == table.ids.end() ? SpeciesId() : SpeciesId(it->second);
+}
+
+size_t SpeciesId::size() { return Table().names.size(); }
+
+const std::string &SpeciesId::name() const {
+  const SpeciesTable &table = Table();
+  return value_ < table.names.size() ? table.names[value_] : table.names[0];
+}
+
+}  // namespace environment
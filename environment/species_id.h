@@ -0,0 +1,61 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SPECIES_ID_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SPECIES_ID_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace environment {
+
+// A small integer handle of a plant species name, e.g. "bean". Names are
+// interned once when their models are registered, so that plants, actions and
+// messages carry two bytes instead of a string and never hash it again.
+//
+// Interning is not synchronized with lookups, as the registration of models;
+// names should be interned before threads look them up.
+class SpeciesId {
+ public:
+  // The id of no species.
+  constexpr SpeciesId() : value_(0) {}
+  constexpr explicit SpeciesId(const uint16_t value) : value_(value) {}
+  // Looks up the id of `name`, which is invalid if it was never interned.
+  // Implicit, so that names can be passed wherever an id is expected.
+  SpeciesId(const std::string &name) : SpeciesId(Find(name)) {}
+  SpeciesId(const char *name) : SpeciesId(Find(name)) {}
+
+  // Returns the id of `name`, assigning the next free one if it has none.
+  // Returns an invalid id if all ids are taken.
+  static SpeciesId Intern(const std::string &name);
+  // Returns the id of `name`, or an invalid id.
+  static SpeciesId Find(const std::string &name);
+  // The number of ids, valid or not, i.e. one more than the largest id.
+  static size_t size();
+
+  uint16_t value() const { return value_; }
+  bool valid() const { return value_ != 0; }
+  // The interned name, empty for an invalid id.
+  const std::string &name() const;
+
+  bool operator==(const SpeciesId &rhs) const { return value_ == rhs.value_; }
+  bool operator!=(const SpeciesId &rhs) const { return value_ != rhs.value_; }
+  bool operator<(const SpeciesId &rhs) const { return value_ < rhs.value_; }
+
+ private:
+  uint16_t value_;
+};
+
+}  // namespace environment
+
+namespace std {
+
+template <>
+struct hash<environment::SpeciesId> {
+  size_t operator()(const environment::SpeciesId &id) const {
+    return id.value();
+  }
+};
+
+}  // namespace std
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_SPECIES_ID_H_
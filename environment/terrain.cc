@@ -1,6 +1,7 @@
 #include "terrain.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <vector>
 
 #include "environment/meteorology.h"
@@ -14,12 +15,54 @@ Terrain::Terrain(const config::TerrainRawData &terrain_raw_data,
     : size_(terrain_raw_data.size),
       yield_(terrain_raw_data.yield),
       soil_container_(terrain_raw_data.size),
-      meteorology_(meteorology) {}
+      meteorology_(meteorology),
+      changes_begin_(0),
+      last_change_(size_ * size_, 0) {}
 
 void Terrain::ExecuteAction(const agent::action::Action &action) {
   action.Execute(this);
 }
 
+size_t Terrain::CellIndex(const Coordinate &coordinate) const {
+  return size_t(coordinate.x) * size_ + size_t(coordinate.y);
+}
+
+void Terrain::MarkCellChanged(const Coordinate &coordinate) {
+  if (coordinate.x < 0 || coordinate.x >= size_ || coordinate.y < 0 ||
+      coordinate.y >= size_) {
+    return;
+  }
+  const size_t cell = CellIndex(coordinate);
+
+  // keep a few changes per cell, dropping the older half at once
+  const size_t max_kept = std::max<size_t>(64, 4 * last_change_.size());
+  if (changed_cells_.size() >= max_kept) {
+    const size_t dropped = changed_cells_.size() / 2;
+    changed_cells_.erase(changed_cells_.begin(),
+                         changed_cells_.begin() + dropped);
+    changes_begin_ += dropped;
+  }
+  // even a change of the cell changed last, which may have been read since;
+  // `ChangedCellsSince` reports each cell once
+  changed_cells_.push_back(cell);
+  last_change_[cell] = num_changes();
+}
+
+bool Terrain::ChangedCellsSince(const uint64_t since,
+                                std::vector<size_t> *cells) const {
+  if (since < changes_begin_) {
+    return false;
+  }
+  for (uint64_t i = since; i < num_changes(); ++i) {
+    const size_t cell = changed_cells_[i - changes_begin_];
+    // skip all but the latest change of a cell
+    if (last_change_[cell] == i + 1) {
+      cells->push_back(cell);
+    }
+  }
+  return true;
+}
+
 std::ostream &operator<<(std::ostream &os, const Terrain &terrain) {
   // TODO: add output
   os << "this is plant." << std::endl;
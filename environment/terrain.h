@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <memory>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -41,6 +42,25 @@ class Terrain {
   // Modifiers
   void ExecuteAction(const agent::action::Action &action);
 
+  // Changes are recorded per cell, so that whatever observes the terrain only
+  // has to look at the cells which changed. The cell of `coordinate` is
+  // numbered `x * size() + y`.
+  size_t CellIndex(const Coordinate &coordinate) const;
+  // Records that the soil or the plant on `coordinate` changed. Coordinates
+  // outside of the terrain are ignored.
+  void MarkCellChanged(const Coordinate &coordinate);
+  // The number of changes recorded so far, to be passed to `ChangedCellsSince`
+  // later on.
+  uint64_t num_changes() const {
+    return changes_begin_ + changed_cells_.size();
+  }
+  // Appends the cells changed since `num_changes()` returned `since` to
+  // `cells`, each of them once. Only the most recent changes are kept; returns
+  // false if some of those are gone, in which case every cell may have
+  // changed.
+  bool ChangedCellsSince(const uint64_t since,
+                         std::vector<size_t> *cells) const;
+
  private:
   friend std::ostream &operator<<(std::ostream &os, const Terrain &terrain);
 
@@ -57,6 +77,13 @@ class Terrain {
   int yield_;
   // TODO: Now we assume the terrain to be a square space.
   size_t size_;
+
+  // The most recent changes, in order, and the number of older changes which
+  // were dropped.
+  std::vector<size_t> changed_cells_;
+  uint64_t changes_begin_;
+  // For each cell, one past the number of its latest change, or 0.
+  std::vector<uint64_t> last_change_;
 };
 
 std::ostream &operator<<(std::ostream &os, const Terrain &terrain);
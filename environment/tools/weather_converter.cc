@@ -0,0 +1,37 @@
+// Converts the daily records of weather stations in CSV files into binary
+// weather series (see binary_weather.h), which are mapped into memory instead
+// of being parsed when an environment reads its weather.
+//
+// Usage: weather_converter <records.csv>...
+// Each series is written next to its source with the `.weather` extension.
+#include <iostream>
+#include <string>
+
+#include "environment/binary_weather.h"
+#include "environment/weather_series.h"
+
+using environment::WeatherSeries;
+namespace binaryweather = environment::binaryweather;
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <records.csv>..." << std::endl;
+    return 1;
+  }
+
+  int ret = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string filename(argv[i]);
+    const std::string output = filename.substr(0, filename.find_last_of('.')) +
+                               binaryweather::kExtension;
+    if (!WeatherSeries::ConvertCsv(filename, output)) {
+      std::cerr << "Unable to write " << output << std::endl;
+      ret = 1;
+      continue;
+    }
+    const WeatherSeries series(output);
+    std::cout << filename << " -> " << output << " (" << series.num_days()
+              << " days)" << std::endl;
+  }
+  return ret;
+}
@@ -1,6 +1,10 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_UTILITY_H_
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_UTILITY_H_
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <utility>
 
@@ -30,6 +34,66 @@ bool operator!=(const MinMaxPair<T> &lhs, const MinMaxPair<T> &rhs) {
   return !(lhs == rhs);
 }
 
+// A fixed-size array indexed by the values of the enum `E`, which have to run
+// from 0 to `N` - 1. Unlike a map, it needs neither hashing nor allocation:
+// every entry exists and starts as `T()`.
+template <typename E, typename T, size_t N>
+class EnumArray {
+ public:
+  EnumArray() : values_() {}
+  // Sets the listed entries, the others are `T()`.
+  EnumArray(const std::initializer_list<std::pair<E, T>> &entries)
+      : values_() {
+    for (const auto &entry : entries) {
+      (*this)[entry.first] = entry.second;
+    }
+  }
+
+  static constexpr size_t size() { return N; }
+  // The key of the `i`-th entry.
+  static constexpr E key(const size_t i) { return static_cast<E>(i); }
+
+  T &operator[](const E key) { return values_[static_cast<size_t>(key)]; }
+  const T &operator[](const E key) const {
+    return values_[static_cast<size_t>(key)];
+  }
+
+  // Iterates over the values in the order of their keys.
+  T *begin() { return values_.data(); }
+  T *end() { return values_.data() + N; }
+  const T *begin() const { return values_.data(); }
+  const T *end() const { return values_.data() + N; }
+
+  bool operator==(const EnumArray &rhs) const { return values_ == rhs.values_; }
+  bool operator!=(const EnumArray &rhs) const { return !(*this == rhs); }
+
+ private:
+  std::array<T, N> values_;
+};
+
+// An id of an object which no other object has had. A copy, or an object
+// assigned to, draws a new one, so that caches can be keyed on the object
+// unlike on its address, which is reused once it is freed.
+class InstanceId {
+ public:
+  InstanceId() : value_(Next()) {}
+  InstanceId(const InstanceId &) : InstanceId() {}
+  InstanceId &operator=(const InstanceId &) {
+    value_ = Next();
+    return *this;
+  }
+
+  uint64_t value() const { return value_; }
+
+ private:
+  static uint64_t Next() {
+    static std::atomic<uint64_t> next(1);
+    return next++;
+  }
+
+  uint64_t value_;
+};
+
 // TODO: this `double` should be replaced with `degC`
 using MinMaxTemperature = MinMaxPair<double>;
 // TODO: this `double` should be replaced with `minimeter`
@@ -21,7 +21,8 @@ double WaterBalance::WaterContentBeforeRedistribution(
 }
 
 double WaterBalance::WaterContentAfterRedistribution(double soil_thickness,
-                                                     double water_content) {
+                                                     double water_content,
+                                                     double days) {
   double soil_thickness_mm =
       soil_thickness * kMeterToMillimeter;  // for conversion
   // From formula 5.3 on page 107
@@ -31,7 +32,7 @@ double WaterBalance::WaterContentAfterRedistribution(double soil_thickness,
   // From formula 5.20 on page 114, used to calculate new water content in soil
   double exp_expression = exp((hydraulic_slope / saturation_point) *
                               (saturation_point - volumetric_water_content));
-  double val_expression = (hydraulic_slope * saturated_hydraulic * interval) /
+  double val_expression = (hydraulic_slope * saturated_hydraulic * days) /
                           (soil_thickness * saturation_point);
   double log_expression = log(val_expression + exp_expression);
   double new_water_content =
@@ -43,44 +44,42 @@ double WaterBalance::WaterContentAfterRedistribution(double soil_thickness,
   return (new_water_content * soil_thickness_mm);  // convert back to mm
 }
 
-// Only the water amount in layer 1 is relevant for evaporation, so water amount
-// in layer 2 is ignored here
-WaterBalance::ActualEvaporationReturn WaterBalance::ActualEvaporation(
-    double potential_evaporation, double water_amount_layer_1) {
+// Only the water amount in the top layer is relevant for evaporation, so the
+// layers below are ignored here
+double WaterBalance::ActualEvaporation(double potential_evaporation,
+                                       double surface_water_content) {
   // Formula 5.24 on page 115
   // Calculates reduction of evaporation based on water content, constants from
   // experiments
   double pow_expression =
-      pow((3.6073 * water_amount_layer_1 / saturated_hydraulic), -9.3172);
+      pow((3.6073 * surface_water_content / saturated_hydraulic), -9.3172);
   double reduction_factor = 1.0 / (1.0 + pow_expression);
-  // Formula 5.25 on page on page 115
-  return {
-      potential_evaporation * reduction_factor * 0.26,  // layer 1
-      potential_evaporation * reduction_factor * 0.74   // layer 2
-  };
+  // Formula 5.25 on page on page 115 splits it between the layers by the
+  // evaporation fractions of the profile
+  return potential_evaporation * reduction_factor;
 }
 
-WaterBalance::ActualTranspirationReturn WaterBalance::ActualTranspiration(
-    double photosynthesis_efficiency, double potential_transpiration,
-    double water_amount_2) {
+double WaterBalance::ActualTranspiration(double photosynthesis_efficiency,
+                                         double potential_transpiration,
+                                         double water_content) {
   // volumetric water content critical point occurs when reduction factor = 1
   // Formula 5.29 on page 117
   double critical_point =
       wilting_point +
       photosynthesis_efficiency * (saturation_point - wilting_point);
   double reduction_factor =
-      (water_amount_2 - wilting_point) / (critical_point - wilting_point);
+      (water_content - wilting_point) / (critical_point - wilting_point);
   // Reduction factor can't exceed 1.0
   if (reduction_factor > 1.0) {
     reduction_factor = 1.0;
   }
-  return {0.0, potential_transpiration * reduction_factor};
+  return potential_transpiration * reduction_factor;
 }
 
 WaterBalance::VolumetricWaterContentReturn WaterBalance::VolumetricWaterContent(
     double soil_thickness, double volumetric_water_content,
     double actual_evaporation, double actual_transpiration,
-    double percolation_from_above) {
+    double percolation_from_above, double days) {
   double soil_thickness_mm =
       soil_thickness * kMeterToMillimeter;  // for conversions
   double water_content_before =
@@ -88,7 +87,8 @@ WaterBalance::VolumetricWaterContentReturn WaterBalance::VolumetricWaterContent(
   water_content_before = WaterContentBeforeRedistribution(
       soil_thickness, water_content_before, percolation_from_above);
   double water_content_after =
-      WaterContentAfterRedistribution(soil_thickness, water_content_before);
+      WaterContentAfterRedistribution(soil_thickness, water_content_before,
+                                      days);
   water_content_after =
       water_content_after - actual_evaporation - actual_transpiration;
   if (water_content_after < 0.0) {
@@ -102,35 +102,42 @@ WaterBalance::VolumetricWaterContentReturn WaterBalance::VolumetricWaterContent(
   return {water_content_after / soil_thickness_mm, percolation_to_below};
 }
 
-// TODO: When calling this function,
-//    Get dETs and dETc from "meteorology.cc" file, from
-//    UpdateHourlyNetRadiation (or maybe some other function)
-WaterBalance::DailyWaterContentReturn WaterBalance::DailyWaterContent(
-    double rainfall, double water_amount_1, double water_amount_2, double dETs,
-    double dETc) {
-  double potential_evaporation = dETs * portential_factor;
-  double potential_transpiration = dETc * portential_factor;
-  ActualEvaporationReturn actual_evaporation =
-      ActualEvaporation(potential_evaporation, water_amount_1);
-  ActualTranspirationReturn actual_transpiration = ActualTranspiration(
-      photosynthesis_efficiency_c3, potential_transpiration, water_amount_2);
-  VolumetricWaterContentReturn water_content_layer_1 = VolumetricWaterContent(
-      depth_1, water_amount_1, actual_evaporation.layer_1,
-      actual_transpiration.layer_1, rainfall);
-  VolumetricWaterContentReturn water_content_layer_2 = VolumetricWaterContent(
-      depth_2, water_amount_2, actual_evaporation.layer_2,
-      actual_transpiration.layer_2, water_content_layer_1.percolation_to_below);
-  return {water_content_layer_1.volumetric_water_content,
-          water_content_layer_2.volumetric_water_content};
+void WaterBalance::UpdateWaterContent(
+    const SoilProfile &profile, const size_t num_cells, const double days,
+    const double *rainfall, const double *latent_heat_soil,
+    const double *latent_heat_crop, double *water_content, double *evaporation,
+    double *percolation) {
+  // the evaporation depends on the top layer before it is updated, and the
+  // rainfall percolates into it
+  for (size_t i = 0; i < num_cells; ++i) {
+    evaporation[i] = ActualEvaporation(
+        latent_heat_soil[i] * portential_factor, water_content[i]);
+    percolation[i] = rainfall[i];
+  }
+  for (size_t k = 0; k < profile.num_layers(); ++k) {
+    const SoilLayer &layer = profile.layers[k];
+    double *layer_water_content = water_content + k * num_cells;
+    for (size_t i = 0; i < num_cells; ++i) {
+      const double transpiration = ActualTranspiration(
+          photosynthesis_efficiency_c3,
+          layer.root_fraction * latent_heat_crop[i] * portential_factor,
+          layer_water_content[i]);
+      const VolumetricWaterContentReturn result = VolumetricWaterContent(
+          layer.thickness, layer_water_content[i],
+          layer.evaporation_fraction * evaporation[i], transpiration,
+          percolation[i], days);
+      layer_water_content[i] = result.volumetric_water_content;
+      percolation[i] = result.percolation_to_below;
+    }
+  }
 }
 
 // Fraction of growth reduced due to limited water. potT is potential
 //   transpiration (mm day-1).
 double WaterBalance::GrowthReduction(double potential_transpiration,
-                                     double water_amount_2) {
-  ActualTranspirationReturn actual_transpiration = ActualTranspiration(
-      photosynthesis_efficiency_c3, potential_transpiration, water_amount_2);
-  return (actual_transpiration.layer_2 /
+                                     double water_content) {
+  return (ActualTranspiration(photosynthesis_efficiency_c3,
+                              potential_transpiration, water_content) /
           potential_transpiration);  // fraction (0 to 1)
 }
 
@@ -1,53 +1,63 @@
 #ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WATER_BALANCE_H_
 #define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WATER_BALANCE_H_
 
-#include <utility>
+#include <cstddef>
+#include <vector>
 
 namespace environment {
 
+// A layer of a soil profile.
+struct SoilLayer {
+  // thickness (m)
+  double thickness;
+  // the fractions of the evaporation from the soil and of the transpiration of
+  // the crop drawn from this layer, each summing to 1 over the profile
+  double evaporation_fraction;
+  double root_fraction;
+};
+
+// The layers of a column of soil, top down. Water percolates from each layer
+// into the next one.
+struct SoilProfile {
+  std::vector<SoilLayer> layers;
+
+  size_t num_layers() const { return layers.size(); }
+};
+
 class WaterBalance {
  public:
-  // This struct returns the amount of water in both layers of soil.
-  //   For modelling purposes, the soil is treated as having only two layers
-  //   which interact with each other, and hold separate contents.
-  struct DailyWaterContentReturn {
-    double water_amount_1;
-    double water_amount_2;
-  };
-
-  // Final volumetric water content (m3 m-3) for the two soil layers. (mm
-  // day-1).
-  static DailyWaterContentReturn DailyWaterContent(double rainfall,
-                                                   double water_amount_1,
-                                                   double water_amount_2,
-                                                   double dETs, double dETc);
+  // Updates the volumetric water content (m3 m-3) of `num_cells` columns of
+  // soil of `profile` over `days`, stored layer-major: layer k of cell i at
+  //   water_content[k * num_cells + i].
+  // rainfall = rainfall (mm) by cell
+  // latent_heat_soil and latent_heat_crop = latent heat of the evaporation
+  //   from the soil and of the transpiration of the crop (J m-2) by cell
+  // evaporation and percolation = one value by cell, overwritten with the
+  //   actual evaporation and the percolation from the layer above as the
+  //   update goes down the layers.
+  // Each layer is updated for all cells before the next one, so the work of a
+  // layer is a loop over contiguous cells.
+  static void UpdateWaterContent(const SoilProfile &profile,
+                                 const size_t num_cells, const double days,
+                                 const double *rainfall,
+                                 const double *latent_heat_soil,
+                                 const double *latent_heat_crop,
+                                 double *water_content, double *evaporation,
+                                 double *percolation);
 
   // Fraction of growth reduced due to limited water. potT is potential
-  //   transpiration (mm day-1).
+  //   transpiration (mm day-1), water_content the volumetric water content of
+  //   the root zone (m3 m-3).
   static double GrowthReduction(double potential_transpiration,
-                                double water_amount_2);
+                                double water_content);
 
  private:
   // The purpose of making the constructor private is to prevent initialization
   // of the class, because all functions in this class are static
   WaterBalance() {}
 
-  // This struct describes the amount of water that is evaporated from each
-  //   layer of the soil, since depths affects how much surface area is exposed.
-  //   Actual evaporation is calculated by multiplying the potential evaporation
-  //   by some reduction factor.
-  struct ActualEvaporationReturn {
-    double layer_1;
-    double layer_2;
-  };
-
-  // This struct describes the amount of water that is transpired from each
-  //   layer of the soil, since depths affects how much surface area is exposed.
-  //   Transpiration is the process of water loss from plants through stomata.
-  struct ActualTranspirationReturn {
-    double layer_1;
-    double layer_2;
-  };
+  // shares the hydraulic properties of the soil
+  friend class LateralFlow;
 
   struct VolumetricWaterContentReturn {
     double volumetric_water_content;
@@ -66,21 +76,28 @@ class WaterBalance {
   // Water content after redistribution (mm)
   //   soil_thickness = soil layer thickness (m)
   //   water_content = current water content (m3 m-3)
+  //   days = time the water drains over (days)
   static double WaterContentAfterRedistribution(double soil_thickness,
-                                                double water_content);
+                                                double water_content,
+                                                double days);
 
-  // Actual soil evaporation (mm day-1)
+  // Actual soil evaporation (mm day-1), to be split between the layers.
+  //   Actual evaporation is calculated by multiplying the potential
+  //   evaporation by a reduction factor depending on the surface layer.
   //   potential_evaporation = potential soil evaporation (mm day-1)
-  static ActualEvaporationReturn ActualEvaporation(double potential_evaporation,
-                                                   double water_amount_1);
+  //   surface_water_content = water content of the top layer (m3 m-3)
+  static double ActualEvaporation(double potential_evaporation,
+                                  double surface_water_content);
 
-  // Actual plant transpiration (mm day-1)
+  // Actual plant transpiration from a layer (mm day-1)
   //   photosynthesis_efficiency = 0.5 or 0.3 for C3 and C4 plants,
   //   respectively, represents photosynthesis efficiency
-  //   potential_transpiration = potential soil transpiration (mm day-1)
-  static ActualTranspirationReturn ActualTranspiration(
-      double photosynthesis_efficiency, double potential_transpiration,
-      double water_amount_2);
+  //   potential_transpiration = potential transpiration from the layer (mm
+  //   day-1)
+  //   water_content = water content of the layer (m3 m-3)
+  static double ActualTranspiration(double photosynthesis_efficiency,
+                                    double potential_transpiration,
+                                    double water_content);
 
   // Final volumetric water content (m3 m-3)
   //   soil_thickness = soil layer thickness (m)
@@ -88,19 +105,17 @@ class WaterBalance {
   //   actual_evaporation and actual_transpiration = actual evaporation and
   //   transpiration (mm day-1) percolation_from_above = percolation from above
   //   (mm day-1)
+  //   days = time the water drains over (days)
   static VolumetricWaterContentReturn VolumetricWaterContent(
       double soil_thickness, double volumetric_water_content,
       double actual_evaporation, double actual_transpiration,
-      double percolation_from_above);
+      double percolation_from_above, double days);
 
   // Values based on "input.txt" file from original code
   static constexpr double saturation_point = 0.39;
   static constexpr double wilting_point = 0.07;
   static constexpr double hydraulic_slope = 14.5;
   static constexpr double saturated_hydraulic = 0.19;
-  static constexpr int interval = 5;
-  static constexpr double depth_1 = 0.02;
-  static constexpr double depth_2 = 0.03;
   static constexpr double photosynthesis_efficiency_c3 = 0.05;
   // Explained on page 71, it's the amount of energy required to convert 1 kg of
   // liquid water to vapor, without any change in temperature (joules)
@@ -9,7 +9,8 @@
 
 namespace environment {
 
-// Represents everyday weather
+// Represents everyday weather. Weather of a series of days is read from a
+// `WeatherSeries`.
 struct Weather {
   Weather(const double total_sunshine_hour, const double air_temp_min,
           const double air_temp_max, const double relative_humidity,
@@ -19,11 +20,11 @@ struct Weather {
           const double relative_humidity, const double wind_speed,
           const double rainfall);
 
-  const double total_sunshine_hour;
-  const MinMaxTemperature air_temperature;
-  const double relative_humidity;
-  const double wind_speed;
-  const double rainfall;
+  double total_sunshine_hour;
+  MinMaxTemperature air_temperature;
+  double relative_humidity;
+  double wind_speed;
+  double rainfall;
 };
 
 bool operator==(const Weather &lhs, const Weather &rhs);
@@ -0,0 +1,96 @@
+#include "weather_generator.h"
+
+#include <algorithm>
+#include <ctime>
+
+namespace environment {
+
+WeatherGenerator::WeatherGenerator(
+    const std::chrono::duration<int> &time_step_length)
+    : step_seconds_(std::max(
+          int(std::chrono::duration_cast<std::chrono::seconds>(time_step_length)
+                  .count()),
+          1)),
+      num_steps_((kSecsPerDay + step_seconds_ - 1) / step_seconds_),
+      day_of_year_(0),
+      weather_(0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+      num_generated_days_(0),
+      solar_hour_(num_steps_),
+      solar_elevation_(num_steps_),
+      solar_azimuth_(num_steps_),
+      total_irradiance_(num_steps_),
+      direct_irradiance_(num_steps_),
+      diffuse_irradiance_(num_steps_),
+      net_radiation_(num_steps_),
+      air_temperature_(num_steps_),
+      saturated_vapor_pressure_(num_steps_),
+      actual_vapor_pressure_(num_steps_) {}
+
+void WeatherGenerator::Update(
+    const std::chrono::system_clock::time_point &local_time,
+    const Weather &weather, Meteorology *meteorology) {
+  // localtime() is not safe to call from environments stepped in parallel
+  const time_t tt = std::chrono::system_clock::to_time_t(local_time);
+  struct tm tm;
+  localtime_r(&tt, &tm);
+  const int day_of_year = tm.tm_yday + 1;
+  const int second =
+      tm.tm_sec + (kSecsPerMin * tm.tm_min) + (kSecsPerHour * tm.tm_hour);
+  if (second % step_seconds_ != 0) {
+    meteorology->Update(day_of_year, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                        weather);
+    return;
+  }
+
+  // Cautious: we are using the private update function.
+  if (int(meteorology->day_of_year_) != day_of_year) {
+    meteorology->UpdateDayOfYear(day_of_year);
+  }
+  if (day_of_year != day_of_year_ || !(weather == weather_)) {
+    Generate(weather, *meteorology);
+    day_of_year_ = day_of_year;
+    weather_ = weather;
+    ++num_generated_days_;
+  }
+
+  const size_t step = second / step_seconds_;
+  meteorology->local_solar_hour_ = solar_hour_[step];
+  meteorology->solar_elevation_ = solar_elevation_[step];
+  meteorology->solar_azimuth_ = solar_azimuth_[step];
+  meteorology->hourly_solar_irradiance_ = {total_irradiance_[step],
+                                           direct_irradiance_[step],
+                                           diffuse_irradiance_[step]};
+  meteorology->hourly_net_radiation_ = net_radiation_[step];
+  meteorology->air_temperature_ = air_temperature_[step];
+  meteorology->vapor_pressure_ = {saturated_vapor_pressure_[step],
+                                  actual_vapor_pressure_[step]};
+  meteorology->wind_speed_ = weather.wind_speed;
+}
+
+void WeatherGenerator::Generate(const Weather &weather,
+                                const Meteorology &meteorology) {
+  // Steps a copy through the day, so that the curves are what
+  // `Meteorology::Update()` would calculate at each step.
+  Meteorology day(meteorology);
+  for (size_t step = 0; step < num_steps_; ++step) {
+    const int second = int(step) * step_seconds_;
+    day.UpdateLocalTime(second / kSecsPerHour,
+                        second / kSecsPerMin % kMinsPerHour,
+                        second % kSecsPerMin);
+    day.UpdateWeather(weather);
+    day.UpdateHourlyNetRadiation(weather);
+
+    solar_hour_[step] = day.local_solar_hour_;
+    solar_elevation_[step] = day.solar_elevation_;
+    solar_azimuth_[step] = day.solar_azimuth_;
+    total_irradiance_[step] = day.hourly_solar_irradiance_.total;
+    direct_irradiance_[step] = day.hourly_solar_irradiance_.direct;
+    diffuse_irradiance_[step] = day.hourly_solar_irradiance_.diffuse;
+    net_radiation_[step] = day.hourly_net_radiation_;
+    air_temperature_[step] = day.air_temperature_;
+    saturated_vapor_pressure_[step] = day.vapor_pressure_.saturated;
+    actual_vapor_pressure_[step] = day.vapor_pressure_.actual;
+  }
+}
+
+}  // namespace environment
@@ -0,0 +1,61 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WEATHER_GENERATOR_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WEATHER_GENERATOR_H_
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "environment/meteorology.h"
+#include "environment/weather.h"
+
+namespace environment {
+
+// Generates the sub-daily weather of a `Meteorology` from the daily weather.
+// When the day or its weather changes, the diurnal curves of the sun, the
+// radiation, the air temperature, and the vapor pressure are calculated for
+// every time step of the day at once; the steps of the day then only read
+// them. The wind speed is constant over a day (see `Meteorology`), so it has no
+// curve.
+class WeatherGenerator {
+ public:
+  explicit WeatherGenerator(const std::chrono::duration<int> &time_step_length);
+
+  // Updates `meteorology` to `local_time` under the daily `weather`, as
+  // `Meteorology::Update()` does. A time which is not a whole number of time
+  // steps after the local midnight is calculated by `meteorology` instead.
+  void Update(const std::chrono::system_clock::time_point &local_time,
+              const Weather &weather, Meteorology *meteorology);
+
+  // The number of time steps a day is sampled at.
+  size_t num_steps() const { return num_steps_; }
+  // The number of days whose curves have been generated.
+  size_t num_generated_days() const { return num_generated_days_; }
+
+ private:
+  // Calculates the curves of the day of `meteorology` under `weather`.
+  void Generate(const Weather &weather, const Meteorology &meteorology);
+
+  const int step_seconds_;
+  const size_t num_steps_;
+
+  // The day of year and the weather of the curves, 0 if there are none.
+  int day_of_year_;
+  Weather weather_;
+  size_t num_generated_days_;
+
+  // The curves, by time step of the day.
+  std::vector<double> solar_hour_;
+  std::vector<double> solar_elevation_;
+  std::vector<double> solar_azimuth_;
+  std::vector<double> total_irradiance_;
+  std::vector<double> direct_irradiance_;
+  std::vector<double> diffuse_irradiance_;
+  std::vector<double> net_radiation_;
+  std::vector<double> air_temperature_;
+  std::vector<double> saturated_vapor_pressure_;
+  std::vector<double> actual_vapor_pressure_;
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WEATHER_GENERATOR_H_
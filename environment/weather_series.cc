@@ -0,0 +1,257 @@
+#include "weather_series.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "environment/meteorology.h"
+
+namespace environment {
+
+namespace {
+
+using Values = std::array<float, binaryweather::NUM_COLUMNS>;
+
+// A column of the CSV records, and the column of the series it is converted
+// into by multiplying it with `scale`.
+struct CsvColumn {
+  const char *name;
+  binaryweather::Column column;
+  float scale;
+};
+
+const CsvColumn kCsvColumns[] = {
+    {"PRCP", binaryweather::RAINFALL, 1.0f},
+    {"TMAX", binaryweather::AIR_TEMP_MAX, 1.0f},
+    {"TMIN", binaryweather::AIR_TEMP_MIN, 1.0f},
+    {"RHAV", binaryweather::RELATIVE_HUMIDITY, 1.0f},
+    {"AWND", binaryweather::WIND_SPEED, 1.0f},
+    {"TSUN", binaryweather::TOTAL_SUNSHINE_HOUR, 1.0f / kMinsPerHour}};
+
+// Returns the days since 1970-01-01 of the date `year`-`month`-`day` of the
+// Gregorian calendar.
+int64_t DaysFromCivil(int64_t year, const unsigned month, const unsigned day) {
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+  const unsigned day_of_year =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 -
+                              year_of_era / 100 + day_of_year;
+  return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+// Parses a date as YYYY-MM-DD into `day`, the days since 1970-01-01.
+bool ParseDate(const std::string &field, int64_t *day) {
+  int year, month, date;
+  if (std::sscanf(field.c_str(), "%d-%d-%d", &year, &month, &date) != 3 ||
+      month < 1 || month > 12 || date < 1 || date > 31) {
+    return false;
+  }
+  *day = DaysFromCivil(year, month, date);
+  return true;
+}
+
+// Returns the value of `field`, NaN if it is empty or not a number.
+float ParseValue(const std::string &field) {
+  const char *begin = field.c_str();
+  char *end;
+  const float value = std::strtof(begin, &end);
+  return end == begin ? std::numeric_limits<float>::quiet_NaN() : value;
+}
+
+// Splits a line of CSV into its fields, without the quotes around them.
+std::vector<std::string> SplitCsvLine(const std::string &line) {
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); ++i) {
+    const char c = line[i];
+    if (c == '"') {
+      // a doubled quote within quotes stands for itself
+      if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+        fields.back() += c;
+        ++i;
+      } else {
+        quoted = !quoted;
+      }
+    } else if (c == ',' && !quoted) {
+      fields.emplace_back();
+    } else if (c != '\r') {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+}  // namespace
+
+bool WeatherSeries::ConvertCsv(const std::string &csv_filename,
+                               const std::string &filename) {
+  std::ifstream file(csv_filename);
+  std::string line;
+  if (!file || !std::getline(file, line)) {
+    std::cerr << "Unable to read " << csv_filename << std::endl;
+    return false;
+  }
+  const std::vector<std::string> names = SplitCsvLine(line);
+  size_t date_index = names.size();
+  std::vector<std::pair<size_t, const CsvColumn *>> columns;
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i] == "DATE") {
+      date_index = i;
+    }
+    for (const CsvColumn &column : kCsvColumns) {
+      if (names[i] == column.name) {
+        columns.emplace_back(i, &column);
+      }
+    }
+  }
+  if (date_index == names.size()) {
+    std::cerr << csv_filename << " has no DATE column" << std::endl;
+    return false;
+  }
+
+  // The values of each day. A day recorded more than once, e.g. by several
+  // stations, takes the values of its first record which has them.
+  Values missing;
+  missing.fill(std::numeric_limits<float>::quiet_NaN());
+  std::map<int64_t, Values> records;
+  while (std::getline(file, line)) {
+    if (line.empty() || line == "\r") {
+      continue;
+    }
+    const std::vector<std::string> fields = SplitCsvLine(line);
+    int64_t day;
+    if (date_index >= fields.size() || !ParseDate(fields[date_index], &day)) {
+      std::cerr << csv_filename << " has a record without a valid date: "
+                << line << std::endl;
+      return false;
+    }
+    Values &values = records.emplace(day, missing).first->second;
+    for (const auto &[index, column] : columns) {
+      const float value = index < fields.size()
+                              ? ParseValue(fields[index])
+                              : std::numeric_limits<float>::quiet_NaN();
+      if (std::isnan(values[column->column])) {
+        values[column->column] = value * column->scale;
+      }
+    }
+  }
+  if (records.empty()) {
+    std::cerr << csv_filename << " has no records" << std::endl;
+    return false;
+  }
+
+  binaryweather::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, binaryweather::kMagic, sizeof(header.magic));
+  header.version = binaryweather::kVersion;
+  header.num_columns = binaryweather::NUM_COLUMNS;
+  header.first_day = records.begin()->first;
+  header.num_days = records.rbegin()->first - header.first_day + 1;
+
+  std::vector<char> out(sizeof(header));
+  std::vector<float> column(header.num_days);
+  for (uint32_t c = 0; c < binaryweather::NUM_COLUMNS; ++c) {
+    std::fill(column.begin(), column.end(), missing[c]);
+    for (const auto &[day, values] : records) {
+      column[day - header.first_day] = values[c];
+    }
+    out.resize((out.size() + binaryweather::kAlignment - 1) /
+               binaryweather::kAlignment * binaryweather::kAlignment);
+    header.column_offsets[c] = out.size();
+    const char *bytes = reinterpret_cast<const char *>(column.data());
+    out.insert(out.end(), bytes, bytes + column.size() * sizeof(float));
+  }
+  std::memcpy(out.data(), &header, sizeof(header));
+
+  FILE *fp = fopen(filename.c_str(), "wb");
+  if (!fp) {
+    return false;
+  }
+  const bool ret = fwrite(out.data(), 1, out.size(), fp) == out.size();
+  return fclose(fp) == 0 && ret;
+}
+
+WeatherSeries::WeatherSeries(const std::string &filename)
+    : columns_{nullptr} {
+  std::memset(&header_, 0, sizeof(header_));
+  std::unique_ptr<MappedFile> mapped_file(new MappedFile(filename));
+  if (!mapped_file->is_open() ||
+      mapped_file->size() < sizeof(binaryweather::Header)) {
+    return;
+  }
+
+  const char *data = mapped_file->data();
+  const size_t size = mapped_file->size();
+  binaryweather::Header header;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, binaryweather::kMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != binaryweather::kVersion ||
+      header.num_columns != binaryweather::NUM_COLUMNS) {
+    std::cerr << filename << " is not a binary weather series of version "
+              << binaryweather::kVersion << std::endl;
+    return;
+  }
+  for (uint32_t c = 0; c < binaryweather::NUM_COLUMNS; ++c) {
+    const uint64_t offset = header.column_offsets[c];
+    if (offset % alignof(float) != 0 || offset > size ||
+        header.num_days > (size - offset) / sizeof(float)) {
+      std::cerr << filename << " is truncated" << std::endl;
+      return;
+    }
+    columns_[c] = reinterpret_cast<const float *>(data + offset);
+  }
+
+  mapped_file->AdviseSequential();
+  header_ = header;
+  mapped_file_ = std::move(mapped_file);
+}
+
+int64_t WeatherSeries::DayIndex(
+    const std::chrono::system_clock::time_point &time) const {
+  const int64_t seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch())
+          .count();
+  // rounds down before 1970 as well
+  const int64_t day =
+      seconds / kSecsPerDay - (seconds % kSecsPerDay < 0 ? 1 : 0);
+  return day - header_.first_day;
+}
+
+Weather WeatherSeries::GetWeather(const size_t index,
+                                  const Weather &fallback) const {
+  // Reads the next days of every column while these are used. A simulation
+  // moves through the series one day after the other, so only the first day
+  // of each block of days has to ask for it.
+  if (index % kReadaheadDays == 0) {
+    for (uint32_t c = 0; c < binaryweather::NUM_COLUMNS; ++c) {
+      mapped_file_->Prefetch(header_.column_offsets[c] + index * sizeof(float),
+                             kReadaheadDays * sizeof(float));
+    }
+  }
+
+  auto value = [this, index](const binaryweather::Column column,
+                             const double fallback_value) {
+    const float value = columns_[column][index];
+    return std::isnan(value) ? fallback_value : double(value);
+  };
+  return Weather(
+      value(binaryweather::TOTAL_SUNSHINE_HOUR, fallback.total_sunshine_hour),
+      value(binaryweather::AIR_TEMP_MIN, fallback.air_temperature.min),
+      value(binaryweather::AIR_TEMP_MAX, fallback.air_temperature.max),
+      value(binaryweather::RELATIVE_HUMIDITY, fallback.relative_humidity),
+      value(binaryweather::WIND_SPEED, fallback.wind_speed),
+      value(binaryweather::RAINFALL, fallback.rainfall));
+}
+
+}  // namespace environment
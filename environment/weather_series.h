@@ -0,0 +1,61 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WEATHER_SERIES_H_
+#define COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WEATHER_SERIES_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "environment/binary_weather.h"
+#include "environment/mapped_file.h"
+#include "environment/weather.h"
+
+namespace environment {
+
+// The daily weather of a binary weather series (see binary_weather.h), mapped
+// into memory, so that a simulation of many years reads the days it reaches
+// instead of holding or parsing the whole series. The series is not modified
+// once opened, so one can be shared by several environments.
+class WeatherSeries {
+ public:
+  // Converts the daily records of a weather station in the CSV file
+  // `csv_filename` into a binary weather series written to `filename`. The
+  // first line names the columns, of which DATE (YYYY-MM-DD) is required and
+  // PRCP (mm), TMAX and TMIN (degree Celsius), RHAV (percent), AWND (m s^-1)
+  // and TSUN (minutes) are read, as in the daily summaries of NOAA; fields may
+  // be quoted. The days without records are missing. Returns false if the
+  // records cannot be read or the series cannot be written.
+  static bool ConvertCsv(const std::string &csv_filename,
+                         const std::string &filename);
+
+  // Maps the series of `filename`. Check `is_open()` to see whether it
+  // succeeded.
+  explicit WeatherSeries(const std::string &filename);
+
+  bool is_open() const { return mapped_file_ != nullptr; }
+  // days since 1970-01-01 of the first day
+  int64_t first_day() const { return header_.first_day; }
+  size_t num_days() const { return header_.num_days; }
+
+  // Returns the index in this series of the day (UTC) of `time`, which is
+  // outside of [0, num_days()) if the series does not cover it.
+  int64_t DayIndex(const std::chrono::system_clock::time_point &time) const;
+
+  // Returns the weather of the day at `index`, which must be in
+  // [0, num_days()), taking the values missing from the records from
+  // `fallback`.
+  Weather GetWeather(const size_t index, const Weather &fallback) const;
+
+ private:
+  // The days read ahead of the one being read, by column.
+  static constexpr size_t kReadaheadDays = 1024;
+
+  std::unique_ptr<MappedFile> mapped_file_;
+  binaryweather::Header header_;
+  const float *columns_[binaryweather::NUM_COLUMNS];
+};
+
+}  // namespace environment
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_ENVIRONMENT_WEATHER_SERIES_H_
@@ -0,0 +1,69 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "agent/actions/action_pool.h"
+#include "agent/actions/crop.h"
+#include "environment/coordinate.h"
+
+using namespace agent::action;
+using namespace environment;
+
+TEST(ActionPoolTest, NewTest) {
+  ActionPool pool;
+  crop::Add *add = pool.New<crop::Add>(Coordinate(1, 2), 3, 4, "bean");
+  ASSERT_NE(nullptr, add);
+  EXPECT_TRUE(pool.Owns(add));
+  EXPECT_EQ(3, add->start_time_step());
+  EXPECT_EQ(4, add->duration());
+  EXPECT_EQ("bean", add->crop_type_name());
+
+  crop::Add other(Coordinate(1, 2), 3, 4, "bean");
+  EXPECT_FALSE(pool.Owns(&other));
+  EXPECT_TRUE(*add == other);
+
+  pool.Delete(add);
+}
+
+TEST(ActionPoolTest, RecycleTest) {
+  ActionPool pool;
+  std::vector<const Action *> actions;
+  for (int i = 0; i < 100; ++i) {
+    actions.push_back(pool.New<crop::Water>(Coordinate(i, i), i, 0, 1.0));
+  }
+  const size_t num_slots = pool.num_slots();
+  EXPECT_LE(100, num_slots);
+
+  // the slots of deleted actions are reused instead of allocating new ones
+  for (int round = 0; round < 10; ++round) {
+    for (const Action *action : actions) {
+      pool.Delete(action);
+    }
+    EXPECT_EQ(num_slots, pool.num_free_slots());
+    actions.clear();
+    for (int i = 0; i < 100; ++i) {
+      actions.push_back(pool.New<crop::Harvest>(Coordinate(i, i), i, 0));
+    }
+    EXPECT_EQ(num_slots, pool.num_slots());
+  }
+  for (const Action *action : actions) {
+    pool.Delete(action);
+  }
+}
+
+TEST(ActionPoolTest, CloneTest) {
+  ActionPool pool;
+  ActionPool other_pool;
+  const crop::Remove remove(Coordinate(1, 1), 2, 0);
+  const Action *clone = remove.Clone(&pool);
+  EXPECT_TRUE(pool.Owns(clone));
+  EXPECT_FALSE(other_pool.Owns(clone));
+  EXPECT_TRUE(*clone == remove);
+  pool.Delete(clone);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
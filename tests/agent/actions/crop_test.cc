@@ -133,7 +133,7 @@ TEST_F(AddTest, ConstrcutorTest_1) {
             action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(AddTest, ConstrcutorTest_2) {
@@ -142,7 +142,7 @@ TEST_F(AddTest, ConstrcutorTest_2) {
   EXPECT_EQ(applied_range, action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(AddTest, ConstrcutorTest_3) {
@@ -219,7 +219,7 @@ TEST_F(RemoveTest, ConstrcutorTest_1) {
             action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(RemoveTest, ConstrcutorTest_2) {
@@ -228,7 +228,7 @@ TEST_F(RemoveTest, ConstrcutorTest_2) {
   EXPECT_EQ(applied_range, action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(RemoveTest, ConstrcutorTest_3) {
@@ -329,7 +329,7 @@ TEST_F(HarvestTest, ConstrcutorTest_1) {
             action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(HarvestTest, ConstrcutorTest_2) {
@@ -338,7 +338,7 @@ TEST_F(HarvestTest, ConstrcutorTest_2) {
   EXPECT_EQ(applied_range, action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(HarvestTest, ConstrcutorTest_3) {
@@ -380,7 +380,7 @@ TEST_F(AddWaterTest, ConstrcutorTest_1) {
             action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(AddWaterTest, ConstrcutorTest_2) {
@@ -389,7 +389,7 @@ TEST_F(AddWaterTest, ConstrcutorTest_2) {
   EXPECT_EQ(applied_range, action.applied_range());
   EXPECT_EQ(time_step, action.start_time_step());
   EXPECT_EQ(duration, action.duration());
-  EXPECT_TRUE(action.cost().empty());
+  EXPECT_EQ(agent::Resources(), action.cost());
 }
 
 TEST_F(AddWaterTest, ConstrcutorTest_3) {
@@ -426,8 +426,7 @@ TEST_F(AddWaterTest, AddToRange1) {
       if (Coordinate(i, j) == applied_range.front()) {
         ASSERT_NE(nullptr, plant);
         EXPECT_EQ(15.0, terrain->soil_container()[Coordinate(i, j)]
-                            .water_content()
-                            .water_amount_1);
+                            .surface_water_content());
       } else {
         EXPECT_EQ(nullptr, plant);
       }
@@ -450,8 +449,7 @@ TEST_F(AddWaterTest, AddToRange2) {
       if (Coordinate(i, j) == applied_range.front()) {
         ASSERT_NE(nullptr, plant);
         EXPECT_EQ(15.0, terrain->soil_container()[Coordinate(i, j)]
-                            .water_content()
-                            .water_amount_1);
+                            .surface_water_content());
       } else {
         EXPECT_EQ(nullptr, plant);
       }
@@ -466,8 +464,7 @@ TEST_F(AddWaterTest, AddToRange2) {
       if (Coordinate(i, j) == applied_range.front()) {
         ASSERT_NE(nullptr, plant);
         EXPECT_EQ(30.0, terrain->soil_container()[Coordinate(i, j)]
-                            .water_content()
-                            .water_amount_1);
+                            .surface_water_content());
       } else {
         EXPECT_EQ(nullptr, plant);
       }
@@ -40,13 +40,11 @@ class AgentTest : public ::testing::Test {
 TEST_F(AgentTest, AddResourceTest) {
   agent->AddResource(agent::ResourceType::MONEY, 100);
 
-  auto find_money = agent->owned_resource().find(agent::ResourceType::MONEY);
-  ASSERT_NE(agent->owned_resource().end(), find_money);
-  EXPECT_EQ(100, find_money->second);
+  EXPECT_EQ(100, agent->owned_resource()[agent::ResourceType::MONEY]);
+  EXPECT_EQ(0, agent->owned_resource()[agent::ResourceType::LABOR]);
 
   agent->AddResource(agent::ResourceType::MONEY, 100);
-  ASSERT_NE(agent->owned_resource().end(), find_money);
-  EXPECT_EQ(200, find_money->second);
+  EXPECT_EQ(200, agent->owned_resource()[agent::ResourceType::MONEY]);
 }
 
 TEST_F(AgentTest, TakeActionTest) {
@@ -67,8 +65,7 @@ TEST_F(AgentTest, TakeActionTest) {
   agent->AddResource(agent::ResourceType::MONEY, 100);
   ret_code = agent->TakeAction(&action);
   EXPECT_EQ(Agent::SUCCESS, ret_code);
-  auto find_money = agent->owned_resource().find(agent::ResourceType::MONEY);
-  EXPECT_EQ(90, find_money->second);
+  EXPECT_EQ(90, agent->owned_resource()[agent::ResourceType::MONEY]);
 }
 
 // TODO: This needs to be refactored
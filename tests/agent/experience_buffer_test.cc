@@ -0,0 +1,77 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "agent/experience_buffer.h"
+
+using namespace agent;
+
+TEST(ExperienceBufferTest, PushPopTest) {
+  ExperienceBuffer<int> buffer(3);
+  EXPECT_EQ(4, buffer.capacity());
+
+  int item;
+  EXPECT_FALSE(buffer.Pop(&item));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(buffer.Push(i));
+  }
+  EXPECT_FALSE(buffer.Push(4));
+
+  // first in, first out, also across the end of the ring
+  for (int lap = 0; lap < 3; ++lap) {
+    ASSERT_TRUE(buffer.Pop(&item));
+    EXPECT_EQ(lap, item);
+    EXPECT_TRUE(buffer.Push(lap + 4));
+  }
+  int items[8];
+  ASSERT_EQ(4, buffer.PopBatch(items, 8));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i + 3, items[i]);
+  }
+  EXPECT_EQ(0, buffer.PopBatch(items, 8));
+}
+
+TEST(ExperienceBufferTest, ConcurrentTest) {
+  const int kProducers = 4, kConsumers = 3, kItems = 20000;
+  ExperienceBuffer<int> buffer(64);
+  std::atomic<long long> sum(0);
+  std::atomic<int> popped(0);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&buffer, p]() {
+      for (int i = 1; i <= kItems; ++i) {
+        while (!buffer.Push(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&]() {
+      int item;
+      while (popped.load() < kProducers * kItems) {
+        if (buffer.Pop(&item)) {
+          sum += item;
+          ++popped;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // every item is popped exactly once
+  EXPECT_EQ(kProducers * kItems, popped.load());
+  EXPECT_EQ((long long)kProducers * kItems * (kItems + 1) / 2, sum.load());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
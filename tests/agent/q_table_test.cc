@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "agent/q_table.h"
+
+using namespace agent;
+
+TEST(QTableTest, DenseTest) {
+  DenseQTable<float> table(10, 54, 0.5f);
+  EXPECT_EQ(10, table.num_states());
+  EXPECT_EQ(54, table.num_actions());
+  for (size_t state = 0; state < 10; ++state) {
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(table.Row(state)) %
+                      DenseQStorage<float>::kAlignment);
+    EXPECT_FLOAT_EQ(0.5f, table.MaxQ(state));
+    EXPECT_EQ(0, table.MaxQAction(state));
+  }
+
+  table.Set(3, 41, 2.0f);
+  table.Set(3, 7, 1.0f);
+  EXPECT_FLOAT_EQ(2.0f, table.MaxQ(3));
+  EXPECT_EQ(41, table.MaxQAction(3));
+  // the other rows are not touched
+  EXPECT_FLOAT_EQ(0.5f, table.MaxQ(2));
+  EXPECT_FLOAT_EQ(0.5f, table.MaxQ(4));
+}
+
+// A table without actions has no maximum to read, and one too large to
+// allocate is not left with a null array
+TEST(QTableTest, InvalidSizeTest) {
+  EXPECT_THROW(DenseQTable<float>(10, 0), std::invalid_argument);
+  EXPECT_THROW(SparseQTable<float>(10, 0), std::invalid_argument);
+  EXPECT_THROW(DenseQTable<float>(std::numeric_limits<size_t>::max() / 8, 54),
+               std::bad_alloc);
+}
+
+TEST(QTableTest, MaxQTest) {
+  // rows shorter and longer than the vectorized loop, and maxima in the tail
+  for (size_t num_actions : {1, 5, 8, 17, 64}) {
+    DenseQTable<double> table(2, num_actions, -1.0);
+    for (size_t action = 0; action < num_actions; ++action) {
+      table.Set(1, action, -1.0);
+      table.Set(1, action, 3.0);
+      EXPECT_DOUBLE_EQ(3.0, table.MaxQ(1));
+      EXPECT_EQ(action, table.MaxQAction(1));
+      table.Set(1, action, -2.0);
+    }
+  }
+}
+
+TEST(QTableTest, UpdateTest) {
+  DenseQTable<float> table(2, 3);
+  table.Set(1, 2, 10.0f);
+  table.Update(0, 1, 1.0f, 1, 0.1f, 0.95f);
+  // (1 - 0.1) * 0 + 0.1 * (1 + 0.95 * 10)
+  EXPECT_FLOAT_EQ(1.05f, table.Get(0, 1));
+
+  // a batch is the same as its transitions applied in order
+  DenseQTable<float> batched(2, 3), single(2, 3);
+  batched.Set(1, 2, 10.0f);
+  single.Set(1, 2, 10.0f);
+  std::vector<DenseQTable<float>::Transition> transitions = {
+      {0, 1, 1.0f, 1}, {1, 2, 0.0f, 0}, {0, 1, 1.0f, 1}};
+  batched.UpdateBatch(transitions, 0.1f, 0.95f);
+  for (const auto &t : transitions) {
+    single.Update(t.state, t.action, t.reward, t.next_state, 0.1f, 0.95f);
+  }
+  for (size_t state = 0; state < 2; ++state) {
+    for (size_t action = 0; action < 3; ++action) {
+      EXPECT_FLOAT_EQ(single.Get(state, action), batched.Get(state, action));
+    }
+  }
+}
+
+TEST(QTableTest, SparseTest) {
+  // far more states than could be allocated densely
+  SparseQTable<float> table(uint64_t(1) << 40, 16, 0.25f);
+  EXPECT_EQ(0, table.storage().num_stored());
+  EXPECT_FLOAT_EQ(0.25f, table.MaxQ(123456789012));
+
+  table.Set(123456789012, 9, 4.0f);
+  EXPECT_EQ(1, table.storage().num_stored());
+  EXPECT_FLOAT_EQ(4.0f, table.MaxQ(123456789012));
+  EXPECT_EQ(9, table.MaxQAction(123456789012));
+  EXPECT_FLOAT_EQ(0.25f, table.Get(123456789012, 3));
+
+  // reading does not store the row
+  table.Update(5, 0, 1.0f, 7, 0.5f, 1.0f);
+  EXPECT_EQ(2, table.storage().num_stored());
+  EXPECT_FLOAT_EQ(0.5f * 0.25f + 0.5f * (1.0f + 0.25f), table.Get(5, 0));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
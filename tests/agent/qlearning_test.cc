@@ -43,6 +43,42 @@ TEST_F(QlearningTest, ConstructorTest_1) {
   EXPECT_EQ(env, agent.environment());
 }
 
+TEST_F(QlearningTest, UpdateQtableTest) {
+  const float max_q_future = qlearning->MaxQ(1);
+  const float current_q = qlearning->qtable().Get(0, 3);
+  qlearning->UpdateQtable(0, 1.0f, 1, 3);
+  // the update is fractional, not truncated to an integer
+  EXPECT_FLOAT_EQ(0.9f * current_q + 0.1f * (1.0f + 0.95f * max_q_future),
+                  qlearning->qtable().Get(0, 3));
+  EXPECT_GE(qlearning->MaxQ(0), qlearning->qtable().Get(0, 3));
+  EXPECT_FLOAT_EQ(qlearning->MaxQ(0),
+                  qlearning->qtable().Get(0, qlearning->MaxQAction(0)));
+}
+
+TEST_F(QlearningTest, ExecuteTest) { EXPECT_EQ(0, qlearning->Execute(100)); }
+
+TEST_F(QlearningTest, SeedTest) {
+  Qlearning other("other agent", env, 10, 54);
+  qlearning->Seed(5);
+  other.Seed(5);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(qlearning->RandomInt(0, 9), other.RandomInt(0, 9));
+  }
+}
+
+// The seed given to the constructor also gives the initial table
+TEST_F(QlearningTest, SeededTableTest) {
+  Qlearning agent("agent", env, 10, 54, 7);
+  Qlearning other("other agent", env, 10, 54, 7);
+  for (int state = 0; state < 10; ++state) {
+    for (int action = 0; action < 54; ++action) {
+      EXPECT_EQ(agent.qtable().Get(state, action),
+                other.qtable().Get(state, action));
+    }
+  }
+  EXPECT_EQ(agent.RandomInt(0, 1000), other.RandomInt(0, 1000));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "agent/random.h"
+
+using namespace agent;
+
+TEST(RandomTest, SeedTest) {
+  Random a(42), b(42), c(43);
+  std::vector<uint64_t> first;
+  bool differ = false;
+  for (int i = 0; i < 100; ++i) {
+    const uint64_t x = a();
+    first.push_back(x);
+    EXPECT_EQ(x, b());
+    differ |= x != c();
+  }
+  EXPECT_TRUE(differ);
+
+  // seeding again restarts the sequence
+  a.Seed(42);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(first[i], a());
+  }
+}
+
+TEST(RandomTest, UniformIntTest) {
+  Random random(7);
+  const int kMin = -3, kMax = 6;
+  std::vector<int> counts(kMax - kMin + 1, 0);
+  const int kDraws = 100000;
+  for (int i = 0; i < kDraws; ++i) {
+    const int x = random.UniformInt(kMin, kMax);
+    ASSERT_GE(x, kMin);
+    ASSERT_LE(x, kMax);
+    ++counts[x - kMin];
+  }
+  // every value is drawn about equally often
+  for (const int count : counts) {
+    EXPECT_NEAR(kDraws / counts.size(), count, kDraws / counts.size() / 10);
+  }
+
+  EXPECT_EQ(5, random.UniformInt(5, 5));
+  const int x = random.UniformInt(std::numeric_limits<int>::min(),
+                                  std::numeric_limits<int>::max());
+  EXPECT_GE(x, std::numeric_limits<int>::min());
+}
+
+TEST(RandomTest, UniformRealTest) {
+  Random random(7);
+  double sum = 0.0;
+  for (int i = 0; i < 10000; ++i) {
+    const double x = random.UniformReal();
+    ASSERT_GE(x, 0.0);
+    ASSERT_LT(x, 1.0);
+    sum += x;
+  }
+  EXPECT_NEAR(0.5, sum / 10000, 0.02);
+
+  // it can drive the standard library as well
+  std::vector<int> v = {1, 2, 3, 4, 5};
+  std::shuffle(v.begin(), v.end(), random);
+  std::sort(v.begin(), v.end());
+  EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), v);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
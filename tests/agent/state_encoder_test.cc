@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "agent/actions/crop.h"
+#include "agent/state_encoder.h"
+#include "environment/environment.h"
+
+using namespace agent;
+using namespace config;
+using namespace environment;
+using namespace agent::action;
+
+class StateEncoderTest : public ::testing::Test {
+ public:
+  ~StateEncoderTest() { delete env; }
+
+ protected:
+  void SetUp() override {
+    Config config("place name", Location(100.0, 100.0, 200.0, 200.0));
+    TerrainRawData terrain_raw_data(kTerrainSize, 0);
+
+    // at noon, when an hour of evaporation leaves some of the water to
+    // percolate down to the roots
+    struct tm tm = {};
+    tm.tm_year = 2020 - 1900;
+    tm.tm_mon = 5;
+    tm.tm_mday = 21;
+    tm.tm_hour = 12;
+    env = new Environment(config, terrain_raw_data,
+                          std::chrono::system_clock::from_time_t(mktime(&tm)),
+                          std::chrono::hours(1));
+  }
+
+  // The water balance of a dry soil is not a number, so NaNs have to compare
+  // equal. The lateral flow does not report the cells whose water changed by
+  // less than its tolerance, so the features may lag by as much.
+  static void ExpectSameFeatures(const std::vector<float> &expected,
+                                 const std::vector<float> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      if (std::isnan(expected[i])) {
+        EXPECT_TRUE(std::isnan(actual[i])) << i;
+      } else {
+        EXPECT_NEAR(expected[i], actual[i], kTolerance) << i;
+      }
+    }
+  }
+
+  static const size_t kTerrainSize = 4;
+  static constexpr double kTolerance = 1e-6;
+  Environment *env;
+};
+
+TEST_F(StateEncoderTest, EncodeTest) {
+  StateEncoder encoder(kTerrainSize);
+  EXPECT_EQ(2 * kTerrainSize * kTerrainSize + 3, encoder.size());
+
+  std::vector<float> features(encoder.size(), -1.0f);
+  encoder.Encode(*env, features.data());
+  for (size_t cell = 0; cell < encoder.num_cells(); ++cell) {
+    EXPECT_EQ(0.0f, features[encoder.moisture_offset() + cell]);
+    EXPECT_EQ(0.0f, features[encoder.maturity_offset() + cell]);
+  }
+  EXPECT_EQ(0.0f, features[encoder.yield_offset()]);
+  const float sin = features[encoder.time_of_year_offset()];
+  const float cos = features[encoder.time_of_year_offset() + 1];
+  EXPECT_NEAR(1.0f, sin * sin + cos * cos, 1e-5);
+}
+
+TEST_F(StateEncoderTest, UpdateTest) {
+  StateEncoder encoder(kTerrainSize);
+  std::vector<float> features(encoder.size());
+  encoder.Encode(*env, features.data());
+
+  crop::Add add(Coordinate(1, 2), env->time_step(), 0, "bean");
+  // the water reaches the roots as it percolates through the soil of the plant
+  crop::Water water(Coordinate(1, 2), env->time_step(), 0, 10.0);
+  env->ReceiveAction(&add);
+  env->ReceiveAction(&water);
+  env->JumpForwardTimeStep(1);
+  encoder.Update(*env, features.data());
+
+  const size_t plant_cell = env->terrain().CellIndex(Coordinate(1, 2));
+  EXPECT_GT(features[encoder.maturity_offset() + plant_cell], 0.0f);
+  EXPECT_GT(features[encoder.moisture_offset() + plant_cell], 0.0f);
+
+  // the same as encoding everything
+  StateEncoder fresh_encoder(kTerrainSize);
+  std::vector<float> expected(fresh_encoder.size());
+  fresh_encoder.Encode(*env, expected.data());
+  ExpectSameFeatures(expected, features);
+
+  // nothing changed
+  encoder.Update(*env, features.data());
+  ExpectSameFeatures(expected, features);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "agent/actions/crop.h"
+#include "agent/q_learning.h"
+#include "agent/trainer.h"
+#include "environment/environment.h"
+
+using namespace agent;
+using namespace config;
+using namespace environment;
+using namespace agent::action;
+
+class TrainerTest : public ::testing::Test {
+ public:
+  ~TrainerTest() {
+    delete qlearning;
+    delete env;
+  }
+
+ protected:
+  void SetUp() override {
+    Config config("place name", Location(100.0, 100.0, 200.0, 200.0));
+    TerrainRawData terrain_raw_data(kTerrainSize, 0);
+
+    env = new Environment(config, terrain_raw_data,
+                          std::chrono::system_clock::now(),
+                          std::chrono::hours(1));
+    // the states are the number of plants, the actions are to wait or to
+    // plant a bean
+    qlearning = new Qlearning("agent name", env, kTerrainSize + 1, 2);
+  }
+
+  static size_t NumPlants(const Environment &env) {
+    return env.terrain().plant_container().size();
+  }
+
+  Trainer NewTrainer() {
+    return Trainer(
+        qlearning, [](const Environment &env) { return NumPlants(env); },
+        [](size_t action, const Environment &env) -> const Action * {
+          const size_t n = NumPlants(env);
+          if (action == 0 || n >= kTerrainSize) {
+            return nullptr;
+          }
+          return new crop::Add(Coordinate(n, n), env.time_step(), 0, "bean");
+        },
+        [](const Environment &env) { return float(NumPlants(env)); });
+  }
+
+  static const size_t kTerrainSize = 4;
+  Qlearning *qlearning;
+  Environment *env;
+};
+
+TEST_F(TrainerTest, TrainTest) {
+  Trainer trainer = NewTrainer();
+  TrainerOptions options;
+  options.num_workers = 4;
+  options.num_episodes = 16;
+  options.episode_length = 3;
+  options.epsilon = 1.0f;  // explore only
+  options.batch_size = 5;
+  options.buffer_capacity = 8;
+
+  EXPECT_EQ(16 * 3, trainer.Train(options));
+  // the rollouts ran in forks
+  EXPECT_EQ(0, env->time_step());
+  EXPECT_EQ(0, NumPlants(*env));
+}
+
+TEST_F(TrainerTest, LearnTest) {
+  Trainer trainer = NewTrainer();
+  TrainerOptions options;
+  options.num_workers = 2;
+  options.num_episodes = 200;
+  options.episode_length = 1;
+  options.epsilon = 1.0f;
+
+  trainer.Train(options);
+  // planting is rewarded by one plant and leads to state 1, which the
+  // rollouts never leave
+  EXPECT_NEAR(1.0f + 0.95f * qlearning->MaxQ(1), qlearning->qtable().Get(0, 1),
+              1e-3);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
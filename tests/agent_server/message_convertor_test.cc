@@ -25,6 +25,7 @@ using namespace environment;
 void TestPlantConvertor(const Plant &plant,
                         const data_format::Plant &plant_protobuf) {
   EXPECT_EQ(plant.name(), plant_protobuf.name());
+  EXPECT_EQ(plant.species_id().value(), plant_protobuf.species_id());
   EXPECT_EQ(plant.trunk_size(), plant_protobuf.trunk_size());
   EXPECT_EQ(plant.root_size(), plant_protobuf.root_size());
   EXPECT_EQ(plant.health(), plant_protobuf.health());
@@ -51,29 +52,24 @@ void TestPlantConvertor(const Plant &plant,
       break;
   }
   EXPECT_EQ(plant.produce(), plant_protobuf.produce());
-  EXPECT_EQ(plant.params().at(environment::PlantProperty::GDD_BASE_TEMPERATURE),
+  EXPECT_EQ(plant.param(environment::PlantProperty::GDD_BASE_TEMPERATURE),
             plant_protobuf.params().gdd_base_temperature());
-  EXPECT_EQ(
-      plant.params().at(environment::PlantProperty::MIN_ABSOLUTE_TEMPERATURE),
-      plant_protobuf.params().min_absolute_temperature());
-  EXPECT_EQ(
-      plant.params().at(environment::PlantProperty::MAX_ABSOLUTE_TEMPERATURE),
-      plant_protobuf.params().max_absolute_temperature());
-  EXPECT_EQ(
-      plant.params().at(environment::PlantProperty::MIN_NEW_GROWTH_TEMPERATURE),
-      plant_protobuf.params().min_new_growth_temperature());
-  EXPECT_EQ(
-      plant.params().at(environment::PlantProperty::MAX_NEW_GROWTH_TEMPERATURE),
-      plant_protobuf.params().max_new_growth_temperature());
-  EXPECT_EQ(plant.params().at(environment::PlantProperty::MIN_PHOTO_PERIOD),
+  EXPECT_EQ(plant.param(environment::PlantProperty::MIN_ABSOLUTE_TEMPERATURE),
+            plant_protobuf.params().min_absolute_temperature());
+  EXPECT_EQ(plant.param(environment::PlantProperty::MAX_ABSOLUTE_TEMPERATURE),
+            plant_protobuf.params().max_absolute_temperature());
+  EXPECT_EQ(plant.param(environment::PlantProperty::MIN_NEW_GROWTH_TEMPERATURE),
+            plant_protobuf.params().min_new_growth_temperature());
+  EXPECT_EQ(plant.param(environment::PlantProperty::MAX_NEW_GROWTH_TEMPERATURE),
+            plant_protobuf.params().max_new_growth_temperature());
+  EXPECT_EQ(plant.param(environment::PlantProperty::MIN_PHOTO_PERIOD),
             plant_protobuf.params().min_photo_period());
-  EXPECT_EQ(plant.params().at(environment::PlantProperty::MAX_PHOTO_PERIOD),
+  EXPECT_EQ(plant.param(environment::PlantProperty::MAX_PHOTO_PERIOD),
             plant_protobuf.params().max_photo_period());
-  EXPECT_EQ(plant.params().at(environment::PlantProperty::MAX_HARVEST_YIELD),
+  EXPECT_EQ(plant.param(environment::PlantProperty::MAX_HARVEST_YIELD),
             plant_protobuf.params().max_harvest_yield());
-  EXPECT_EQ(
-      plant.params().at(environment::PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM),
-      plant_protobuf.params().gdd_units_after_full_bloom());
+  EXPECT_EQ(plant.param(environment::PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM),
+            plant_protobuf.params().gdd_units_after_full_bloom());
 }
 
 // This tests on converting a `std::chrono::system_clock::time_point` to and
@@ -135,6 +131,36 @@ TEST(MessageConvertorTest, SoilConvertorTest) {
   EXPECT_EQ(soil, FromProtobuf(soil_protobuf));
 }
 
+// The water content of a soil from protobuf has as many layers as its profile
+TEST(MessageConvertorTest, SoilLayersConvertorTest) {
+  const size_t num_layers = Soil::Profile(Soil::SAND).num_layers();
+  data_format::Soil soil_protobuf =
+      ToProtobuf(Soil(Soil::SAND, 6.0, 1.0, 2.0, 0.1, 0.2));
+
+  // no layers at all
+  soil_protobuf.mutable_water_content()->clear_layers();
+  Soil soil = FromProtobuf(soil_protobuf);
+  ASSERT_EQ(num_layers, soil.water_content().size());
+  for (const double water_content : soil.water_content()) {
+    EXPECT_EQ(0.0, water_content);
+  }
+
+  // too few, the missing ones like the deepest one given
+  soil_protobuf.mutable_water_content()->add_layers(0.1);
+  soil_protobuf.mutable_water_content()->add_layers(0.2);
+  soil = FromProtobuf(soil_protobuf);
+  EXPECT_EQ(Soil(Soil::SAND, 6.0, 1.0, 2.0, 0.1, 0.2), soil);
+
+  // too many
+  for (size_t k = 0; k < num_layers; ++k) {
+    soil_protobuf.mutable_water_content()->add_layers(0.3);
+  }
+  soil = FromProtobuf(soil_protobuf);
+  ASSERT_EQ(num_layers, soil.water_content().size());
+  EXPECT_EQ(0.1, soil.water_content()[0]);
+  EXPECT_EQ(0.2, soil.water_content()[1]);
+}
+
 // This tests on converting a `struct environment::Coordinate` to and from
 // protobuf.
 TEST(MessageConvertorTest, CoordinateConvertorTest) {
@@ -226,6 +252,7 @@ TEST_F(ActionConvertorTest, ActionAddCropTest) {
                                   cost, "Corn");
 
   auto action_protobuf = ToProtobuf(action);
+  EXPECT_EQ(action.crop_type_name(), action_protobuf.crop_type_name());
   EXPECT_EQ(action, FromProtobuf(action_protobuf));
 }
 
@@ -239,6 +266,16 @@ TEST_F(ActionConvertorTest, ActionRemoveCropTest) {
   EXPECT_EQ(action, FromProtobuf(action_protobuf));
 }
 
+// This tests on converting the crop types to protobuf.
+TEST(MessageConvertorTest, CropTypesConvertorTest) {
+  std::vector<SpeciesId> crop_types = {SpeciesId("bean")};
+
+  auto crop_types_protobuf = ToProtobuf(crop_types);
+  ASSERT_EQ(1, crop_types_protobuf.crop_types_size());
+  EXPECT_EQ(crop_types[0].value(), crop_types_protobuf.crop_types(0).id());
+  EXPECT_EQ("bean", crop_types_protobuf.crop_types(0).name());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "environment/cell_energy_balance.h"
+
+using namespace config;
+using namespace environment;
+
+class CellEnergyBalanceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    weather_ = std::make_unique<Weather>(12.0, 15.0, 30.0, 50.0, 2.0, 0.0);
+    meteorology_ = std::make_unique<Meteorology>(
+        std::chrono::system_clock::now(), location_, Climate::TemperateOceanic,
+        *weather_);
+    // noon of the summer solstice
+    meteorology_->Update(172, 12, 0, 0, *weather_);
+  }
+
+  const Location location_ = Location(45.0, 45.0, 45.0, 45.0);
+  std::unique_ptr<Weather> weather_;
+  std::unique_ptr<Meteorology> meteorology_;
+};
+
+TEST_F(CellEnergyBalanceTest, CellsTest) {
+  CellEnergyBalance energy_balance;
+  EXPECT_EQ(0, energy_balance.AddCell(0.5, 2.0, 0.2));
+  EXPECT_EQ(1, energy_balance.AddCell(0.5, 2.0, 0.2));
+  EXPECT_EQ(2, energy_balance.AddCell(0.5, 2.0, 0.35));
+  EXPECT_EQ(3, energy_balance.AddCell(0.5, 0.5, 0.2));
+  ASSERT_EQ(4, energy_balance.size());
+  energy_balance.Update(*meteorology_);
+
+  const std::vector<double> &soil = energy_balance.latent_heat_flux_soil();
+  const std::vector<double> &crop = energy_balance.latent_heat_flux_crop();
+  ASSERT_EQ(4, soil.size());
+  ASSERT_EQ(4, crop.size());
+  for (size_t i = 0; i < energy_balance.size(); ++i) {
+    EXPECT_TRUE(std::isfinite(soil[i]));
+    EXPECT_TRUE(std::isfinite(crop[i]));
+  }
+  // cells alike have the same fluxes
+  EXPECT_DOUBLE_EQ(soil[0], soil[1]);
+  EXPECT_DOUBLE_EQ(crop[0], crop[1]);
+  // wetter soil evaporates more
+  EXPECT_GT(soil[2], soil[0]);
+  // and more leaves transpire more at noon
+  EXPECT_GT(crop[0], crop[3]);
+}
+
+TEST_F(CellEnergyBalanceTest, ClearTest) {
+  CellEnergyBalance energy_balance;
+  energy_balance.AddCell(0.5, 2.0, 0.2);
+  energy_balance.Update(*meteorology_);
+  const double soil = energy_balance.latent_heat_flux_soil()[0];
+
+  energy_balance.Clear();
+  EXPECT_EQ(0, energy_balance.size());
+  energy_balance.Update(*meteorology_);
+  EXPECT_TRUE(energy_balance.latent_heat_flux_soil().empty());
+
+  // a bare cell is computed as a short sparse canopy
+  energy_balance.AddCell(0.0, 0.0, 0.2);
+  energy_balance.AddCell(0.5, 2.0, 0.2);
+  energy_balance.Update(*meteorology_);
+  EXPECT_TRUE(std::isfinite(energy_balance.latent_heat_flux_soil()[0]));
+  EXPECT_DOUBLE_EQ(soil, energy_balance.latent_heat_flux_soil()[1]);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
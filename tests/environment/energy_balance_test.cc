@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "environment/energy_balance.h"
+
+using namespace config;
+using namespace environment;
+
+class EnergyBalanceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    weather_ = std::make_unique<Weather>(12.0, 15.0, 30.0, 50.0, 2.0, 0.0);
+    soil_ = std::make_unique<Soil>(Soil::CLAY, 7.0, 0.0, 0.02, 0.3, 0.3);
+  }
+
+  // Returns the energy balance of a crop at noon of `day_of_year`.
+  std::unique_ptr<EnergyBalance> CreateEnergyBalance(
+      const Location &location, const int day_of_year) {
+    Meteorology meteorology(std::chrono::system_clock::now(), location,
+                            Climate::TemperateOceanic, *weather_);
+    meteorology.Update(day_of_year, 12, 0, 0, *weather_);
+    const PlantRadiation plant_radiation(kLeafAreaIndex, meteorology);
+    return std::make_unique<EnergyBalance>(
+        meteorology, plant_radiation, *weather_, kReferenceHeight,
+        kPlantHeight, kLeafAreaIndex, kLeafWidth, *soil_);
+  }
+
+  const double kReferenceHeight = 2.0;
+  const double kPlantHeight = 0.5;
+  const double kLeafAreaIndex = 2.0;
+  const double kLeafWidth = 0.05;
+  std::unique_ptr<Weather> weather_;
+  std::unique_ptr<Soil> soil_;
+};
+
+// The daily fluxes are the hourly fluxes summed over every minute of daylight
+TEST_F(EnergyBalanceTest, DailyHeatFluxesTest) {
+  const Location location(0.0, 0.0, 45.0, 45.0);
+  const int day_of_year = 172;
+  std::unique_ptr<EnergyBalance> energy_balance =
+      CreateEnergyBalance(location, day_of_year);
+
+  Meteorology meteorology(std::chrono::system_clock::now(), location,
+                          Climate::TemperateOceanic, *weather_);
+  PlantRadiation plant_radiation(kLeafAreaIndex, meteorology);
+  double total_latent = 0.0, latent_soil = 0.0;
+  double sensible_soil = 0.0, sensible_crop = 0.0;
+  for (int minute = 0; minute < 24 * 60; ++minute) {
+    meteorology.Update(day_of_year, minute / 60, minute % 60, 0, *weather_);
+    if (meteorology.solar_elevation() <= 0.0) {
+      continue;
+    }
+    plant_radiation.Update(meteorology);
+    EnergyBalance hourly(meteorology, plant_radiation, *weather_,
+                         kReferenceHeight, kPlantHeight, kLeafAreaIndex,
+                         kLeafWidth, *soil_);
+    total_latent += hourly.total_latent_heat_flux() * 60.0;
+    latent_soil += hourly.latent_heat_flux_soil() * 60.0;
+    sensible_soil += hourly.sensible_heat_flux_soil() * 60.0;
+    sensible_crop += hourly.sensible_heat_flux_crop() * 60.0;
+  }
+
+  EXPECT_GT(total_latent, 0.0);
+  EXPECT_NEAR(total_latent, energy_balance->daily_total_latent_heat_flux(),
+              0.01 * std::abs(total_latent));
+  EXPECT_NEAR(latent_soil, energy_balance->daily_latent_heat_flux_soil(),
+              0.01 * std::abs(latent_soil));
+  EXPECT_NEAR(sensible_soil, energy_balance->daily_sensible_heat_flux_soil(),
+              0.01 * std::abs(sensible_soil));
+  EXPECT_NEAR(sensible_crop, energy_balance->daily_sensible_heat_flux_crop(),
+              0.01 * std::abs(sensible_crop));
+}
+
+// The sun does not rise in the polar night, so nothing is integrated
+TEST_F(EnergyBalanceTest, PolarNightTest) {
+  std::unique_ptr<EnergyBalance> energy_balance =
+      CreateEnergyBalance(Location(0.0, 0.0, 80.0, 80.0), 355);
+  EXPECT_DOUBLE_EQ(0.0, energy_balance->daily_total_latent_heat_flux());
+  EXPECT_DOUBLE_EQ(0.0, energy_balance->daily_latent_heat_flux_soil());
+  EXPECT_DOUBLE_EQ(0.0, energy_balance->daily_latent_heat_flux_crop());
+  EXPECT_DOUBLE_EQ(0.0, energy_balance->daily_total_sensible_heat_flux());
+  EXPECT_DOUBLE_EQ(0.0, energy_balance->daily_sensible_heat_flux_soil());
+  EXPECT_DOUBLE_EQ(0.0, energy_balance->daily_sensible_heat_flux_crop());
+
+  // while the same crop has a day at the equator
+  energy_balance = CreateEnergyBalance(Location(0.0, 0.0, 0.0, 0.0), 355);
+  EXPECT_GT(energy_balance->daily_total_latent_heat_flux(), 0.0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
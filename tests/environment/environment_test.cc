@@ -91,6 +91,47 @@ TEST_F(EnvironmentTest, ReceiveActionsTest) {
   EXPECT_EQ(original_action_size + actions.size(), env->action_pq().size());
 }
 
+TEST_F(EnvironmentTest, ForkTest) {
+  env->ReceiveActions(actions);
+  env->JumpToTimeStep(1);
+  ASSERT_NE(nullptr, env->terrain().plant_container()[Coordinate(0, 0)]);
+
+  // the fork runs on from the state of the environment
+  auto fork = env->Fork();
+  EXPECT_EQ(env->time_step(), fork->time_step());
+  EXPECT_EQ(env->action_pq().size(), fork->action_pq().size());
+  EXPECT_NE(nullptr, fork->terrain().plant_container()[Coordinate(0, 0)]);
+  EXPECT_NE(env->terrain().plant_container()[Coordinate(0, 0)],
+            fork->terrain().plant_container()[Coordinate(0, 0)]);
+
+  fork->JumpToTimeStep(3);
+  EXPECT_NE(nullptr, fork->terrain().plant_container()[Coordinate(1, 1)]);
+  EXPECT_EQ(1, env->time_step());
+  EXPECT_EQ(nullptr, env->terrain().plant_container()[Coordinate(1, 1)]);
+}
+
+TEST_F(EnvironmentTest, NewActionTest) {
+  const Action *add = env->NewAction<crop::Add>(Coordinate(2, 2), 1, 0, "bean");
+  env->ReceiveAction(add);
+  env->ReceiveAction(
+      env->NewAction<crop::Add>(Coordinate(3, 3), 2, 0, "bean"));
+
+  // a fork gets its own copies of the actions of the environment
+  auto fork = env->Fork();
+  ASSERT_EQ(2, fork->action_pq().size());
+  EXPECT_NE(add, fork->action_pq().top());
+
+  // the actions take effect and are deleted
+  env->JumpToTimeStep(3);
+  EXPECT_TRUE(env->action_pq().empty());
+  EXPECT_NE(nullptr, env->terrain().plant_container()[Coordinate(2, 2)]);
+  fork->JumpToTimeStep(3);
+  EXPECT_NE(nullptr, fork->terrain().plant_container()[Coordinate(3, 3)]);
+
+  // an action which is never received
+  env->DeleteAction(env->NewAction<crop::Water>(Coordinate(0, 0), 4, 0, 1.0));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
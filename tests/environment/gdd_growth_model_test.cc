@@ -0,0 +1,178 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "environment/gdd_growth_model.h"
+
+using namespace environment;
+
+namespace {
+
+struct TestTraits {
+  static constexpr double kGddToFullBloom = 100.0;
+  static constexpr double kMaxHeight = 1.0;
+  static constexpr double kBiomassPerGdd = 2.0;
+};
+
+using TestModel = GddGrowthModel<TestTraits>;
+
+const PlantParams kTestParams = {
+    {PlantProperty::GDD_BASE_TEMPERATURE, 10000},
+    {PlantProperty::MIN_ABSOLUTE_TEMPERATURE, -5000},
+    {PlantProperty::MAX_ABSOLUTE_TEMPERATURE, 45000},
+    {PlantProperty::MIN_NEW_GROWTH_TEMPERATURE, 0},
+    {PlantProperty::MAX_NEW_GROWTH_TEMPERATURE, 40000},
+    {PlantProperty::MIN_PHOTO_PERIOD, 0},
+    {PlantProperty::MAX_PHOTO_PERIOD, 57600},  // 16 hours.
+    {PlantProperty::MAX_HARVEST_YIELD, 20},
+    {PlantProperty::GDD_UNITS_AFTER_FULL_BLOOM, 50000}};
+
+Plant::GrowthState NewState() {
+  return {Plant::kMaxHealth, false, 0.0, 0.0, 0, Plant::SEED, 0.0, 0.0, 1.0};
+}
+
+// Grows one day by `steps_per_day` steps of a sine temperature curve.
+void GrowSineDay(const TestModel::Params &params, const double temp_min,
+                 const double temp_max, const int steps_per_day,
+                 Plant::GrowthState *state) {
+  Resources consumed;
+  for (int i = 0; i < steps_per_day; ++i) {
+    const double t = (i + 0.5) / steps_per_day;
+    const GrowthConditions conditions = {
+        (temp_min + temp_max) / 2.0 +
+            (temp_max - temp_min) / 2.0 * std::sin(k2PI * t),
+        {temp_min, temp_max}, 12.0, 1.0 / steps_per_day};
+    TestModel::Grow(params, state, 1, conditions, Resources(), &consumed);
+  }
+}
+
+}  // namespace
+
+TEST(GddGrowthModelTest, DailyGrowingDegreeDaysTest) {
+  // entirely below and above the base
+  EXPECT_DOUBLE_EQ(0.0, DailyGrowingDegreeDays(0.0, 10.0, 10.0));
+  EXPECT_DOUBLE_EQ(10.0, DailyGrowingDegreeDays(15.0, 25.0, 10.0));
+  // symmetric around the base
+  EXPECT_NEAR(10.0 / kPI, DailyGrowingDegreeDays(0.0, 20.0, 10.0), 1e-9);
+
+  // the closed form is the integral of the sine curve
+  const double days[][3] = {
+      {5.0, 25.0, 10.0}, {-3.0, 12.0, 10.0}, {8.0, 35.0, 10.0}};
+  for (const auto &day : days) {
+    const int kSteps = 100000;
+    double gdd = 0.0;
+    for (int i = 0; i < kSteps; ++i) {
+      const double t = (i + 0.5) / kSteps;
+      const double temperature = (day[0] + day[1]) / 2.0 +
+                                 (day[1] - day[0]) / 2.0 * std::sin(k2PI * t);
+      gdd += std::max(0.0, temperature - day[2]) / kSteps;
+    }
+    EXPECT_NEAR(gdd, DailyGrowingDegreeDays(day[0], day[1], day[2]), 1e-6);
+  }
+}
+
+TEST(GddGrowthModelTest, StageTest) {
+  const TestModel::Params params = TestModel::MakeParams(kTestParams);
+  EXPECT_DOUBLE_EQ(10.0, params.base_temperature);
+  EXPECT_DOUBLE_EQ(16.0, params.max_photo_period);
+  EXPECT_DOUBLE_EQ(150.0, params.gdd_to_harvest);
+
+  // 10 GDD per day
+  const GrowthConditions conditions = {20.0, {15.0, 25.0}, 12.0, 1.0};
+  Plant::GrowthState state = NewState();
+  Resources consumed;
+  TestModel::Grow(params, &state, 1, conditions, Resources(), &consumed);
+  EXPECT_EQ(10000, state.accumulated_gdd);
+  EXPECT_EQ(Plant::SEEDLING, state.maturity);
+  TestModel::Grow(params, &state, 3, conditions, Resources(), &consumed);
+  EXPECT_EQ(Plant::JUVENILE, state.maturity);
+  EXPECT_DOUBLE_EQ(0.4, state.height);
+
+  TestModel::Grow(params, &state, 6, conditions, Resources(), &consumed);
+  EXPECT_EQ(Plant::MATURE, state.maturity);
+  EXPECT_TRUE(state.flowering);
+  EXPECT_DOUBLE_EQ(1.0, state.height);
+  EXPECT_DOUBLE_EQ(0.0, state.produce);
+
+  TestModel::Grow(params, &state, 10, conditions, Resources(), &consumed);
+  EXPECT_EQ(Plant::OLD, state.maturity);
+  EXPECT_FALSE(state.flowering);
+  EXPECT_DOUBLE_EQ(1.0, state.height);
+  EXPECT_DOUBLE_EQ(20.0, state.produce);
+  EXPECT_DOUBLE_EQ(300.0, state.biomass);
+  EXPECT_EQ(Plant::kMaxHealth, state.health);
+}
+
+TEST(GddGrowthModelTest, DailyTest) {
+  const TestModel::Params params = TestModel::MakeParams(kTestParams);
+  Plant::GrowthState hourly = NewState();
+  Plant::GrowthState daily = NewState();
+
+  // a day by hours grows as much as the day at once
+  GrowSineDay(params, 4.0, 24.0, 24, &hourly);
+  const GrowthConditions conditions = {14.0, {4.0, 24.0}, 12.0, 1.0};
+  Resources consumed;
+  TestModel::GrowDays(params, &daily, 1, conditions, Resources(), &consumed);
+  EXPECT_NEAR(daily.accumulated_gdd, hourly.accumulated_gdd, 50);
+  EXPECT_NEAR(daily.height, hourly.height, 1e-3);
+
+  TestModel::GrowDays(params, &daily, 2, conditions, Resources(), &consumed);
+  EXPECT_NEAR(3 * DailyGrowingDegreeDays(4.0, 24.0, 10.0) * 1000.0,
+              daily.accumulated_gdd, 1.0);
+}
+
+TEST(GddGrowthModelTest, WaterFactorTest) {
+  const TestModel::Params params = TestModel::MakeParams(kTestParams);
+  const GrowthConditions conditions = {20.0, {15.0, 25.0}, 12.0, 1.0};
+  Plant::GrowthState state = NewState();
+  state.water_factor = 0.5;
+  Resources consumed;
+  TestModel::Grow(params, &state, 5, conditions, Resources(), &consumed);
+  // development follows the temperature, growth the water
+  EXPECT_EQ(50000, state.accumulated_gdd);
+  EXPECT_DOUBLE_EQ(0.25, state.height);
+  EXPECT_DOUBLE_EQ(50.0, state.biomass);
+}
+
+TEST(GddGrowthModelTest, StressTest) {
+  const TestModel::Params params = TestModel::MakeParams(kTestParams);
+  const GrowthConditions cold = {-1.0, {-3.0, 1.0}, 12.0, 0.5};
+  Plant::GrowthState state = NewState();
+  Resources consumed;
+
+  // a health point per whole day of killing temperature
+  TestModel::Grow(params, &state, 1, cold, Resources(), &consumed);
+  EXPECT_EQ(Plant::kMaxHealth, state.health);
+  TestModel::Grow(params, &state, 1, cold, Resources(), &consumed);
+  EXPECT_EQ(Plant::kMaxHealth - 1, state.health);
+  TestModel::GrowDays(params, &state, 2, cold, Resources(), &consumed);
+  EXPECT_EQ(Plant::kMaxHealth - 3, state.health);
+  EXPECT_EQ(0, state.accumulated_gdd);
+
+  // a weak plant grows less
+  const GrowthConditions warm = {20.0, {15.0, 25.0}, 12.0, 1.0};
+  TestModel::Grow(params, &state, 1, warm, Resources(), &consumed);
+  EXPECT_DOUBLE_EQ(0.07, state.height);
+
+  // and a dead one not at all
+  TestModel::GrowDays(params, &state, 100, cold, Resources(), &consumed);
+  EXPECT_EQ(Plant::kMinHealth, state.health);
+  TestModel::Grow(params, &state, 1, warm, Resources(), &consumed);
+  EXPECT_EQ(10000, state.accumulated_gdd);
+}
+
+TEST(GddGrowthModelTest, PhotoPeriodTest) {
+  const TestModel::Params params = TestModel::MakeParams(kTestParams);
+  const GrowthConditions long_day = {20.0, {15.0, 25.0}, 18.0, 1.0};
+  Plant::GrowthState state = NewState();
+  Resources consumed;
+  TestModel::Grow(params, &state, 5, long_day, Resources(), &consumed);
+  TestModel::GrowDays(params, &state, 5, long_day, Resources(), &consumed);
+  EXPECT_EQ(0, state.accumulated_gdd);
+  EXPECT_EQ(Plant::SEED, state.maturity);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
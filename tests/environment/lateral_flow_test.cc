@@ -0,0 +1,106 @@
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "environment/lateral_flow.h"
+
+using namespace environment;
+
+namespace {
+
+double Sum(const std::vector<double> &values) {
+  return std::accumulate(values.begin(), values.end(), 0.0);
+}
+
+}  // namespace
+
+// Water spreads from a wet cell to its neighbours alike, and none is lost
+TEST(LateralFlowTest, SpreadTest) {
+  constexpr size_t kRows = 5;
+  constexpr size_t kCols = 5;
+  std::vector<double> water_content(kRows * kCols, 0.1);
+  water_content[2 * kCols + 2] = 0.35;
+  const double total = Sum(water_content);
+
+  LateralFlowParameters params;
+  params.tolerance = 1e-12;
+  LateralFlow lateral_flow(params);
+  EXPECT_GT(lateral_flow.Redistribute(1.0, kRows, kCols, &water_content), 1);
+
+  EXPECT_NEAR(total, Sum(water_content), 1e-9);
+  EXPECT_LT(water_content[2 * kCols + 2], 0.35);
+  EXPECT_GT(water_content[2 * kCols + 1], 0.1);
+  EXPECT_NEAR(water_content[2 * kCols + 1], water_content[2 * kCols + 3],
+              1e-9);
+  EXPECT_NEAR(water_content[1 * kCols + 2], water_content[3 * kCols + 2],
+              1e-9);
+  EXPECT_NEAR(water_content[2 * kCols + 1], water_content[1 * kCols + 2],
+              1e-9);
+  // nothing becomes wetter than the wettest cell or drier than the driest
+  for (const double value : water_content) {
+    EXPECT_LE(value, 0.35);
+    EXPECT_GE(value, 0.1 - 1e-9);
+  }
+}
+
+// A uniform grid stays as it is
+TEST(LateralFlowTest, UniformTest) {
+  std::vector<double> water_content(4 * 3, 0.2);
+  LateralFlow lateral_flow;
+  EXPECT_EQ(1, lateral_flow.Redistribute(1.0, 4, 3, &water_content));
+  for (const double value : water_content) {
+    EXPECT_NEAR(0.2, value, 1e-12);
+  }
+}
+
+// Sweeping the rows on several threads gives the same water content
+TEST(LateralFlowTest, ThreadsTest) {
+  constexpr size_t kSize = 256;
+  std::vector<double> water_content(kSize * kSize, 0.1);
+  for (size_t i = 0; i < kSize; ++i) {
+    // a furrow along the middle of the field
+    water_content[i * kSize + kSize / 2] = 0.39;
+  }
+  std::vector<double> threaded = water_content;
+
+  LateralFlowParameters params;
+  params.num_threads = 1;
+  LateralFlow(params).Redistribute(0.5, kSize, kSize, &water_content);
+  params.num_threads = 4;
+  LateralFlow(params).Redistribute(0.5, kSize, kSize, &threaded);
+  for (size_t i = 0; i < water_content.size(); ++i) {
+    ASSERT_DOUBLE_EQ(water_content[i], threaded[i]);
+  }
+  EXPECT_GT(water_content[kSize / 2 + 1], 0.1);
+}
+
+// All soil cells are written back, and the ones which changed are reported
+TEST(LateralFlowTest, SoilContainerTest) {
+  SoilContainer soils(3);
+  soils[Coordinate(1, 1)].AddWaterToSoil(0.3);
+
+  LateralFlow lateral_flow;
+  std::vector<Coordinate> changed_cells;
+  lateral_flow.Redistribute(1.0, &soils, &changed_cells);
+  EXPECT_LT(soils[Coordinate(1, 1)].surface_water_content(), 0.3);
+  EXPECT_GT(soils[Coordinate(0, 1)].surface_water_content(), 0.0);
+  EXPECT_EQ(0.0, soils[Coordinate(0, 1)].water_content()[1]);
+
+  double total = 0.0;
+  for (size_t x = 0; x < soils.size(); ++x) {
+    for (size_t y = 0; y < soils.size(); ++y) {
+      total += soils[Coordinate(x, y)].surface_water_content();
+    }
+  }
+  EXPECT_NEAR(0.3, total, 1e-6);
+  // dry soil barely conducts, so hardly any water reaches the corners
+  EXPECT_EQ(5, changed_cells.size());
+  EXPECT_NEAR(0.0, soils[Coordinate(0, 0)].surface_water_content(),
+              lateral_flow.params().tolerance);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,6 +1,8 @@
 #include <chrono>
 #include <cstdio>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -92,6 +94,38 @@ TEST_F(MeteorologyTest, On_09_21) {
 
 // TODO: add more tests
 
+// Environments stepped on several threads each see their own local time
+TEST_F(MeteorologyTest, ParallelUpdateTest) {
+  const Location location(0, 1, 35, 34);
+  const int kNumThreads = 8;
+  std::vector<std::chrono::system_clock::time_point> times;
+  std::vector<double> expected;
+  for (int i = 0; i < kNumThreads; ++i) {
+    times.push_back(CreateTimePoint(2019, 1 + i, 1 + 3 * i, 6 + i, 0, 0));
+    expected.push_back(
+        Meteorology(times[i], location, climate_zone_, *weather_)
+            .solar_elevation());
+  }
+
+  std::vector<double> elevations(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      Meteorology meteorology(times[i], location, climate_zone_, *weather_);
+      for (int step = 0; step < 1000; ++step) {
+        meteorology.Update(times[i], *weather_);
+      }
+      elevations[i] = meteorology.solar_elevation();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    EXPECT_DOUBLE_EQ(expected[i], elevations[i]);
+  }
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -21,6 +21,29 @@ TEST(BeanTest, GenerateTest) {
   EXPECT_EQ(kBeanTypeName, plant->name());
 }
 
+TEST(BeanTest, ParamsTest) {
+  Config dumb_config("place name", Location(100, 101, 201, 200));
+  Climate dumb_climate(dumb_config);
+  Weather dumb_weather(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  Meteorology dumb_meteorology(std::chrono::system_clock::now(),
+                               dumb_config.location, dumb_climate.climate_zone,
+                               dumb_weather);
+  std::unique_ptr<environment::Plant> plant(
+      environment::PlantBuilder::NewPlant(kBeanTypeName, dumb_meteorology));
+  std::unique_ptr<environment::Plant> low_yield_plant(
+      environment::PlantBuilder::NewPlant(
+          kBeanTypeName, dumb_meteorology,
+          {{PlantProperty::MAX_HARVEST_YIELD, 5}}));
+
+  // all beans share the parameters of their species
+  EXPECT_EQ(&plant->species_params(), &low_yield_plant->species_params());
+  EXPECT_EQ(plant->species_params()[PlantProperty::MAX_HARVEST_YIELD],
+            plant->param(PlantProperty::MAX_HARVEST_YIELD));
+  EXPECT_EQ(5, low_yield_plant->param(PlantProperty::MAX_HARVEST_YIELD));
+  EXPECT_EQ(plant->param(PlantProperty::GDD_BASE_TEMPERATURE),
+            low_yield_plant->param(PlantProperty::GDD_BASE_TEMPERATURE));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,65 @@
+#include <array>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "environment/meteorology.h"
+#include "environment/quadrature.h"
+
+using namespace environment;
+
+TEST(QuadratureTest, PolynomialTest) {
+  int evaluations = 0;
+  auto f = [&evaluations](const double x) {
+    ++evaluations;
+    return std::array<double, 1>{std::pow(x, 9) + 3.0 * x * x - 1.0};
+  };
+  // exact for degree 9, so the first split already agrees
+  const std::array<double, 1> integral =
+      IntegrateGaussLegendre<1>(f, 0.0, 2.0);
+  EXPECT_NEAR(1024.0 / 10.0 + 8.0 - 2.0, integral[0], 1e-9);
+  EXPECT_EQ(15, evaluations);
+}
+
+TEST(QuadratureTest, DaylightTest) {
+  // a flux which follows the elevation of the sun from 6 to 18 hours
+  int evaluations = 0;
+  auto f = [&evaluations](const double hour) {
+    ++evaluations;
+    const double flux = 500.0 * std::sin(kPI * (hour - 6.0) / 12.0);
+    return std::array<double, 2>{flux, -0.5 * flux};
+  };
+  const std::array<double, 2> integral =
+      IntegrateGaussLegendre<2>(f, 6.0, 18.0);
+  const double expected = 500.0 * 24.0 / kPI;
+  EXPECT_NEAR(expected, integral[0], 1e-6 * expected);
+  EXPECT_NEAR(-0.5 * expected, integral[1], 1e-6 * expected);
+  // fewer evaluations than one per hour of the day
+  EXPECT_LT(evaluations, kHoursPerDay);
+}
+
+TEST(QuadratureTest, AdaptiveTest) {
+  // the kink is only resolved by splitting the intervals around it
+  int evaluations = 0;
+  auto f = [&evaluations](const double x) {
+    ++evaluations;
+    return std::array<double, 1>{std::abs(x - 0.3)};
+  };
+  QuadratureOptions options;
+  options.relative_tolerance = 1e-6;
+  options.max_depth = 10;
+  const std::array<double, 1> integral =
+      IntegrateGaussLegendre<1>(f, 0.0, 1.0, options);
+  EXPECT_NEAR(0.29, integral[0], 1e-5);
+
+  // and the depth bounds the work
+  evaluations = 0;
+  options.max_depth = 0;
+  IntegrateGaussLegendre<1>(f, 0.0, 1.0, options);
+  EXPECT_EQ(15, evaluations);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "environment/soil.h"
+#include "environment/soil_container.h"
 
 using namespace environment;
 
@@ -12,8 +13,95 @@ TEST(SoilTest, ConstructorTest) {
   EXPECT_EQ(6.0, soil.pH());
   EXPECT_EQ(1.0, soil.salinity());
   EXPECT_EQ(2.0, soil.organic_matter());
-  EXPECT_EQ(0.0, soil.water_content().water_amount_1);
-  EXPECT_EQ(0.0, soil.water_content().water_amount_2);
+  ASSERT_EQ(2, soil.water_content().size());
+  EXPECT_EQ(0.0, soil.water_content()[0]);
+  EXPECT_EQ(0.0, soil.water_content()[1]);
+}
+
+// The layers below the top one are filled alike, as many as the profile has
+TEST(SoilTest, ProfileTest) {
+  Soil soil(Soil::SAND, 6.0, 1.0, 2.0, 0.1, 0.2);
+  const SoilProfile &profile = Soil::Profile(Soil::SAND);
+  ASSERT_EQ(profile.num_layers(), soil.water_content().size());
+  EXPECT_GT(profile.num_layers(), 2);
+  EXPECT_EQ(0.1, soil.surface_water_content());
+  for (size_t k = 1; k < profile.num_layers(); ++k) {
+    EXPECT_EQ(0.2, soil.water_content()[k]);
+  }
+  EXPECT_NEAR(0.2, soil.root_zone_water_content(), 1e-12);
+
+  double evaporation = 0.0;
+  double roots = 0.0;
+  for (const SoilLayer &layer : profile.layers) {
+    evaporation += layer.evaporation_fraction;
+    roots += layer.root_fraction;
+  }
+  EXPECT_NEAR(1.0, evaporation, 1e-12);
+  EXPECT_NEAR(1.0, roots, 1e-12);
+}
+
+// Updating the cells of a container at once is the same as one by one
+TEST(SoilTest, ContainerUpdateTest) {
+  SoilContainer soils(2);
+  soils[Coordinate(1, 1)] = Soil(Soil::SILT, 7.0, 0.0, 0.0, 0.3, 0.25);
+  soils[Coordinate(0, 1)] = Soil(Soil::CLAY, 7.0, 0.0, 0.0, 0.2, 0.3);
+  soils[Coordinate(1, 0)] = Soil(Soil::SILT, 7.0, 0.0, 0.0, 0.1, 0.15);
+  const std::vector<Coordinate> coordinates = {
+      Coordinate(1, 1), Coordinate(0, 1), Coordinate(1, 0)};
+  const std::vector<double> latent_heat_flux_soil = {100.0, 50.0, 80.0};
+  const std::vector<double> latent_heat_flux_crop = {200.0, 300.0, 10.0};
+
+  std::vector<Soil> expected;
+  for (size_t i = 0; i < coordinates.size(); ++i) {
+    expected.push_back(soils[coordinates[i]]);
+    expected.back().UpdateWaterContent(2.0, latent_heat_flux_soil[i] * 3600.0,
+                                       latent_heat_flux_crop[i] * 3600.0,
+                                       3600.0 / 86400.0);
+  }
+  const Soil untouched = soils[Coordinate(0, 0)];
+  soils.UpdateWaterContent(coordinates, 2.0, latent_heat_flux_soil,
+                           latent_heat_flux_crop, 3600.0);
+
+  for (size_t i = 0; i < coordinates.size(); ++i) {
+    EXPECT_EQ(expected[i], soils[coordinates[i]]);
+  }
+  EXPECT_EQ(untouched, soils[Coordinate(0, 0)]);
+  // and the rain outweighs an hour of evaporation
+  EXPECT_GT(soils[Coordinate(1, 1)].root_zone_water_content(), 0.25);
+}
+
+// The rain alone, on cells which neither evaporate nor transpire
+TEST(SoilTest, ContainerRainTest) {
+  SoilContainer soils(2);
+  soils[Coordinate(0, 1)] = Soil(Soil::SAND, 7.0, 0.0, 0.0, 0.1, 0.2);
+  const std::vector<Coordinate> coordinates = {Coordinate(0, 0),
+                                               Coordinate(0, 1)};
+
+  Soil expected = soils[Coordinate(0, 1)];
+  expected.UpdateWaterContent(5.0, 0.0, 0.0, 3600.0 / 86400.0);
+  std::vector<Coordinate> changed_cells;
+  soils.UpdateWaterContent(coordinates, 5.0, 3600.0, &changed_cells);
+  EXPECT_EQ(expected, soils[Coordinate(0, 1)]);
+  EXPECT_GT(soils[Coordinate(0, 0)].root_zone_water_content(), 0.0);
+  EXPECT_EQ(2, changed_cells.size());
+
+  // the water of a dry cell does not change without rain
+  soils[Coordinate(0, 0)] = Soil(Soil::CLAY, 7.0, 0.0, 0.0, 0.0, 0.0);
+  changed_cells.clear();
+  soils.UpdateWaterContent({Coordinate(0, 0)}, 0.0, 3600.0, &changed_cells);
+  EXPECT_TRUE(changed_cells.empty());
+}
+
+// A wet soil drains over the time step, less over a shorter one
+TEST(SoilTest, DrainageTest) {
+  const Soil wet(Soil::SAND, 7.0, 0.0, 0.0, 0.35, 0.35);
+  Soil hour = wet;
+  hour.UpdateWaterContent(0.0, 0.0, 0.0, 1.0 / 24.0);
+  Soil day = wet;
+  day.UpdateWaterContent(0.0, 0.0, 0.0, 1.0);
+
+  EXPECT_LT(hour.root_zone_water_content(), wet.root_zone_water_content());
+  EXPECT_LT(day.root_zone_water_content(), hour.root_zone_water_content());
 }
 
 // Soil equivalence test
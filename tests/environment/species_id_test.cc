@@ -0,0 +1,44 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "environment/plant_builder.h"
+#include "environment/species_id.h"
+
+using namespace environment;
+
+TEST(SpeciesIdTest, InternTest) {
+  const SpeciesId id = SpeciesId::Intern("species id test");
+  EXPECT_TRUE(id.valid());
+  EXPECT_EQ("species id test", id.name());
+  EXPECT_EQ(id, SpeciesId::Intern("species id test"));
+  EXPECT_EQ(id, SpeciesId::Find("species id test"));
+  EXPECT_EQ(id, SpeciesId("species id test"));
+  EXPECT_LT(id.value(), SpeciesId::size());
+
+  const SpeciesId other = SpeciesId::Intern("another species id test");
+  EXPECT_NE(id, other);
+  EXPECT_EQ("species id test", id.name());
+}
+
+TEST(SpeciesIdTest, InvalidTest) {
+  EXPECT_FALSE(SpeciesId().valid());
+  EXPECT_EQ("", SpeciesId().name());
+  EXPECT_FALSE(SpeciesId::Intern("").valid());
+  EXPECT_FALSE(SpeciesId("never interned").valid());
+  EXPECT_FALSE(SpeciesId::Find("never interned").valid());
+  EXPECT_EQ("", SpeciesId(uint16_t(SpeciesId::size())).name());
+}
+
+TEST(SpeciesIdTest, RegisteredPlantTest) {
+  // registering a model interns its name
+  const SpeciesId bean("bean");
+  ASSERT_TRUE(bean.valid());
+  EXPECT_EQ("bean", bean.name());
+  EXPECT_EQ(bean, SpeciesId::Find("bean"));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
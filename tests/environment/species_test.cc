@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "environment/plant_builder.h"
+#include "environment/plant_container.h"
+#include "environment/species.h"
+
+using namespace config;
+using namespace environment;
+
+namespace environment {
+
+namespace plants {
+
+// Bears one gram per time step, up to its maximum yield.
+struct SproutModel {
+  struct Params {
+    int max_yield;
+  };
+
+  static Params MakeParams(const PlantParams &params) {
+    return {int(params[PlantProperty::MAX_HARVEST_YIELD])};
+  }
+
+  static void Grow(const Params &params, Plant::GrowthState *state,
+                   const int64_t num_time_step,
+                   const GrowthConditions &conditions,
+                   const Resources &available, Resources *consumed) {
+    state->produce = std::min<double>(params.max_yield,
+                                      state->produce + num_time_step);
+    (*consumed)[ResourceType::NITROGEN] += num_time_step;
+  }
+
+  // A day is one time step.
+  static void GrowDays(const Params &params, Plant::GrowthState *state,
+                       const int64_t num_days,
+                       const GrowthConditions &conditions,
+                       const Resources &available, Resources *consumed) {
+    Grow(params, state, num_days, conditions, available, consumed);
+  }
+};
+
+class Sprout : public Plant {
+ public:
+  Sprout(const SpeciesId species_id, const Meteorology &meteorology)
+      : Plant(species_id, meteorology, 0.0, 0.0,
+              SpeciesRegistry::GetSpecies(species_id)) {}
+
+  std::unique_ptr<Plant> Clone() const override {
+    return std::make_unique<Sprout>(*this);
+  }
+
+  Resources GrowStep(const int64_t num_time_step,
+                     const GrowthConditions &conditions,
+                     const Resources &available) override {
+    Resources consumed;
+    SproutModel::Grow(SproutModel::MakeParams(params()),
+                      mutable_growth_state(), num_time_step, conditions,
+                      available, &consumed);
+    return consumed;
+  }
+};
+
+// A plant without a species, which grows on its own.
+class Weed : public Plant {
+ public:
+  Weed(const SpeciesId species_id, const Meteorology &meteorology)
+      : Plant(species_id, meteorology) {}
+
+  std::unique_ptr<Plant> Clone() const override {
+    return std::make_unique<Weed>(*this);
+  }
+
+  Resources GrowStep(const int64_t num_time_step,
+                     const GrowthConditions &conditions,
+                     const Resources &available) override {
+    mutable_growth_state()->produce += 10 * num_time_step;
+    return Resources();
+  }
+};
+
+}  // namespace plants
+
+using plants::SproutModel;
+
+const PlantParams kSproutParams = {{PlantProperty::MAX_HARVEST_YIELD, 3}};
+
+const GrowthConditions kConditions = {20.0, {10.0, 30.0}, 12.0, 1.0};
+
+ADD_SPECIES(SproutModel, "sprout", kSproutParams);
+ADD_PLANT(Sprout, "sprout");
+ADD_PLANT(Weed, "weed");
+
+}  // namespace environment
+
+class SpeciesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Location dumb_location(100, 101, 201, 200);
+    Config dumb_config("place name", dumb_location);
+    Climate dumb_climate(dumb_config);
+    Weather dumb_weather(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    meteorology_.reset(
+        new Meteorology(std::chrono::system_clock::now(), dumb_config.location,
+                        dumb_climate.climate_zone, dumb_weather));
+  }
+
+  std::unique_ptr<Meteorology> meteorology_;
+};
+
+TEST_F(SpeciesTest, RegistryTest) {
+  const Species *sprout = SpeciesRegistry::GetSpecies("sprout");
+  ASSERT_NE(nullptr, sprout);
+  EXPECT_EQ("sprout", sprout->name());
+  EXPECT_EQ(3, sprout->params()[PlantProperty::MAX_HARVEST_YIELD]);
+  EXPECT_NE(nullptr, SpeciesRegistry::GetSpecies("bean"));
+  EXPECT_EQ(nullptr, SpeciesRegistry::GetSpecies("weed"));
+
+  // a species is only registered once
+  EXPECT_FALSE(SpeciesRegistry::RegisterSpecies(
+      std::make_unique<ModelSpecies<SproutModel>>("sprout", kDefaultParams)));
+  EXPECT_EQ(sprout, SpeciesRegistry::GetSpecies("sprout"));
+
+  std::vector<std::string> list = SpeciesRegistry::GetSpeciesList();
+  EXPECT_NE(list.end(), std::find(list.begin(), list.end(), "sprout"));
+}
+
+TEST_F(SpeciesTest, PlantSpeciesTest) {
+  std::unique_ptr<Plant> sprout(
+      PlantBuilder::NewPlant("sprout", *meteorology_));
+  std::unique_ptr<Plant> weed(PlantBuilder::NewPlant("weed", *meteorology_));
+  std::unique_ptr<Plant> big_sprout(PlantBuilder::NewPlant(
+      "sprout", *meteorology_, {{PlantProperty::MAX_HARVEST_YIELD, 5}}));
+
+  EXPECT_EQ(SpeciesRegistry::GetSpecies("sprout"), sprout->species());
+  EXPECT_EQ(&sprout->species()->params(), &sprout->species_params());
+  EXPECT_FALSE(sprout->has_overrides());
+  EXPECT_EQ(nullptr, weed->species());
+  EXPECT_EQ(&kDefaultParams, &weed->species_params());
+  EXPECT_TRUE(big_sprout->has_overrides());
+  EXPECT_EQ(5, big_sprout->params()[PlantProperty::MAX_HARVEST_YIELD]);
+  EXPECT_EQ(kSproutParams[PlantProperty::GDD_BASE_TEMPERATURE],
+            big_sprout->params()[PlantProperty::GDD_BASE_TEMPERATURE]);
+}
+
+TEST_F(SpeciesTest, GrowBatchTest) {
+  std::unique_ptr<Plant> plant1(
+      PlantBuilder::NewPlant("sprout", *meteorology_));
+  std::unique_ptr<Plant> plant2(
+      PlantBuilder::NewPlant("sprout", *meteorology_));
+  Plant *plants[] = {plant1.get(), plant2.get()};
+
+  const Resources consumed =
+      plant1->species()->GrowBatch(plants, 2, 2, kConditions, Resources());
+  EXPECT_EQ(2, plant1->produce());
+  EXPECT_EQ(2, plant2->produce());
+  EXPECT_EQ(4, consumed[ResourceType::NITROGEN]);
+
+  // the kernel grows the plants like their own GrowStep
+  std::unique_ptr<Plant> plant3(
+      PlantBuilder::NewPlant("sprout", *meteorology_));
+  EXPECT_EQ(consumed[ResourceType::NITROGEN] / 2,
+            plant3->GrowStep(2, kConditions,
+                             Resources())[ResourceType::NITROGEN]);
+  EXPECT_EQ(plant1->produce(), plant3->produce());
+
+  plant1->species()->GrowBatch(plants, 2, 2, kConditions, Resources());
+  EXPECT_EQ(3, plant1->produce());
+  EXPECT_EQ(3, plant2->produce());
+}
+
+TEST_F(SpeciesTest, GrowPlantsTest) {
+  PlantContainer container;
+  Plant *sprout1 =
+      container.AddPlant("sprout", Coordinate(0.0, 0.0), *meteorology_);
+  Plant *weed = container.AddPlant("weed", Coordinate(1.0, 0.0), *meteorology_);
+  Plant *bean = container.AddPlant("bean", Coordinate(2.0, 0.0), *meteorology_);
+  ASSERT_NE(nullptr, sprout1);
+  ASSERT_NE(nullptr, weed);
+  ASSERT_NE(nullptr, bean);
+
+  Resources consumed = container.GrowPlants(1, kConditions, Resources());
+  EXPECT_EQ(1, sprout1->produce());
+  EXPECT_EQ(10, weed->produce());
+  EXPECT_EQ(1, consumed[ResourceType::NITROGEN]);
+
+  // plants added later are grown as well
+  Plant *sprout2 =
+      container.AddPlant("sprout", Coordinate(3.0, 0.0), *meteorology_);
+  ASSERT_NE(nullptr, sprout2);
+  consumed = container.GrowPlants(1, kConditions, Resources());
+  EXPECT_EQ(2, sprout1->produce());
+  EXPECT_EQ(1, sprout2->produce());
+  EXPECT_EQ(20, weed->produce());
+  EXPECT_EQ(2, consumed[ResourceType::NITROGEN]);
+
+  // and copies grow their own plants
+  PlantContainer copy(container);
+  copy.GrowPlants(1, kConditions, Resources());
+  EXPECT_EQ(2, sprout1->produce());
+  EXPECT_EQ(3, copy.GetPlant(Coordinate(0.0, 0.0))->produce());
+
+  // plants without a daily model grow one step per day
+  consumed = container.GrowPlantsDays(1, kConditions, Resources());
+  EXPECT_EQ(3, sprout1->produce());
+  EXPECT_EQ(2, sprout2->produce());
+  EXPECT_EQ(30, weed->produce());
+  EXPECT_EQ(2, consumed[ResourceType::NITROGEN]);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -36,6 +36,64 @@ TEST(TerrainTest, ConstructorTest) {
   EXPECT_EQ(5, terrain.size());
 }
 
+// Changed cells are reported once, from any earlier point on
+TEST(TerrainTest, ChangedCellsTest) {
+  Config dumb_config("place name", Location(100, 101, 201, 200));
+  Climate dumb_climate(dumb_config);
+  Weather dumb_weather(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  Meteorology dumb_meteorology(std::chrono::system_clock::now(),
+                               dumb_config.location, dumb_climate.climate_zone,
+                               dumb_weather);
+  TerrainRawData dumb_terrain_raw_data(5, 0);
+  Terrain terrain(dumb_terrain_raw_data, dumb_meteorology);
+
+  std::vector<size_t> cells;
+  EXPECT_TRUE(terrain.ChangedCellsSince(terrain.num_changes(), &cells));
+  EXPECT_TRUE(cells.empty());
+
+  terrain.MarkCellChanged(Coordinate(1, 2));
+  const uint64_t since = terrain.num_changes();
+  terrain.MarkCellChanged(Coordinate(3, 4));
+  terrain.MarkCellChanged(Coordinate(1, 2));
+  terrain.MarkCellChanged(Coordinate(1, 2));
+  // outside of the terrain
+  terrain.MarkCellChanged(Coordinate(5, 0));
+
+  EXPECT_TRUE(terrain.ChangedCellsSince(0, &cells));
+  EXPECT_EQ(std::vector<size_t>({19, 7}), cells);
+  cells.clear();
+  EXPECT_TRUE(terrain.ChangedCellsSince(since, &cells));
+  EXPECT_EQ(std::vector<size_t>({19, 7}), cells);
+
+  // the oldest changes are dropped eventually
+  for (int i = 0; i < 1000; ++i) {
+    terrain.MarkCellChanged(Coordinate(i % 5, i % 3));
+  }
+  cells.clear();
+  EXPECT_FALSE(terrain.ChangedCellsSince(since, &cells));
+  EXPECT_TRUE(terrain.ChangedCellsSince(terrain.num_changes() - 1, &cells));
+  EXPECT_EQ(1, cells.size());
+}
+
+// A cell changed again after the changes were read is reported again
+TEST(TerrainTest, ChangedAgainTest) {
+  Config dumb_config("place name", Location(100, 101, 201, 200));
+  Climate dumb_climate(dumb_config);
+  Weather dumb_weather(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  Meteorology dumb_meteorology(std::chrono::system_clock::now(),
+                               dumb_config.location, dumb_climate.climate_zone,
+                               dumb_weather);
+  TerrainRawData dumb_terrain_raw_data(1, 0);
+  Terrain terrain(dumb_terrain_raw_data, dumb_meteorology);
+
+  terrain.MarkCellChanged(Coordinate(0, 0));
+  const uint64_t since = terrain.num_changes();
+  terrain.MarkCellChanged(Coordinate(0, 0));
+  std::vector<size_t> cells;
+  EXPECT_TRUE(terrain.ChangedCellsSince(since, &cells));
+  EXPECT_EQ(std::vector<size_t>({0}), cells);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -46,6 +46,52 @@ TEST(MinMaxPairTest, OperatorTest) {
   EXPECT_FALSE(min_max_pair_1 != min_max_pair_2);
 }
 
+enum class Fruit { APPLE = 0, BANANA, CHERRY, NUM_FRUITS };
+using FruitCounts = EnumArray<Fruit, int, size_t(Fruit::NUM_FRUITS)>;
+
+// EnumArray starts with all values zero, except those listed
+TEST(EnumArrayTest, ConstructorTest) {
+  FruitCounts counts;
+  EXPECT_EQ(3, counts.size());
+  for (const int count : counts) {
+    EXPECT_EQ(0, count);
+  }
+
+  FruitCounts listed = {{Fruit::CHERRY, 3}, {Fruit::APPLE, 1}};
+  EXPECT_EQ(1, listed[Fruit::APPLE]);
+  EXPECT_EQ(0, listed[Fruit::BANANA]);
+  EXPECT_EQ(3, listed[Fruit::CHERRY]);
+}
+
+// EnumArray values are indexed by their keys
+TEST(EnumArrayTest, OperatorTest) {
+  FruitCounts counts;
+  counts[Fruit::BANANA] = 2;
+  counts[Fruit::BANANA] += 3;
+  EXPECT_EQ(5, counts[Fruit::BANANA]);
+  EXPECT_EQ(Fruit::BANANA, FruitCounts::key(1));
+
+  FruitCounts other;
+  EXPECT_TRUE(counts != other);
+  other[Fruit::BANANA] = 5;
+  EXPECT_TRUE(counts == other);
+}
+
+// Copies and assigned objects draw ids of their own
+TEST(InstanceIdTest, CopyTest) {
+  InstanceId first;
+  const InstanceId second;
+  EXPECT_NE(0, first.value());
+  EXPECT_NE(first.value(), second.value());
+
+  const InstanceId copy(first);
+  EXPECT_NE(first.value(), copy.value());
+  const uint64_t before = first.value();
+  first = second;
+  EXPECT_NE(before, first.value());
+  EXPECT_NE(second.value(), first.value());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,165 @@
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "environment/meteorology.h"
+#include "environment/weather_generator.h"
+
+using namespace config;
+using namespace environment;
+
+class WeatherGeneratorTest : public ::testing::Test {
+ protected:
+  std::chrono::system_clock::time_point CreateTimePoint(
+      const int year, const int month, const int day, const int hour,
+      const int minute, const int second) {
+    struct tm tm = {};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = second;
+    tm.tm_isdst = -1;
+
+    return std::chrono::system_clock::from_time_t(mktime(&tm));
+  }
+
+  void ExpectSameMeteorology(const Meteorology &expected,
+                             const Meteorology &actual) {
+    EXPECT_DOUBLE_EQ(expected.solar_elevation(), actual.solar_elevation());
+    EXPECT_DOUBLE_EQ(expected.solar_azimuth(), actual.solar_azimuth());
+    EXPECT_DOUBLE_EQ(expected.hourly_total_irradiance(),
+                     actual.hourly_total_irradiance());
+    EXPECT_DOUBLE_EQ(expected.hourly_direct_irradiance(),
+                     actual.hourly_direct_irradiance());
+    EXPECT_DOUBLE_EQ(expected.hourly_diffuse_irradiance(),
+                     actual.hourly_diffuse_irradiance());
+    EXPECT_DOUBLE_EQ(expected.hourly_net_radiation(),
+                     actual.hourly_net_radiation());
+    EXPECT_DOUBLE_EQ(expected.air_temperature(), actual.air_temperature());
+    EXPECT_DOUBLE_EQ(expected.saturated_vapor_pressure(),
+                     actual.saturated_vapor_pressure());
+    EXPECT_DOUBLE_EQ(expected.actual_vapor_pressure(),
+                     actual.actual_vapor_pressure());
+    EXPECT_DOUBLE_EQ(expected.wind_speed(), actual.wind_speed());
+    EXPECT_DOUBLE_EQ(expected.day_length(), actual.day_length());
+  }
+
+  const Location location_ = Location(0, 1, 35, 34);
+  const Climate::ZoneType climate_zone_ = Climate::SubtropicalDrySummer;
+  const Weather weather_ = Weather(10.0, 12.0, 28.0, 40.0, 3.0, 0.0);
+};
+
+// The curves give what meteorology calculates at each step
+TEST_F(WeatherGeneratorTest, CurveTest) {
+  const auto start = CreateTimePoint(2019, 6, 21, 0, 0, 0);
+  Meteorology generated(start, location_, climate_zone_, weather_);
+  WeatherGenerator generator(std::chrono::minutes(20));
+  EXPECT_EQ(72, generator.num_steps());
+
+  for (int minute = 0; minute < 24 * 60; minute += 20) {
+    const auto time = start + std::chrono::minutes(minute);
+    generator.Update(time, weather_, &generated);
+    const Meteorology expected(time, location_, climate_zone_, weather_);
+    ExpectSameMeteorology(expected, generated);
+  }
+  EXPECT_EQ(1, generator.num_generated_days());
+}
+
+TEST_F(WeatherGeneratorTest, CacheTest) {
+  const auto start = CreateTimePoint(2019, 3, 1, 0, 0, 0);
+  Meteorology meteorology(start, location_, climate_zone_, weather_);
+  WeatherGenerator generator(std::chrono::hours(1));
+  EXPECT_EQ(24, generator.num_steps());
+
+  for (int hour = 0; hour < 48; ++hour) {
+    generator.Update(start + std::chrono::hours(hour), weather_, &meteorology);
+  }
+  EXPECT_EQ(2, generator.num_generated_days());
+
+  // a change of the weather generates the day again
+  const Weather rainy(2.0, 10.0, 16.0, 90.0, 5.0, 20.0);
+  const auto time = start + std::chrono::hours(50);
+  generator.Update(time, rainy, &meteorology);
+  EXPECT_EQ(3, generator.num_generated_days());
+  ExpectSameMeteorology(Meteorology(time, location_, climate_zone_, rainy),
+                        meteorology);
+}
+
+// A time between the steps is calculated without generating the day
+TEST_F(WeatherGeneratorTest, OffStepTest) {
+  const auto time = CreateTimePoint(2019, 9, 1, 12, 30, 0);
+  Meteorology meteorology(time - std::chrono::hours(30), location_,
+                          climate_zone_, weather_);
+  WeatherGenerator generator(std::chrono::hours(1));
+  generator.Update(time, weather_, &meteorology);
+  EXPECT_EQ(0, generator.num_generated_days());
+  ExpectSameMeteorology(Meteorology(time, location_, climate_zone_, weather_),
+                        meteorology);
+}
+
+// The vapor of the air is the same all day, so the relative humidity is lower
+// in the afternoon than at dawn
+TEST_F(WeatherGeneratorTest, HumidityTest) {
+  const auto start = CreateTimePoint(2019, 6, 21, 0, 0, 0);
+  Meteorology meteorology(start, location_, climate_zone_, weather_);
+  WeatherGenerator generator(std::chrono::hours(1));
+
+  generator.Update(start + std::chrono::hours(4), weather_, &meteorology);
+  const double dawn_vapor_pressure = meteorology.actual_vapor_pressure();
+  const double dawn_humidity = meteorology.relative_humidity();
+  generator.Update(start + std::chrono::hours(13), weather_, &meteorology);
+  EXPECT_DOUBLE_EQ(dawn_vapor_pressure, meteorology.actual_vapor_pressure());
+  EXPECT_GT(dawn_humidity, meteorology.relative_humidity());
+  EXPECT_GT(meteorology.relative_humidity(), 0.0);
+  EXPECT_LE(dawn_humidity, 100.0);
+
+  // saturated air does not hold more vapor than it can
+  const Weather foggy(0.0, 12.0, 28.0, 100.0, 0.0, 0.0);
+  generator.Update(start + std::chrono::hours(4), foggy, &meteorology);
+  EXPECT_DOUBLE_EQ(100.0, meteorology.relative_humidity());
+}
+
+// Generators on different threads each read their own local time
+TEST_F(WeatherGeneratorTest, ParallelUpdateTest) {
+  const int kNumThreads = 8;
+  std::vector<std::chrono::system_clock::time_point> times;
+  for (int i = 0; i < kNumThreads; ++i) {
+    times.push_back(CreateTimePoint(2019, 1 + i, 1 + 3 * i, 0, 0, 0));
+  }
+
+  std::vector<int> num_generated_days(kNumThreads);
+  std::vector<double> elevations(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      Meteorology meteorology(times[i], location_, climate_zone_, weather_);
+      WeatherGenerator generator(std::chrono::hours(1));
+      for (int hour = 0; hour < 24 * 10; ++hour) {
+        generator.Update(times[i] + std::chrono::hours(hour), weather_,
+                         &meteorology);
+      }
+      num_generated_days[i] = generator.num_generated_days();
+      elevations[i] = meteorology.solar_elevation();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    EXPECT_EQ(10, num_generated_days[i]);
+    const auto last = times[i] + std::chrono::hours(24 * 10 - 1);
+    EXPECT_DOUBLE_EQ(
+        Meteorology(last, location_, climate_zone_, weather_).solar_elevation(),
+        elevations[i]);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "config/config.h"
+#include "config/terrain_raw_data.h"
+#include "environment/environment.h"
+#include "environment/weather_series.h"
+
+using namespace environment;
+
+class WeatherSeriesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::ofstream csv(csv_filename_);
+    // the second day is missing, and the fourth lacks its temperatures
+    csv << "\"NAME\",\"DATE\",\"PRCP\",\"TMAX\",\"TMIN\",\"TSUN\"\n"
+        << "\"DOWNTOWN, CA US\",\"1990-01-01\",\"0\",\"16.1\",\"8.3\",\"600\"\n"
+        << "\"DOWNTOWN, CA US\",\"1990-01-03\",\"11.4\",\"17.2\",\"10\",\"\"\n"
+        << "\"DOWNTOWN, CA US\",\"1990-01-04\",\"0.5\",\"\",\"\",\"120\"\n";
+  }
+
+  void TearDown() override {
+    std::remove(csv_filename_.c_str());
+    std::remove(filename_.c_str());
+  }
+
+  // 1990-01-01 00:00:00 UTC
+  static std::chrono::system_clock::time_point FirstDay() {
+    return std::chrono::system_clock::time_point(std::chrono::hours(24 * 7305));
+  }
+
+  const std::string csv_filename_ = "weather_series_test.csv";
+  const std::string filename_ = "weather_series_test.weather";
+  const Weather fallback_ = Weather(12.0, 5.0, 25.0, 50.0, 2.0, 0.0);
+};
+
+TEST_F(WeatherSeriesTest, ConvertTest) {
+  ASSERT_TRUE(WeatherSeries::ConvertCsv(csv_filename_, filename_));
+  const WeatherSeries series(filename_);
+  ASSERT_TRUE(series.is_open());
+  EXPECT_EQ(7305, series.first_day());
+  EXPECT_EQ(4, series.num_days());
+
+  const Weather first = series.GetWeather(0, fallback_);
+  EXPECT_FLOAT_EQ(16.1, first.air_temperature.max);
+  EXPECT_FLOAT_EQ(8.3, first.air_temperature.min);
+  EXPECT_FLOAT_EQ(0.0, first.rainfall);
+  EXPECT_FLOAT_EQ(10.0, first.total_sunshine_hour);
+  // the values which no record has are taken from the fallback
+  EXPECT_EQ(50.0, first.relative_humidity);
+  EXPECT_EQ(2.0, first.wind_speed);
+
+  // so are the days without records
+  EXPECT_EQ(fallback_, series.GetWeather(1, fallback_));
+
+  const Weather third = series.GetWeather(2, fallback_);
+  EXPECT_FLOAT_EQ(11.4, third.rainfall);
+  EXPECT_EQ(12.0, third.total_sunshine_hour);
+
+  const Weather fourth = series.GetWeather(3, fallback_);
+  EXPECT_EQ(5.0, fourth.air_temperature.min);
+  EXPECT_EQ(25.0, fourth.air_temperature.max);
+  EXPECT_FLOAT_EQ(2.0, fourth.total_sunshine_hour);
+}
+
+TEST_F(WeatherSeriesTest, DayIndexTest) {
+  ASSERT_TRUE(WeatherSeries::ConvertCsv(csv_filename_, filename_));
+  const WeatherSeries series(filename_);
+  ASSERT_TRUE(series.is_open());
+  EXPECT_EQ(0, series.DayIndex(FirstDay()));
+  EXPECT_EQ(0, series.DayIndex(FirstDay() + std::chrono::hours(23)));
+  EXPECT_EQ(2, series.DayIndex(FirstDay() + std::chrono::hours(48)));
+  EXPECT_EQ(-1, series.DayIndex(FirstDay() - std::chrono::hours(1)));
+}
+
+TEST_F(WeatherSeriesTest, InvalidTest) {
+  EXPECT_FALSE(WeatherSeries("no_such_file.weather").is_open());
+  // a CSV file is not a series
+  const WeatherSeries series(csv_filename_);
+  EXPECT_FALSE(series.is_open());
+  EXPECT_EQ(0, series.num_days());
+
+  std::ofstream csv(csv_filename_);
+  csv << "NAME,PRCP\nDOWNTOWN,0\n";
+  csv.close();
+  EXPECT_FALSE(WeatherSeries::ConvertCsv(csv_filename_, filename_));
+}
+
+// An environment reads the weather of each day it reaches
+TEST_F(WeatherSeriesTest, EnvironmentTest) {
+  ASSERT_TRUE(WeatherSeries::ConvertCsv(csv_filename_, filename_));
+  auto series = std::make_shared<const WeatherSeries>(filename_);
+  ASSERT_TRUE(series->is_open());
+
+  const config::Config config("place name",
+                              config::Location(100, 101, 201, 200));
+  Environment env(config, config::TerrainRawData(2, 0), FirstDay(),
+                  std::chrono::hours(1));
+  const Weather before = env.weather();
+  env.SetWeatherSeries(series);
+  EXPECT_FLOAT_EQ(16.1, env.weather().air_temperature.max);
+
+  // the weather of the last step simulated, which starts on the third day
+  env.JumpForwardTimeStep(49);
+  EXPECT_FLOAT_EQ(11.4, env.weather().rainfall);
+  // which rains on the cells without plants too
+  EXPECT_GT(env.terrain().soil_container()[Coordinate(0, 0)]
+                .root_zone_water_content(),
+            0.0);
+
+  // past the end of the series
+  env.JumpForwardTimeStep(48);
+  EXPECT_EQ(before, env.weather());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,43 @@
+#ifndef COMPUTATIONAL_AGROECOLOGY_TESTS_SIMULATORS_ASSET_PATH_H_
+#define COMPUTATIONAL_AGROECOLOGY_TESTS_SIMULATORS_ASSET_PATH_H_
+
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>       // _access
+#include <windows.h>  // GetModuleFileNameA
+#else
+#include <limits.h>
+#include <unistd.h>  // access, readlink
+#endif
+
+// Returns the path of `name` in the assets of the photon simulator, looked up
+// from the directory of the running test upwards, so that tests at any depth
+// of `tests/` find them. Falls back to the path relative to the working
+// directory.
+inline std::string AssetPath(const std::string &name = "") {
+  const std::string kAssetDir = "environment/simulators/photons/asset/";
+#ifdef _WIN32
+  char filename[MAX_PATH] = {0};
+  const DWORD count = GetModuleFileNameA(NULL, filename, MAX_PATH);
+#else
+  char filename[PATH_MAX];
+  const ssize_t count = readlink("/proc/self/exe", filename, PATH_MAX);
+#endif
+  std::string dir(filename, (count > 0) ? count : 0);
+  for (size_t end = dir.find_last_of("/\\"); end != std::string::npos;
+       end = dir.find_last_of("/\\")) {
+    dir.resize(end);
+    const std::string asset_dir = dir + "/" + kAssetDir;
+#ifdef _WIN32
+    if (_access(asset_dir.c_str(), 0) == 0) {
+#else
+    if (access(asset_dir.c_str(), F_OK) == 0) {
+#endif
+      return asset_dir + name;
+    }
+  }
+  return kAssetDir + name;
+}
+
+#endif  // COMPUTATIONAL_AGROECOLOGY_TESTS_SIMULATORS_ASSET_PATH_H_
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include "environment/environment.h"
+#include "environment/simulators/photon_simulator.h"
+#include "tests/simulators/asset_path.h"
+
+using namespace config;
+using namespace environment;
+using namespace simulator::photonsimulator;
+
+class PhotonSimulatorTest : public ::testing::Test {
+ protected:
+  PhotonSimulatorTest()
+      : config_("place name", Location(-83.0, -82.0, 43.0, 42.0)),
+        terrain_raw_data_(kTerrainSize, 0) {}
+
+  // Returns noon of the summer solstice in local time.
+  static std::chrono::system_clock::time_point SummerNoon() {
+    std::tm tm = {};
+    tm.tm_year = 2019 - 1900;
+    tm.tm_mon = 5;
+    tm.tm_mday = 21;
+    tm.tm_hour = 12;
+    tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  }
+
+  static const size_t kTerrainSize = 10;
+
+  // `Meteorology` refers to the location in the config, so it has to outlive
+  // the environment.
+  const Config config_;
+  const TerrainRawData terrain_raw_data_;
+};
+
+TEST_F(PhotonSimulatorTest, WriteAbsorbedFluxTest) {
+  Environment env(config_, terrain_raw_data_, SummerNoon(),
+                  std::chrono::hours(1));
+  Plant *plant = env.mutable_terrain().plant_container().AddPlant(
+      "bean", Coordinate(5.0, 5.0), env.meteorology());
+  ASSERT_NE(nullptr, plant);
+  EXPECT_DOUBLE_EQ(0.0, plant->plant_radiation().absorbed_flux());
+
+  env.SetPhotonSimulator(std::make_shared<PhotonSimulator>(10, 0.1, 20.0,
+                                                           AssetPath()),
+                         24);
+  env.JumpForwardTimeStep(1);
+  EXPECT_GT(plant->plant_radiation().absorbed_flux(), 0.0);
+}
+
+// A simulator rebuilds its scene for another environment, even one which
+// takes the place of a freed one
+TEST_F(PhotonSimulatorTest, NewEnvironmentTest) {
+  auto simulator = std::make_shared<PhotonSimulator>(10, 0.1, 20.0, AssetPath());
+  auto env = std::make_unique<Environment>(config_, terrain_raw_data_,
+                                           SummerNoon(), std::chrono::hours(1));
+  env->mutable_terrain().plant_container().AddPlant(
+      "bean", Coordinate(5.0, 5.0), env->meteorology());
+  env->SetPhotonSimulator(simulator, 24);
+  env->JumpForwardTimeStep(1);
+  env.reset();
+
+  env = std::make_unique<Environment>(config_, terrain_raw_data_, SummerNoon(),
+                                      std::chrono::hours(1));
+  Plant *plant = env->mutable_terrain().plant_container().AddPlant(
+      "bean", Coordinate(5.0, 5.0), env->meteorology());
+  ASSERT_NE(nullptr, plant);
+  env->SetPhotonSimulator(simulator, 24);
+  env->JumpForwardTimeStep(1);
+  EXPECT_GT(plant->plant_radiation().absorbed_flux(), 0.0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
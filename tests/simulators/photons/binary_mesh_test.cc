@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "environment/simulators/photons/model/binary_mesh.h"
+#include "environment/simulators/photons/model/geometry.h"
+#include "environment/simulators/photons/model/model.h"
+#include "environment/simulators/photons/photon_simulator_config.h"
+#include "tests/simulators/asset_path.h"
+
+using namespace simulator;
+using namespace photonsimulator;
+
+namespace {
+
+// Writes the binary mesh of Corn1.obj to `filename`, then overwrites
+// `sizeof(T)` bytes at `offset(header)` of it with `value`.
+template <typename T>
+void WriteCorruptMesh(const std::string &filename,
+                      uint64_t (*offset)(const binarymesh::Header &),
+                      const T value) {
+  Geometry(AssetPath("Corn1.obj").c_str()).WriteBinaryMesh(filename);
+  std::ifstream in(filename, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+  in.close();
+  binarymesh::Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  std::memcpy(data.data() + offset(header), &value, sizeof(value));
+  std::ofstream(filename, std::ios::binary).write(data.data(), data.size());
+}
+
+}  // namespace
+
+TEST(BinaryMeshTest, RoundTripTest) {
+  const std::string obj_filename = AssetPath("Corn1.obj");
+  const std::string mesh_filename =
+      std::string(P_tmpdir) + "/binary_mesh_test" + binarymesh::kExtension;
+
+  auto obj = std::make_shared<Geometry>(obj_filename.c_str());
+  ASSERT_TRUE(obj->WriteBinaryMesh(mesh_filename));
+  auto mapped = std::make_shared<Geometry>(mesh_filename.c_str());
+
+  EXPECT_EQ(obj->GetTotalFaces(), mapped->GetTotalFaces());
+  EXPECT_EQ(obj->vertices().size(), mapped->vertices().size());
+  EXPECT_EQ(obj->meshes().size(), mapped->meshes().size());
+  EXPECT_EQ(obj->bvh_nodes().size(), mapped->bvh_nodes().size());
+  ASSERT_EQ(obj->texture_infos().size(), mapped->texture_infos().size());
+  for (size_t i = 0; i < obj->texture_infos().size(); ++i) {
+    const Texture &expected = obj->texture_infos()[i];
+    const Texture &actual = mapped->texture_infos()[i];
+    EXPECT_EQ(expected.w, actual.w);
+    EXPECT_EQ(expected.h, actual.h);
+    ASSERT_EQ(expected.buffer.size(), actual.buffer.size());
+    EXPECT_TRUE(std::equal(expected.buffer.begin(), expected.buffer.end(),
+                           actual.buffer.begin()));
+  }
+
+  // rays cast down onto both geometries hit the same faces
+  const _462::Vector3 pos(1.0, 2.0, 0.0);
+  Model obj_model(obj, pos);
+  Model mapped_model(mapped, pos);
+  const _462::Vector3 dir(0.1, 0.05, -1.0);
+  int hits = 0;
+  for (double x = -1.0; x <= 1.0; x += 0.05) {
+    for (double y = -1.0; y <= 1.0; y += 0.05) {
+      const _462::Vector3 origin = pos + _462::Vector3(x, y, 10.0);
+      const Face *obj_face, *mapped_face;
+      const Mesh *obj_mesh, *mapped_mesh;
+      const _462::real_t obj_distance =
+          obj_model.FindFirstIntersect(&obj_face, &obj_mesh, origin, dir);
+      const _462::real_t mapped_distance = mapped_model.FindFirstIntersect(
+          &mapped_face, &mapped_mesh, origin, dir);
+      ASSERT_EQ(obj_face == nullptr, mapped_face == nullptr);
+      if (obj_face == nullptr) {
+        continue;
+      }
+      ++hits;
+      EXPECT_DOUBLE_EQ(obj_distance, mapped_distance);
+      EXPECT_EQ(obj_face - obj->faces().data(),
+                mapped_face - mapped->faces().data());
+      EXPECT_EQ(obj_mesh->first_face(), mapped_mesh->first_face());
+    }
+  }
+  EXPECT_GT(hits, 0);
+
+  std::remove(mesh_filename.c_str());
+}
+
+TEST(BinaryMeshTest, BvhMatchesBruteForceTest) {
+  auto geometry = std::make_shared<Geometry>(AssetPath("Corn1.obj").c_str());
+  Model model(geometry);
+  const _462::Vector3 dir(-0.2, 0.1, -1.0);
+  for (double x = -1.0; x <= 1.0; x += 0.1) {
+    for (double y = -1.0; y <= 1.0; y += 0.1) {
+      const _462::Vector3 origin(x, y, 10.0);
+      const Face *face;
+      const Mesh *mesh;
+      const _462::real_t distance =
+          model.FindFirstIntersect(&face, &mesh, origin, dir);
+
+      // test every face without the hierarchy
+      const Face *expected_face = nullptr;
+      _462::real_t expected_distance = std::numeric_limits<double>::max();
+      const _462::Vector3 dir_norm = _462::normalize(dir);
+      for (const auto &f : geometry->faces()) {
+        if (std::abs(_462::dot(dir_norm, f.normal)) < 1e-6) {
+          continue;
+        }
+        _462::Vector3 intersect = model.GetIntersect(f, origin, dir);
+        if (_462::dot(intersect - origin, dir_norm) < 1e-6) {
+          continue;
+        }
+        if (model.IsInTriangle(f, intersect) &&
+            _462::distance(origin, intersect) < expected_distance) {
+          expected_face = &f;
+          expected_distance = _462::distance(origin, intersect);
+        }
+      }
+      EXPECT_EQ(expected_face, face);
+      EXPECT_DOUBLE_EQ(expected_distance, distance);
+    }
+  }
+}
+
+// A file whose indices point outside of its sections is rejected
+TEST(BinaryMeshTest, InvalidIndexTest) {
+  const std::string filename =
+      std::string(P_tmpdir) + "/binary_mesh_test_invalid" +
+      binarymesh::kExtension;
+
+  // the vertex of the first face
+  WriteCorruptMesh<int>(
+      filename,
+      [](const binarymesh::Header &header) { return header.faces.offset; },
+      1 << 30);
+  EXPECT_FALSE(Geometry(filename.c_str()).is_loaded());
+
+  // the right child of the root, which would make it its own child
+  WriteCorruptMesh<uint32_t>(
+      filename,
+      [](const binarymesh::Header &header) {
+        return header.bvh_nodes.offset + offsetof(BvhNode, first);
+      },
+      0);
+  EXPECT_FALSE(Geometry(filename.c_str()).is_loaded());
+
+  // a face of a leaf
+  WriteCorruptMesh<uint32_t>(
+      filename,
+      [](const binarymesh::Header &header) {
+        return header.bvh_face_indices.offset;
+      },
+      90);
+  EXPECT_FALSE(Geometry(filename.c_str()).is_loaded());
+
+  // the normal of the first vertex, which the loader of 3d-obj files always
+  // assigns
+  WriteCorruptMesh<int>(
+      filename,
+      [](const binarymesh::Header &header) {
+        return header.faces.offset + offsetof(Vertex, normal_index);
+      },
+      -1);
+  EXPECT_FALSE(Geometry(filename.c_str()).is_loaded());
+
+  std::remove(filename.c_str());
+}
+
+// A binary mesh older than its 3d-obj file, or a corrupt one, is not used in
+// place of it
+TEST(BinaryMeshTest, StaleMeshTest) {
+  const std::string obj_filename =
+      std::string(P_tmpdir) + "/binary_mesh_test_triangle.obj";
+  const std::string mesh_filename =
+      std::string(P_tmpdir) + "/binary_mesh_test_triangle" +
+      binarymesh::kExtension;
+  std::ofstream(obj_filename) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+  ASSERT_TRUE(
+      Geometry(obj_filename.c_str()).WriteBinaryMesh(mesh_filename));
+
+  const auto obj_time = std::filesystem::last_write_time(obj_filename);
+  std::filesystem::last_write_time(mesh_filename,
+                                   obj_time + std::chrono::seconds(1));
+  EXPECT_TRUE(GeometryCache::Get(obj_filename)->is_mapped());
+  GeometryCache::Clear();
+
+  std::filesystem::last_write_time(mesh_filename,
+                                   obj_time - std::chrono::seconds(1));
+  const std::shared_ptr<Geometry> geometry = GeometryCache::Get(obj_filename);
+  EXPECT_FALSE(geometry->is_mapped());
+  EXPECT_EQ(1, geometry->GetTotalFaces());
+  GeometryCache::Clear();
+
+  // an up-to-date but corrupt one neither
+  std::ofstream(mesh_filename, std::ios::binary) << "not a mesh";
+  std::filesystem::last_write_time(mesh_filename,
+                                   obj_time + std::chrono::seconds(1));
+  const std::shared_ptr<Geometry> fallback = GeometryCache::Get(obj_filename);
+  EXPECT_TRUE(fallback->is_loaded());
+  EXPECT_FALSE(fallback->is_mapped());
+  EXPECT_EQ(1, fallback->GetTotalFaces());
+  GeometryCache::Clear();
+
+  std::remove(obj_filename.c_str());
+  std::remove(mesh_filename.c_str());
+}
+
+// Caches keyed on a geometry do not mistake a new one for a freed one
+TEST(BinaryMeshTest, IdTest) {
+  const std::string filename = AssetPath("Corn1.obj");
+  auto geometry = std::make_unique<Geometry>(filename.c_str());
+  const uint64_t id = geometry->id();
+  geometry.reset(new Geometry(filename.c_str()));
+  EXPECT_NE(id, geometry->id());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "environment/simulators/photons/model/geometry.h"
+#include "environment/simulators/photons/model/model.h"
+#include "tests/simulators/asset_path.h"
+
+using namespace simulator;
+using namespace photonsimulator;
+
+class GeometryCacheTest : public ::testing::Test {
+ protected:
+  void TearDown() override { GeometryCache::Clear(); }
+};
+
+// Each file is loaded once and shared by all its instances
+TEST_F(GeometryCacheTest, SharedTest) {
+  const std::string filename = AssetPath("Corn1.obj");
+  const std::shared_ptr<Geometry> geometry = GeometryCache::Get(filename);
+  ASSERT_NE(nullptr, geometry);
+  EXPECT_EQ(90, geometry->GetTotalFaces());
+  EXPECT_EQ(geometry, GeometryCache::Get(filename));
+
+  const Model first(filename.c_str());
+  const Model second(filename.c_str());
+  EXPECT_EQ(geometry.get(), &first.geometry());
+  EXPECT_EQ(&first.geometry(), &second.geometry());
+
+  EXPECT_NE(geometry, GeometryCache::Get(AssetPath("Corn2.obj")));
+}
+
+// Cleared geometry is loaded again, and stays alive while it is used
+TEST_F(GeometryCacheTest, ClearTest) {
+  const std::string filename = AssetPath("Corn1.obj");
+  const Model model(filename.c_str());
+  const std::shared_ptr<Geometry> before = GeometryCache::Get(filename);
+  GeometryCache::Clear();
+
+  const std::shared_ptr<Geometry> after = GeometryCache::Get(filename);
+  EXPECT_NE(before, after);
+  EXPECT_EQ(before.get(), &model.geometry());
+  EXPECT_EQ(before->GetTotalFaces(), after->GetTotalFaces());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
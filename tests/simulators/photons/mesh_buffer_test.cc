@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "environment/simulators/photons/model/geometry.h"
+#include "environment/simulators/photons/model/mesh_buffer.h"
+#include "environment/simulators/photons/photon_simulator_config.h"
+#include "tests/simulators/asset_path.h"
+
+using namespace simulator;
+using namespace photonsimulator;
+
+namespace {
+
+const size_t kStride =
+    kSizeOfVertexBuffer + kSizeOfNormalBuffer + kSizeOfTexcoordBuffer;
+
+}  // namespace
+
+TEST(MeshBufferTest, IndexedCornersTest) {
+  auto geometry = std::make_shared<Geometry>(AssetPath("Corn1.obj").c_str());
+  ASSERT_FALSE(geometry->meshes().empty());
+
+  size_t num_corners = 0, num_vertices = 0;
+  for (const auto &mesh : geometry->meshes()) {
+    MeshBuffer buffer;
+    BuildMeshBuffer(*geometry, mesh, &buffer);
+    ASSERT_EQ(mesh.faces().size() * 3, buffer.indices.size());
+    EXPECT_EQ(buffer.num_vertices() * kStride, buffer.vertices.size());
+    num_corners += buffer.indices.size();
+    num_vertices += buffer.num_vertices();
+
+    // every corner points to its own position, normal and texcoord
+    for (size_t f = 0; f < mesh.faces().size(); ++f) {
+      const Face &face = mesh.faces()[f];
+      const Vertex *corners[] = {&face.vertex1, &face.vertex2, &face.vertex3};
+      for (int c = 0; c < 3; ++c) {
+        const uint32_t index = buffer.indices[3 * f + c];
+        ASSERT_LT(index, buffer.num_vertices());
+        const float *v = buffer.vertices.data() + index * kStride;
+        const _462::Vector3 &pos = geometry->vertices()[corners[c]->vertex_index];
+        const _462::Vector3 &normal =
+            geometry->normals()[corners[c]->normal_index];
+        EXPECT_FLOAT_EQ((float)pos.x, v[0]);
+        EXPECT_FLOAT_EQ((float)pos.y, v[1]);
+        EXPECT_FLOAT_EQ((float)pos.z, v[2]);
+        EXPECT_FLOAT_EQ((float)normal.x, v[3]);
+        EXPECT_FLOAT_EQ((float)normal.y, v[4]);
+        EXPECT_FLOAT_EQ((float)normal.z, v[5]);
+        if (corners[c]->texcoord_index != -1) {
+          const _462::Vector2 &texcoord =
+              geometry->texcoords()[corners[c]->texcoord_index];
+          EXPECT_FLOAT_EQ((float)texcoord.x, v[6]);
+          EXPECT_FLOAT_EQ((float)texcoord.y, v[7]);
+        }
+      }
+    }
+  }
+  // faces of a mesh share corners
+  EXPECT_LT(num_vertices, num_corners);
+}
+
+TEST(MeshBufferTest, ParallelBuildTest) {
+  auto geometry = std::make_shared<Geometry>(AssetPath("Corn1.obj").c_str());
+  std::vector<MeshBuffer> serial, parallel;
+  BuildMeshBuffers(*geometry, &serial, 1);
+  BuildMeshBuffers(*geometry, &parallel, 4);
+  ASSERT_EQ(geometry->meshes().size(), serial.size());
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(serial[i].vertices, parallel[i].vertices);
+    EXPECT_EQ(serial[i].indices, parallel[i].indices);
+  }
+
+  // rebuilding reuses the buffers
+  BuildMeshBuffers(*geometry, &parallel, 4);
+  for (size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(serial[i].indices, parallel[i].indices);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,41 +1,32 @@
 #include <gtest/gtest.h>
 
+#include <string>
 #include <vector>
 
-#ifdef _WIN32
-#include <windows.h>  // GetModuleFileNameW
-#else
-#include <limits.h>
-#include <unistd.h>  // readlink
-#endif
-
 #include "environment/simulators/photons/model/model.h"
+#include "environment/simulators/photons/photon_simulator_config.h"
+#include "tests/simulators/asset_path.h"
 
 using namespace simulator;
 using namespace photonsimulator;
 
 TEST(ConfigTest, ConstructorTest) {
-  char filename[PATH_MAX];
-#ifdef _WIN32
-  wchar_t path[MAX_PATH] = {0};
-  GetModuleFileNameW(NULL, path, MAX_PATH);
-  strcpy(filename, path);
-#else
-  ssize_t count = readlink("/proc/self/exe", filename, PATH_MAX);
-  std::string temp(filename, (count > 0) ? count : 0);
-  strcpy(filename, temp.substr(0, temp.find_last_of("/\\")).c_str());
-#endif
-
-  strcat(filename, "/../../../environment/simulators/photons/asset/Corn1.obj");
+  const std::string filename = AssetPath("Corn1.obj");
   std::vector<Model> models;
-  models.emplace_back(filename);
-  models.emplace_back(filename);
-  models.emplace_back(filename);
+  models.emplace_back(filename.c_str());
+  models.emplace_back(filename.c_str());
+  models.emplace_back(filename.c_str());
   EXPECT_TRUE(models.back().GetTotalFaces() == 90);
   models.pop_back();
   EXPECT_TRUE(models.back().GetTotalFaces() == 90);
   models.pop_back();
   EXPECT_TRUE(models.back().GetTotalFaces() == 90);
+
+  // textures are decoded into RGB buffers without OpenGL
+  const Geometry &geometry = models.back().geometry();
+  ASSERT_FALSE(geometry.texture_infos().empty());
+  const Texture &texture = geometry.texture_infos().front();
+  EXPECT_EQ(texture.w * texture.h * kNumOfChannels, texture.buffer.size());
   models.pop_back();
 }
 
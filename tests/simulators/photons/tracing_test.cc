@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "environment/simulators/photons/photon/photon.h"
+#include "environment/simulators/photons/tracing/optics.h"
+#include "environment/simulators/photons/tracing/photon_map.h"
+#include "environment/simulators/photons/tracing/photon_tracer.h"
+
+using namespace simulator;
+using namespace photonsimulator;
+using namespace photonsimulator::tracing;
+
+namespace {
+
+std::vector<Photon> RandomPhotons(const size_t n) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<Photon> photons;
+  for (size_t i = 0; i < n; ++i) {
+    const _462::Vector3 pos(dist(gen), dist(gen), dist(gen) * 0.2);
+    photons.emplace_back(_462::Vector3(0.0, 0.0, -1.0), pos,
+                         _462::Vector3(1.0, 1.0, 1.0));
+  }
+  return photons;
+}
+
+float Distance2(const _462::Vector3 &a, const _462::Vector3 &b) {
+  const float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+struct Point {
+  explicit Point(const _462::Vector3 &p)
+      : xyz{(float)p.x, (float)p.y, (float)p.z} {}
+  float xyz[3];
+};
+
+}  // namespace
+
+TEST(PhotonMapTest, EmptyTest) {
+  PhotonMap map;
+  map.BuildFrom(std::vector<Photon>());
+  std::vector<uint32_t> result(1, 0);
+  const float origin[3] = {0.0f, 0.0f, 0.0f};
+  map.FindInRadius(origin, 1.0, &result);
+  EXPECT_TRUE(result.empty());
+  PhotonMap::Neighbor neighbors[4];
+  EXPECT_EQ(0, map.FindNearest(origin, 4, 1.0, neighbors));
+}
+
+TEST(PhotonMapTest, FindInRadiusTest) {
+  for (const size_t n : {1, 2, 3, 7, 100, 1000}) {
+    const std::vector<Photon> photons = RandomPhotons(n);
+    PhotonMap map;
+    map.BuildFrom(photons);
+    EXPECT_EQ(n, map.size());
+
+    std::vector<uint32_t> result;
+    for (const auto &query : RandomPhotons(20)) {
+      const _462::real_t radius = 0.1;
+      map.FindInRadius(Point(query.pos).xyz, radius, &result);
+      std::vector<uint32_t> expected;
+      for (size_t i = 0; i < photons.size(); ++i) {
+        if (Distance2(photons[i].pos, query.pos) <= radius * radius) {
+          expected.push_back(i);
+        }
+      }
+      std::sort(result.begin(), result.end());
+      EXPECT_EQ(expected, result);
+    }
+  }
+}
+
+TEST(PhotonMapTest, FindNearestTest) {
+  const std::vector<Photon> photons = RandomPhotons(500);
+  PhotonMap map;
+  map.BuildFrom(photons);
+
+  const size_t k = 8;
+  PhotonMap::Neighbor neighbors[k];
+  for (const auto &query : RandomPhotons(20)) {
+    const size_t found =
+        map.FindNearest(Point(query.pos).xyz, k, 1.0, neighbors);
+    ASSERT_EQ(k, found);
+    std::vector<float> distances;
+    for (const auto &photon : photons) {
+      distances.push_back(Distance2(photon.pos, query.pos));
+    }
+    std::sort(distances.begin(), distances.end());
+    std::vector<float> result;
+    for (size_t i = 0; i < found; ++i) {
+      result.push_back(neighbors[i].distance2);
+      // positions are stored in single precision
+      EXPECT_NEAR(Distance2(photons[neighbors[i].index].pos, query.pos),
+                  neighbors[i].distance2, 1e-6);
+    }
+    std::sort(result.begin(), result.end());
+    for (size_t i = 0; i < k; ++i) {
+      EXPECT_NEAR(distances[i], result[i], 1e-6);
+    }
+  }
+
+  // photons outside the radius are not returned
+  const float far[3] = {10.0f, 10.0f, 10.0f};
+  EXPECT_EQ(0, map.FindNearest(far, k, 1.0, neighbors));
+
+  // photons rejected by the filter are skipped
+  const size_t found =
+      map.FindNearest(Point(photons[0].pos).xyz, k, 1.0, neighbors,
+                      [](const uint32_t index) { return index % 2 == 1; });
+  ASSERT_EQ(k, found);
+  for (size_t i = 0; i < found; ++i) {
+    EXPECT_EQ(1, neighbors[i].index % 2);
+  }
+}
+
+TEST(OpticsTest, RussianRouletteTest) {
+  EXPECT_EQ(Interaction::kAbsorb, RussianRoulette(0.5, 0.3, 0.2));
+  EXPECT_EQ(Interaction::kReflect, RussianRoulette(0.5, 0.3, 0.6));
+  EXPECT_EQ(Interaction::kRefract, RussianRoulette(0.5, 0.3, 0.9));
+}
+
+TEST(OpticsTest, ReflectRefractTest) {
+  const _462::Vector3 dir = _462::normalize(_462::Vector3(1.0, 0.0, -1.0));
+  const _462::Vector3 up(0.0, 0.0, 2.0);
+  const _462::Vector3 reflected = Reflect(dir, up);
+  EXPECT_DOUBLE_EQ(dir.x, reflected.x);
+  EXPECT_DOUBLE_EQ(-dir.z, reflected.z);
+
+  // light passes straight through matching media, whichever way the normal
+  // faces
+  const _462::Vector3 unit_up(0.0, 0.0, 1.0);
+  for (const auto &normal : {unit_up, -unit_up}) {
+    const _462::Vector3 refracted = Refract(dir, normal, 1.0);
+    EXPECT_NEAR(dir.x, refracted.x, 1e-12);
+    EXPECT_NEAR(dir.z, refracted.z, 1e-12);
+  }
+  // and bends towards the normal entering a denser medium
+  const _462::Vector3 bent = Refract(dir, unit_up, 1.0 / 1.5);
+  EXPECT_NEAR(1.0, _462::length(bent), 1e-12);
+  EXPECT_LT(bent.x, dir.x);
+}
+
+TEST(OpticsTest, TriangleTest) {
+  const _462::Vector3 a(0.0, 0.0, 1.0), b(1.0, 0.0, 1.0), c(0.0, 1.0, 1.0);
+  EXPECT_TRUE(IsInTriangle(a, b, c, _462::Vector3(0.2, 0.2, 1.0)));
+  EXPECT_FALSE(IsInTriangle(a, b, c, _462::Vector3(0.8, 0.8, 1.0)));
+
+  double distance;
+  const _462::Vector3 hit =
+      IntersectPlane(a, _462::Vector3(0.0, 0.0, 1.0),
+                     _462::Vector3(0.2, 0.2, 3.0),
+                     _462::Vector3(0.0, 0.0, -2.0), &distance);
+  EXPECT_DOUBLE_EQ(2.0, distance);
+  EXPECT_DOUBLE_EQ(1.0, hit.z);
+}
+
+// A ray hits a face ahead of it, but not one behind it or the one it leaves
+TEST(OpticsTest, IntersectTriangleTest) {
+  const _462::Vector3 a(0.0, 0.0, 1.0), b(1.0, 0.0, 1.0), c(0.0, 1.0, 1.0);
+  // the normal need not be normalized
+  const _462::Vector3 normal(0.0, 0.0, 3.0);
+  const _462::Vector3 down(0.0, 0.0, -2.0);
+  _462::Vector3 hit;
+  double distance;
+  EXPECT_TRUE(IntersectTriangle(a, b, c, normal, _462::Vector3(0.2, 0.2, 3.0),
+                                down, &hit, &distance));
+  EXPECT_DOUBLE_EQ(2.0, distance);
+  EXPECT_DOUBLE_EQ(1.0, hit.z);
+
+  EXPECT_FALSE(IntersectTriangle(a, b, c, normal, _462::Vector3(0.2, 0.2, 0.0),
+                                 down, &hit, &distance));
+  // reflected from the face
+  EXPECT_FALSE(IntersectTriangle(a, b, c, normal, _462::Vector3(0.2, 0.2, 1.0),
+                                 _462::Vector3(0.3, 0.0, 1.0), &hit,
+                                 &distance));
+  // parallel to it
+  EXPECT_FALSE(IntersectTriangle(a, b, c, normal, _462::Vector3(0.2, 0.2, 1.0),
+                                 _462::Vector3(1.0, 0.0, 0.0), &hit,
+                                 &distance));
+  // outside of it
+  EXPECT_FALSE(IntersectTriangle(a, b, c, normal, _462::Vector3(0.8, 0.8, 3.0),
+                                 down, &hit, &distance));
+}
+
+TEST(PhotonTracerTest, EmitGridTest) {
+  std::vector<std::pair<double, double>> points;
+  const auto emit = [&](const double x, const double y) {
+    points.emplace_back(x, y);
+  };
+  EmitGrid(0.5, 3.0, 1.0, 0.5, 2.0, 1.0, emit);
+  ASSERT_EQ(6, points.size());
+  EXPECT_EQ(std::make_pair(0.5, 0.5), points.front());
+  EXPECT_EQ(std::make_pair(2.5, 1.5), points.back());
+
+  // the batches emit every point once between them
+  std::vector<std::pair<double, double>> batches;
+  for (int batch = 0; batch < 2; ++batch) {
+    points.clear();
+    EmitGrid(0.5, 3.0, 1.0, 0.5, 2.0, 1.0, emit, batch, 2);
+    EXPECT_EQ(batch == 0 ? 4 : 2, points.size());
+    batches.insert(batches.end(), points.begin(), points.end());
+  }
+  std::sort(batches.begin(), batches.end());
+  points.clear();
+  EmitGrid(0.5, 3.0, 1.0, 0.5, 2.0, 1.0, emit);
+  EXPECT_EQ(points, batches);
+}
+
+TEST(PhotonTracerTest, TracePhotonTest) {
+  // a floor at z = 0 and nothing else
+  double absorption = 1.0, reflection = 0.0;
+  const auto find_hit = [&](const Photon &photon, Hit<_462::Vector3> *hit) {
+    if (photon.pos.z <= 0.0 || photon.dir.z >= 0.0) {
+      return false;
+    }
+    const double t = -photon.pos.z / photon.dir.z;
+    hit->point = photon.pos + photon.dir * t;
+    hit->normal = _462::Vector3(0.0, 0.0, 1.0);
+    hit->absorption = absorption;
+    hit->reflection = reflection;
+    return true;
+  };
+  std::vector<Photon> absorbed;
+  const auto absorb = [&](const Photon &photon,
+                          const Hit<_462::Vector3> &hit) {
+    absorbed.emplace_back(hit.normal, hit.point, photon.power);
+  };
+  const auto uniform = []() { return 0.5; };
+  const _462::Vector3 dir = _462::normalize(_462::Vector3(1.0, 0.0, -1.0));
+
+  const _462::Vector3 start(0.0, 0.0, 1.0), power(1.0, 1.0, 1.0);
+  Photon photon(dir, start, power);
+  EXPECT_TRUE(TracePhoton<_462::Vector3>(&photon, find_hit, absorb, uniform));
+  ASSERT_EQ(1, absorbed.size());
+  EXPECT_NEAR(1.0, absorbed[0].pos.x, 1e-12);
+  EXPECT_NEAR(0.0, absorbed[0].pos.z, 1e-12);
+
+  // a mirror sends the photon up and out of the scene
+  absorption = 0.0;
+  reflection = 1.0;
+  photon = Photon(dir, start, power);
+  EXPECT_FALSE(TracePhoton<_462::Vector3>(&photon, find_hit, absorb, uniform));
+  EXPECT_EQ(1, absorbed.size());
+  EXPECT_NEAR(1.0, photon.pos.x, 1e-12);
+  EXPECT_NEAR(-dir.z, photon.dir.z, 1e-12);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -3,8 +3,21 @@
 #include "map_control.h"
 #include "main.h"
 #include <chrono>
+#include <cstring>
 #include <ctime>
 bool render_2d = false;
+// render the 2D view in refining passes instead of all at once
+bool progressive = true;
+
+void Idle(void)
+{
+    if (!map.refineProgressive())
+    {
+        glutIdleFunc(NULL);
+    }
+    glutSetWindow(mainWindow);
+    glutPostRedisplay();
+}
 
 void ConfigureScene(void)
 {
@@ -13,6 +26,19 @@ void ConfigureScene(void)
     // map.add_model("input/Heart.obj", Vector3(0, 20, -20));
 }
 
+// plant a field of size x size corn plants, drawn with instancing
+void ConfigureField(int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            map.add_instance("input/Corn1.obj", Vector3(2.0 + 0.5 * i, 2.0 + 0.5 * j, 0.0), 0.1);
+        }
+    }
+    std::cout << "Planted " << size * size << " instances." << std::endl;
+}
+
 void keyboard(unsigned char key, int x, int y)
 {
     switch (key)
@@ -53,11 +79,27 @@ void keyboard(unsigned char key, int x, int y)
     case '6':
         camera[5] -= 1.0;
         break;
+    case 'p':
+        progressive = !progressive;
+        std::cout << "Progressive rendering " << (progressive ? "on" : "off") << std::endl;
+        break;
     case 'r':
         if (render_2d == false)
         {
             map.deleteBuffer3D();
-            PhotonMapping();
+            if (progressive)
+            {
+                map.startProgressive(camera, scrn_width, scrn_height);
+                glutIdleFunc(Idle);
+            }
+            else
+            {
+                PhotonMapping();
+            }
+        }
+        else
+        {
+            glutIdleFunc(NULL);
         }
         render_2d = !render_2d;
         break;
@@ -92,7 +134,7 @@ void reshape(int w, int h)
     glMatrixMode(GL_MODELVIEW);
 }
 
-void PhotonMapping(void)
+void PhotonMapping(const char *output_file)
 {
     std::chrono::system_clock::time_point start, end;
     std::chrono::duration<double> elapsed_seconds;
@@ -111,14 +153,65 @@ void PhotonMapping(void)
     // rendering
     std::cout << "Start rendering.." << std::endl;
     start = std::chrono::system_clock::now();
-    map.writeBuffer2D(camera, scrn_width, scrn_height);
+    if (output_file)
+    {
+        map.renderImage(camera, scrn_width, scrn_height);
+    }
+    else
+    {
+        map.writeBuffer2D(camera, scrn_width, scrn_height);
+    }
     end = std::chrono::system_clock::now();
     elapsed_seconds = end - start;
     std::cout << "End rendering..\nElapsed time: " << elapsed_seconds.count() << " s\n";
+
+    if (output_file)
+    {
+        if (map.writeImage(output_file))
+            std::cout << "Image written to " << output_file << std::endl;
+        else
+            std::cerr << "Unable to write " << output_file << std::endl;
+    }
 }
 
+// usage: photon [-f size] [-o output.pfm|output.ppm [width height]]
+// with -f a field of size x size plants is added to the 3D view
+// with -o the 2D view is rendered once into the file and the program exits,
+// which is used for benchmarks; no window is opened, so it runs without a
+// display
 int main(int argc, char **argv)
 {
+    const char *output_file = NULL;
+    int field_size = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+        {
+            field_size = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            output_file = argv[++i];
+            if (i + 2 < argc && argv[i + 1][0] != '-')
+            {
+                scrn_width = atoi(argv[++i]);
+                scrn_height = atoi(argv[++i]);
+            }
+        }
+    }
+
+    // the photons and the image are traced on the CPU only, so there is no
+    // GL context and the models keep their textures in memory
+    if (output_file)
+    {
+        Model::use_gl = false;
+        ConfigureScene();
+        if (field_size > 0)
+            ConfigureField(field_size);
+        PhotonMapping(output_file);
+        return 0;
+    }
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
     glutInitWindowPosition(scrn_pos_x, scrn_pos_y);
@@ -128,6 +221,8 @@ int main(int argc, char **argv)
     glewInit();
 #endif
     ConfigureScene(); // initializing
+    if (field_size > 0)
+        ConfigureField(field_size);
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     map.writeBuffer3D(); // 3D buffer
@@ -16,6 +16,8 @@ int scrn_height = 600;
 int scrn_pos_x = 50;
 int scrn_pos_y = 50;
 
-void PhotonMapping(void);
+// trace photons and render the 2D view, into a texture or, when output_file
+// is given, into that file
+void PhotonMapping(const char *output_file = NULL);
 
 #endif /* __MAIN_H__ */
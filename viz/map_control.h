@@ -6,14 +6,19 @@
 #ifndef __MODEL_H__
 #include "model/model.h"
 #endif
+#ifndef __INSTANCED_RENDERER_H__
+#include "model/instanced_renderer.h"
+#endif
+#ifndef __TILE_RENDERER_H__
+#include "tile_renderer.h"
+#endif
+#include "environment/simulators/photons/tracing/photon_tracer.h"
 
-#define MULTI_THREAD
-#define NUM_OF_THREADS 4
-
-const int DEF_ABR = 0;
-const int DEF_REF = 1;
-const int DEF_TRAN = 2;
 const float PI = 3.141592654f;
+// the number of photons the radiance at a point is estimated from
+const int NUM_PHOTON_RADIANCE = 50;
+// the photons are emitted in this many batches when rendering progressively
+const int PROGRESSIVE_BATCHES = 8;
 class map_control
 {
 private:
@@ -27,8 +32,7 @@ private:
 
 	// model related
 	std::vector<Model *> models;
-	Vector3 get_Intersact(const Vector3 &p1, const Vector3 &p2, const Vector3 &p3, const Vector3 &line_point, const Vector3 &line_dir);
-	bool IsInTriangle(Vector3 a, Vector3 b, Vector3 c, Vector3 p);
+	Instanced_Renderer field; // instances drawn in the 3D view only
 
 	Vector3 GetNormal(const Vector3 &p1, const Vector3 &p2, const Vector3 &p3);
 	Vector3 GetPixelColor(const Vector3 &ray_pos, const Vector3 &ray_dir);
@@ -36,6 +40,16 @@ private:
 
 	// render related
 	GLuint vb_id_2d; // texture vb_id for 2D rendering
+	Framebuffer frame; // the last image rendered by renderImage
+	Tile_Renderer renderer;
+	void renderImage(GLdouble *camera, int scrn_width, int scrn_height, int block_size);
+	void uploadBuffer2D();
+
+	// progressive rendering, see startProgressive
+	int progressive_pass;
+	GLdouble progressive_camera[9];
+	int progressive_width;
+	int progressive_height;
 
 public:
 	// photon related
@@ -50,8 +64,9 @@ public:
 	}
 	void modify_sun_dir(Vector3 sun_dir) { this->sun_dir = sun_dir; }
 	void modify_sun_str(int sun_strength) { this->sun_strength = sun_strength; }
-	void photons_emit();
-	int RussianRoulette(float abr, float ref, float tran);
+	// emit the photons of one batch out of num_batches, or all of them
+	void photons_emit(int batch = 0, int num_batches = 1);
+	// bounce the emitted photons until they are absorbed or leave the scene
 	void PhotonsModify();
 	void printResult()
 	{
@@ -71,10 +86,25 @@ public:
 	size_t size() { return models.size(); }
 	Model *operator[](int index) { return models[index]; }
 	void clear_models() { models.clear(); }
+	// add a copy of the model in filename to the 3D view, e.g. one plant of a
+	// field; the model is loaded once however many copies are added
+	void add_instance(const char *filename, Vector3 pos, real_t scale = 1.0) { field.addInstance(filename, pos, scale); }
 
 	// render related
+	// trace the image seen from camera into frame, without OpenGL
+	void renderImage(GLdouble *camera, int scrn_width, int scrn_height);
+	// write frame to a .pfm or .ppm file
+	bool writeImage(const char *filename) { return frame.write(filename); }
 	void writeBuffer2D(GLdouble *camera, int scrn_width, int scrn_height);
 	void deleteBuffer2D();
+	// Progressive rendering of the 2D view. Each pass emits and traces one
+	// more batch of photons and renders the image at half the block size of
+	// the previous pass, from one ray per 256 x 256 block down to one ray per
+	// pixel, then uploads it. The first passes are cheap, so the view responds
+	// at once and converges over PROGRESSIVE_BATCHES + 1 passes.
+	void startProgressive(GLdouble *camera, int scrn_width, int scrn_height);
+	// run the next pass, returns false once the image has converged
+	bool refineProgressive();
 	void render2D();
 	void writeBuffer3D();
 	void deleteBuffer3D();
@@ -0,0 +1,262 @@
+#include "model/instanced_renderer.h"
+
+static const char *kVertexShader =
+    "#version 120\n"
+    "attribute vec4 instance; // xyz: position, w: scale\n"
+    "varying vec2 texcoord;\n"
+    "void main()\n"
+    "{\n"
+    "    texcoord = gl_MultiTexCoord0.xy;\n"
+    "    vec4 pos = vec4(gl_Vertex.xyz * instance.w + instance.xyz, 1.0);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * pos;\n"
+    "}\n";
+
+static const char *kFragmentShader =
+    "#version 120\n"
+    "uniform sampler2D diffuse_texture;\n"
+    "uniform bool use_texture;\n"
+    "uniform vec3 diffuse;\n"
+    "varying vec2 texcoord;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = use_texture ? texture2D(diffuse_texture, texcoord) : vec4(diffuse, 1.0);\n"
+    "}\n";
+
+static bool InstancingSupported()
+{
+#ifdef __APPLE__
+    return true;
+#else
+    return GLEW_VERSION_3_3;
+#endif
+}
+
+static GLuint CompileShader(GLenum type, const char *source)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    GLint status;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        std::cerr << "Unable to compile shader: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+Instanced_Renderer::~Instanced_Renderer()
+{
+    deleteBuffer();
+}
+
+int Instanced_Renderer::addType(const char *filename)
+{
+    auto it = types.find(filename);
+    if (it != types.end())
+        return it->second;
+
+    Batch batch;
+    batch.model.reset(new Model(filename));
+    batch.instance_vb = 0;
+    batch.uploaded = 0;
+    batches.push_back(std::move(batch));
+    int type = (int)batches.size() - 1;
+    types.insert(std::make_pair(std::string(filename), type));
+    return type;
+}
+
+void Instanced_Renderer::addInstance(int type, Vector3 pos, real_t scale)
+{
+    std::vector<float> &instances = batches[type].instances;
+    instances.push_back((float)pos.x);
+    instances.push_back((float)pos.y);
+    instances.push_back((float)pos.z);
+    instances.push_back((float)scale);
+}
+
+size_t Instanced_Renderer::numInstances() const
+{
+    size_t cnt = 0;
+    for (auto &batch : batches)
+    {
+        cnt += batch.instances.size() / 4;
+    }
+    return cnt;
+}
+
+void Instanced_Renderer::clearInstances()
+{
+    for (auto &batch : batches)
+    {
+        batch.instances.clear();
+    }
+}
+
+bool Instanced_Renderer::compileProgram()
+{
+    GLuint vertex_shader = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragment_shader = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+    if (vertex_shader == 0 || fragment_shader == 0)
+    {
+        glDeleteShader(vertex_shader);
+        glDeleteShader(fragment_shader);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+    glLinkProgram(program);
+    // the shaders are freed with the program
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    GLint status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        std::cerr << "Unable to link shader: " << log << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+
+    instance_loc = glGetAttribLocation(program, "instance");
+    use_texture_loc = glGetUniformLocation(program, "use_texture");
+    diffuse_loc = glGetUniformLocation(program, "diffuse");
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "diffuse_texture"), 0);
+    glUseProgram(0);
+    return true;
+}
+
+void Instanced_Renderer::writeBuffer()
+{
+    // writing again, e.g. after the 2D view, replaces the program and buffers
+    deleteBuffer();
+    use_instancing = InstancingSupported() && compileProgram();
+    if (!use_instancing)
+        std::cout << "Instancing not supported, drawing instances one by one." << std::endl;
+
+    for (auto &batch : batches)
+    {
+        batch.model->writeBuffer();
+        if (use_instancing)
+        {
+            glGenBuffers(1, &batch.instance_vb);
+            uploadInstances(batch);
+        }
+    }
+}
+
+void Instanced_Renderer::deleteBuffer()
+{
+    for (auto &batch : batches)
+    {
+        batch.model->deleteBuffer();
+        if (batch.instance_vb > 0)
+        {
+            glDeleteBuffers(1, &batch.instance_vb);
+            batch.instance_vb = 0;
+            batch.uploaded = 0;
+        }
+    }
+    if (program > 0)
+    {
+        glDeleteProgram(program);
+        program = 0;
+    }
+    use_instancing = false;
+}
+
+void Instanced_Renderer::uploadInstances(Batch &batch)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, batch.instance_vb);
+    glBufferData(GL_ARRAY_BUFFER, batch.instances.size() * sizeof(float),
+                 batch.instances.empty() ? NULL : &batch.instances.at(0), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    batch.uploaded = batch.instances.size() / 4;
+}
+
+void Instanced_Renderer::render()
+{
+    glPolygonMode(GL_FRONT, GL_FILL);
+    glPolygonMode(GL_BACK, GL_FILL);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(1.0, 1.0);
+
+    if (use_instancing)
+        glUseProgram(program);
+    for (auto &batch : batches)
+    {
+        if (batch.instances.empty())
+            continue;
+        if (use_instancing)
+            renderInstanced(batch);
+        else
+            renderEach(batch);
+    }
+    if (use_instancing)
+        glUseProgram(0);
+}
+
+void Instanced_Renderer::renderInstanced(Batch &batch)
+{
+    // instances added since the last upload
+    if (batch.uploaded != batch.instances.size() / 4)
+        uploadInstances(batch);
+
+    // one vec4 per instance instead of per vertex
+    glBindBuffer(GL_ARRAY_BUFFER, batch.instance_vb);
+    glEnableVertexAttribArray(instance_loc);
+    glVertexAttribPointer(instance_loc, 4, GL_FLOAT, GL_FALSE, 0, (const void *)0);
+    glVertexAttribDivisor(instance_loc, 1);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    GLsizei stride = (3 + 3 + 2) * sizeof(float);
+    std::vector<tinyobj::material_t> &materials = batch.model->materials;
+    for (auto &mesh : batch.model->meshes)
+    {
+        if (mesh.vb_id == 0)
+            continue;
+        if (mesh.texture_id != -1)
+            glBindTexture(GL_TEXTURE_2D, mesh.texture_id);
+        glUniform1i(use_texture_loc, mesh.texture_id != -1);
+        glUniform3f(diffuse_loc, materials[mesh.material_id].diffuse[0],
+                    materials[mesh.material_id].diffuse[1], materials[mesh.material_id].diffuse[2]);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vb_id);
+        glVertexPointer(3, GL_FLOAT, stride, (const void *)0);
+        glTexCoordPointer(2, GL_FLOAT, stride, (const void *)(sizeof(float) * 6));
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 3 * mesh.numTriangles, (GLsizei)batch.uploaded);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glVertexAttribDivisor(instance_loc, 0);
+    glDisableVertexAttribArray(instance_loc);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Instanced_Renderer::renderEach(Batch &batch)
+{
+    for (size_t i = 0; i < batch.instances.size(); i += 4)
+    {
+        glPushMatrix();
+        glTranslatef(batch.instances[i], batch.instances[i + 1], batch.instances[i + 2]);
+        glScalef(batch.instances[i + 3], batch.instances[i + 3], batch.instances[i + 3]);
+        for (auto &mesh : batch.model->meshes)
+        {
+            mesh.render(batch.model->materials, Vector3(0.0, 0.0, 0.0));
+        }
+        glPopMatrix();
+    }
+}
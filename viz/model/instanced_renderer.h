@@ -0,0 +1,65 @@
+/*
+    draws many copies of the same models, e.g. a field of plants,
+    with one instanced draw call per mesh
+*/
+
+#ifndef __INSTANCED_RENDERER_H__
+#define __INSTANCED_RENDERER_H__
+#include "common/stdafx.h"
+#include <map>
+#include <memory>
+
+#ifndef __OBJECT_H__
+#include "model/model.h"
+#endif
+
+// Each model type is loaded and uploaded once. The transforms of its
+// instances are kept in a per-instance vertex buffer, and every mesh is drawn
+// for all instances by one glDrawArraysInstanced call with a small shader.
+// Where instancing is not available (before OpenGL 3.3) the instances are
+// drawn one by one through Mesh::render instead.
+class Instanced_Renderer
+{
+public:
+    Instanced_Renderer() : program(0), instance_loc(-1), use_texture_loc(-1), diffuse_loc(-1), use_instancing(false) {}
+    // frees the models, and the program and buffers if written
+    ~Instanced_Renderer();
+
+    // returns the type of the model in filename, loading it the first time
+    int addType(const char *filename);
+    // add an instance of type at pos, scaled uniformly by scale
+    void addInstance(int type, Vector3 pos, real_t scale = 1.0);
+    void addInstance(const char *filename, Vector3 pos, real_t scale = 1.0) { addInstance(addType(filename), pos, scale); }
+    size_t numInstances() const;
+    void clearInstances();
+
+    // add to buffer for OpenGL rendering, replacing what was added before
+    void writeBuffer();
+    void deleteBuffer();
+    void render();
+
+private:
+    struct Batch
+    {
+        std::unique_ptr<Model> model;
+        std::vector<float> instances; // 4 per instance: x, y, z, scale
+        GLuint instance_vb;           // per-instance vertex buffer id
+        size_t uploaded;              // number of instances in instance_vb
+    };
+    std::vector<Batch> batches;
+    std::map<std::string, int> types;
+
+    // the instancing shader
+    GLuint program;
+    GLint instance_loc;
+    GLint use_texture_loc;
+    GLint diffuse_loc;
+    bool use_instancing;
+
+    bool compileProgram();
+    void uploadInstances(Batch &batch);
+    void renderInstanced(Batch &batch);
+    void renderEach(Batch &batch);
+};
+
+#endif /* __INSTANCED_RENDERER_H__ */
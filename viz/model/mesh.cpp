@@ -118,7 +118,8 @@ void Mesh::writeOpenGLBuffer(const std::vector<Vector3> &vertices,
             buffer.push_back((float)0.0);
         }
     }
-    vb_id = 0;
+    // uploading again replaces the old buffer
+    deleteOpenGLBuffer();
 
     int size = (int)buffer.size();
     if (buffer.size() > 0)
@@ -135,5 +136,9 @@ void Mesh::writeOpenGLBuffer(const std::vector<Vector3> &vertices,
 
 void Mesh::deleteOpenGLBuffer()
 {
-    glDeleteBuffers(1, &vb_id);
+    if (vb_id > 0)
+    {
+        glDeleteBuffers(1, &vb_id);
+        vb_id = 0;
+    }
 }
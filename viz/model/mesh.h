@@ -26,7 +26,7 @@ public:
     size_t material_id;
     GLuint texture_id;
 
-    Mesh() {}
+    Mesh() : vb_id(0), numTriangles(0) {}
     ~Mesh() {}
     void LoadObjModel(const char *filename);
     void render(std::vector<tinyobj::material_t> &materials, Vector3 pos);
@@ -36,6 +36,7 @@ public:
     void writeOpenGLBuffer(const std::vector<Vector3> &vertices,
                            const std::vector<Vector3> &normals,
                            const std::vector<Vector2> &texcoords);
+    // safe to call when nothing is uploaded
     void deleteOpenGLBuffer();
 
     // functions for photon mapping
@@ -12,6 +12,8 @@ const char PathSeparator =
     '/';
 #endif
 
+bool Model::use_gl = true;
+
 Model::~Model()
 {
     for (auto &texture_info : texture_infos)
@@ -100,30 +102,42 @@ void Model::LoadObjModel(const char *filename)
                         std::cout << "Loaded texture: " << texture_filename << ", w = " << w
                                   << ", h = " << h << ", comp = " << comp << std::endl;
 
-                        glGenTextures(1, &texture_id);
-                        glBindTexture(GL_TEXTURE_2D, texture_id);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                        if (comp == 3)
+                        if (use_gl)
                         {
-                            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB,
-                                         GL_UNSIGNED_BYTE, image);
+                            glGenTextures(1, &texture_id);
+                            glBindTexture(GL_TEXTURE_2D, texture_id);
+                            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                            if (comp == 3)
+                            {
+                                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB,
+                                             GL_UNSIGNED_BYTE, image);
+                            }
+                            else if (comp == 4)
+                            {
+                                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA,
+                                             GL_UNSIGNED_BYTE, image);
+                            }
+                            glBindTexture(GL_TEXTURE_2D, 0);
                         }
-                        else if (comp == 4)
+                        else
                         {
-                            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA,
-                                         GL_UNSIGNED_BYTE, image);
+                            // only an id to find the texture by, never bound
+                            texture_id = (GLuint)texture_infos.size() + 1;
                         }
-                        glBindTexture(GL_TEXTURE_2D, 0);
-                        stbi_image_free(image);
                         textures.insert(std::make_pair(mp->diffuse_texname, texture_id));
 
-                        // test
-                        // only get RGB
+                        // the RGB copy the ray tracer samples, a gray image
+                        // gives the same value to all 3 channels
                         unsigned char *texture = new unsigned char[w * h * 3];
-                        glBindTexture(GL_TEXTURE_2D, texture_id);
-                        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, texture);
-                        glBindTexture(GL_TEXTURE_2D, 0);
+                        for (int i = 0; i < w * h; i++)
+                        {
+                            for (int c = 0; c < 3; c++)
+                            {
+                                texture[3 * i + c] = image[comp * i + (comp >= 3 ? c : 0)];
+                            }
+                        }
+                        stbi_image_free(image);
 
                         texture_infos.push_back(Texture(texture_id, texture, w, h, comp));
                     }
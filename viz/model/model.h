@@ -35,6 +35,10 @@ public:
     Vector3 rel_pos;
     void setRelativePos(Vector3 pos) { rel_pos = pos; }
 
+    // whether the textures are uploaded to OpenGL when a model is loaded,
+    // false when there is no GL context, e.g. when rendering offscreen
+    static bool use_gl;
+
     Model() = delete;
     void LoadObjModel(const char *filename);
     Model(const char *filename, Vector3 pos = Vector3(0.0, 0.0, 0.0)) : rel_pos(pos) { LoadObjModel(filename); }
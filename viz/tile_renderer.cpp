@@ -0,0 +1,179 @@
+#include "tile_renderer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+void Framebuffer::resize(int w, int h)
+{
+	width = w;
+	height = h;
+	pixels.assign(3 * w * h, 0.0f);
+}
+
+void Framebuffer::setPixel(int x, int y, const Vector3 &rgb)
+{
+	float *p = &pixels[3 * (x + y * width)];
+	p[0] = rgb.x;
+	p[1] = rgb.y;
+	p[2] = rgb.z;
+}
+
+bool Framebuffer::write(const char *filename) const
+{
+	const char *ext = strrchr(filename, '.');
+	if (ext && strcmp(ext, ".ppm") == 0)
+		return writePPM(filename);
+	return writePFM(filename);
+}
+
+bool Framebuffer::writePFM(const char *filename) const
+{
+	FILE *fp = fopen(filename, "wb");
+	if (!fp)
+		return false;
+	// a negative scale means little endian, rows go from the bottom up
+	fprintf(fp, "PF\n%d %d\n-1.0\n", width, height);
+	bool ok = fwrite(pixels.data(), sizeof(float), pixels.size(), fp) == pixels.size();
+	return fclose(fp) == 0 && ok;
+}
+
+bool Framebuffer::writePPM(const char *filename) const
+{
+	FILE *fp = fopen(filename, "wb");
+	if (!fp)
+		return false;
+	fprintf(fp, "P6\n%d %d\n255\n", width, height);
+	std::vector<unsigned char> row(3 * width);
+	bool ok = true;
+	// rows go from the top down
+	for (int y = height - 1; y >= 0 && ok; y--)
+	{
+		for (int i = 0; i < 3 * width; i++)
+		{
+			float v = std::min(std::max(pixels[3 * y * width + i], 0.0f), 1.0f);
+			row[i] = (unsigned char)(v * 255.0f + 0.5f);
+		}
+		ok = fwrite(row.data(), 1, row.size(), fp) == row.size();
+	}
+	return fclose(fp) == 0 && ok;
+}
+
+// takes a tile from the back of the own queue, or steals one from the front
+// of another queue when it is empty
+bool Tile_Renderer::popTile(int id, int &tile)
+{
+	for (size_t k = 0; k < queues.size(); k++)
+	{
+		Tile_Queue &queue = queues[(id + k) % queues.size()];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if (queue.tiles.empty())
+			continue;
+		if (k == 0)
+		{
+			tile = queue.tiles.back();
+			queue.tiles.pop_back();
+		}
+		else
+		{
+			tile = queue.tiles.front();
+			queue.tiles.pop_front();
+		}
+		return true;
+	}
+	// no tile is added once rendering starts, so all the work is taken
+	return false;
+}
+
+static int ThreadCount(int num_threads)
+{
+	if (num_threads <= 0)
+		return std::max(1, (int)std::thread::hardware_concurrency());
+	return num_threads;
+}
+
+Tile_Renderer::Tile_Renderer(int num_threads)
+	: num_threads(ThreadCount(num_threads)), queues(this->num_threads),
+	  image(0), working(0), stopping(false), frame(NULL), shade(NULL), progress(NULL),
+	  tiles_x(0), tiles_total(0), tiles_done(0)
+{
+	// the calling thread of render() is the first one
+	for (int i = 1; i < this->num_threads; i++)
+		workers.push_back(std::thread(&Tile_Renderer::workerLoop, this, i));
+}
+
+Tile_Renderer::~Tile_Renderer()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	start_cv.notify_all();
+	for (auto &t : workers)
+		t.join();
+}
+
+void Tile_Renderer::workerLoop(int id)
+{
+	unsigned rendered = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			start_cv.wait(guard, [&] { return stopping || image != rendered; });
+			if (stopping)
+				return;
+			rendered = image;
+		}
+		work(id);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (--working == 0)
+				done_cv.notify_one();
+		}
+	}
+}
+
+void Tile_Renderer::work(int id)
+{
+	int tile;
+	while (popTile(id, tile))
+	{
+		int x0 = (tile % tiles_x) * TILE_SIZE;
+		int y0 = (tile / tiles_x) * TILE_SIZE;
+		int x1 = std::min(x0 + TILE_SIZE, frame->width);
+		int y1 = std::min(y0 + TILE_SIZE, frame->height);
+		for (int y = y0; y < y1; y++)
+			for (int x = x0; x < x1; x++)
+				frame->setPixel(x, y, (*shade)(x, y));
+		int d = ++tiles_done;
+		if (*progress)
+		{
+			std::lock_guard<std::mutex> guard(progress_lock);
+			(*progress)(d, tiles_total);
+		}
+	}
+}
+
+void Tile_Renderer::render(Framebuffer &frame, const Shader &shade, const Progress &progress)
+{
+	tiles_x = (frame.width + TILE_SIZE - 1) / TILE_SIZE;
+	int tiles_y = (frame.height + TILE_SIZE - 1) / TILE_SIZE;
+	tiles_total = tiles_x * tiles_y;
+	tiles_done = 0;
+	this->frame = &frame;
+	this->shade = &shade;
+	this->progress = &progress;
+	// the workers are waiting, so the queues are filled without their locks
+	for (int i = 0; i < tiles_total; i++)
+		queues[i % num_threads].tiles.push_back(i);
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		working = (int)workers.size();
+		image++;
+	}
+	start_cv.notify_all();
+	work(0);
+	std::unique_lock<std::mutex> guard(lock);
+	done_cv.wait(guard, [&] { return working == 0; });
+}
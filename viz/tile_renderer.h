@@ -0,0 +1,89 @@
+#ifndef __TILE_RENDERER_H__
+#define __TILE_RENDERER_H__
+#include "common/stdafx.h"
+#include "common/vectors.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// edge length of the square tiles an image is split into, in pixels
+#define TILE_SIZE 32
+
+// RGB float image, rows are stored from the bottom up as OpenGL expects
+class Framebuffer
+{
+public:
+	int width;
+	int height;
+	std::vector<float> pixels;
+
+	Framebuffer() : width(0), height(0) {}
+	void resize(int w, int h);
+	void setPixel(int x, int y, const Vector3 &rgb);
+	float *data() { return pixels.data(); }
+
+	// offscreen output, the format is chosen by the extension of filename:
+	// .pfm keeps the float values, .ppm clamps them to 8 bits
+	bool write(const char *filename) const;
+	bool writePFM(const char *filename) const;
+	bool writePPM(const char *filename) const;
+};
+
+// Renders an image tile by tile on a pool of worker threads. Tiles are dealt
+// round-robin to a queue per thread and idle threads steal tiles from the
+// others, so regions with dense geometry do not leave the other cores idle.
+// The workers are started once and wait between images, so the many small
+// images of progressive rendering do not start threads each time.
+class Tile_Renderer
+{
+public:
+	// returns the color of pixel (x, y)
+	typedef std::function<Vector3(int x, int y)> Shader;
+	// called after each tile, from the thread which rendered it
+	typedef std::function<void(int tiles_done, int tiles_total)> Progress;
+
+	// num_threads = 0 starts one thread per hardware thread
+	Tile_Renderer(int num_threads = 0);
+	~Tile_Renderer();
+	Tile_Renderer(const Tile_Renderer &) = delete;
+	Tile_Renderer &operator=(const Tile_Renderer &) = delete;
+	int size() { return num_threads; }
+	// the calling thread renders as well, returns once the image is done
+	void render(Framebuffer &frame, const Shader &shade, const Progress &progress = Progress());
+
+private:
+	struct Tile_Queue
+	{
+		std::mutex lock;
+		std::deque<int> tiles;
+	};
+
+	int num_threads;
+	std::vector<Tile_Queue> queues; // one per thread, the caller's first
+	std::vector<std::thread> workers;
+
+	// wakes the workers for each image and waits for them
+	std::mutex lock;
+	std::condition_variable start_cv;
+	std::condition_variable done_cv;
+	unsigned image;  // counts the images rendered
+	int working;     // workers still on the current image
+	bool stopping;
+
+	// the current image, set by render() while the workers wait
+	Framebuffer *frame;
+	const Shader *shade;
+	const Progress *progress;
+	int tiles_x;
+	int tiles_total;
+	std::atomic<int> tiles_done;
+	std::mutex progress_lock;
+
+	void workerLoop(int id);
+	void work(int id);
+	bool popTile(int id, int &tile);
+};
+#endif